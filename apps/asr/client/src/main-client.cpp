@@ -20,13 +20,18 @@
 
 #include "ASREngine/wav-reader/wav-reader.h"
 #include "Network/client/client.h"
+#include "Network/common/sample-codec.h"
+#include "Network/shm/shm-channel.h"
 #include "Utils/logger/logger.h"
 #include "Utils/logger/worker/consolesink.h"
 #include "Utils/logger/worker/filesink.h"
 
 #include <chrono>
+#include <condition_variable>
 #include <csignal>  // For signal handling
+#include <deque>
 #include <iostream>
+#include <mutex>
 #include <sstream>  // For std::ostringstream
 #include <string>
 #include <thread>
@@ -39,6 +44,10 @@ const std::string_view kcurrent_app_name = "test-client";
 const std::string ksocket_path = "/tmp/soCket.paTh";
 const int ksample_rate = 16000;
 const int CHUNK_DURATION_MS = 800;  // milliseconds
+// with results pushed by the server a chunk costs no round trip, so it can be short
+const int PUSH_CHUNK_DURATION_MS = 100;  // milliseconds
+// a server at capacity answers busy with a retry hint, give up after this many tries
+const int BUSY_RETRY_ATTEMPTS = 5;
 
 // --- kill signal capture ---
 // static bool g_stop_signal_received = false;
@@ -87,7 +96,19 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[]) {
 
 	if (argc < 2) {
 		std::ostringstream oss;
-		oss << "Usage: " << argv[0] << " <path_to_input_wav_file>"
+		oss << "Usage: " << argv[0]
+		    << " <path_to_input_wav_file> [--shm] [--pcm16|--mulaw] [--streams N]"
+		    << " [--tcp host:port]"
+		    << "\n"
+		    << "  --shm: stream audio through a shared-memory ring instead of the socket"
+		    << "\n"
+		    << "  --pcm16: send 16-bit PCM over the socket (half the bytes of float32)"
+		    << "\n"
+		    << "  --mulaw: send G.711 mu-law over the socket (a quarter of the bytes, lossy)"
+		    << "\n"
+		    << "  --streams N: run N sessions of the same audio over one connection"
+		    << "\n"
+		    << "  --tcp host:port: reach a remote server over TCP instead of the local socket"
 		    << "\n"
 		    << "  Example: " << argv[0] << " full_audio_stream.wav";
 		arcforge::embedded::utils::Logger::GetInstance().Error(oss.str(), kcurrent_app_name);
@@ -95,6 +116,35 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[]) {
 	}
 
 	std::string wav_filepath = argv[1];
+	bool use_shm = false;
+	uint32_t stream_count = 1;
+	std::string tcp_endpoint;
+	network_socket::SampleEncoding wire_encoding = network_socket::SampleEncoding::kfloat32;
+	for (int i = 2; i < argc; ++i) {
+		const std::string option = argv[i];
+		if (option == "--shm") {
+			use_shm = true;
+		} else if (option == "--pcm16") {
+			wire_encoding = network_socket::SampleEncoding::kpcm16;
+		} else if (option == "--mulaw") {
+			wire_encoding = network_socket::SampleEncoding::kmulaw;
+		} else if (option == "--streams" && i + 1 < argc) {
+			stream_count = static_cast<uint32_t>(std::max(1, std::atoi(argv[++i])));
+		} else if (option == "--tcp" && i + 1 < argc) {
+			tcp_endpoint = argv[++i];
+		}
+	}
+	if (tcp_endpoint.empty() == false) {
+		// the ring is handed over as an fd, which only a Unix-domain socket can carry
+		use_shm = false;
+	}
+	if (stream_count > 1) {
+		// multiplexed sessions use the socket only, in float or pcm16
+		use_shm = false;
+		if (wire_encoding == network_socket::SampleEncoding::kmulaw) {
+			wire_encoding = network_socket::SampleEncoding::kpcm16;
+		}
+	}
 
 	// setup signal handler
 	signal(SIGINT, SignalHandler);
@@ -103,15 +153,88 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[]) {
 	// init client object
 	network_socket::ClientBase client;
 	client.setSocketPath(ksocket_path);
+	if (tcp_endpoint.empty() == false) {
+		// host:port, the host may be a bracketed IPv6 literal such as [::1]:9000
+		const size_t colon = tcp_endpoint.rfind(':');
+		std::string host = tcp_endpoint.substr(0, colon == std::string::npos ? 0 : colon);
+		if (host.size() >= 2 && host.front() == '[' && host.back() == ']') {
+			host = host.substr(1, host.size() - 2);
+		}
+		const size_t port_at = (colon == std::string::npos) ? 0 : colon + 1;
+		const int port = std::atoi(tcp_endpoint.c_str() + port_at);
+		client.setTcpEndpoint(host, static_cast<uint16_t>(port));
+	}
 
-	// connect to server
-	network_socket::SocketReturnValue retval_flag = client.connectToServer();
-	if (retval_flag > network_socket::SocketReturnValue::ksuccess) {
+	// session handshake: declare the stream once, the server answers with what it accepts.
+	// A compact sample format only applies to the socket path, the ring always carries float.
+	network_socket::StreamParams requested;
+	requested.sample_rate = static_cast<uint32_t>(ksample_rate);
+	requested.encoding = use_shm ? network_socket::SampleEncoding::kfloat32 : wire_encoding;
+	requested.max_streams = stream_count;
+	// keep several chunks in flight if the server grants a credit window
+	requested.pipelined_results = true;
+	// a single session lets the server push results on its own schedule
+	requested.push_results = (stream_count == 1);
+	requested.chunk_duration_ms = static_cast<uint32_t>(
+	    requested.push_results ? PUSH_CHUNK_DURATION_MS : CHUNK_DURATION_MS);
+	// numbered, timestamped chunks let the server split its per-chunk latency
+	requested.frame_metadata = true;
+	network_socket::SessionGrant granted;
+	network_socket::SocketReturnValue retval_flag = network_socket::SocketReturnValue::kinit_state;
+	for (int attempt = 1; attempt <= BUSY_RETRY_ATTEMPTS; ++attempt) {
+		// connect to server
+		retval_flag = client.connectToServer();
+		if (retval_flag > network_socket::SocketReturnValue::ksuccess) {
+			arcforge::embedded::utils::Logger::GetInstance().Error(
+			    "Client failed to connect to server.", kcurrent_app_name);
+			exit(1);
+		}
+		retval_flag = client.handshake(requested, granted);
+		if (retval_flag != network_socket::SocketReturnValue::kserver_busy ||
+		    attempt == BUSY_RETRY_ATTEMPTS || g_stop_signal_received == true) {
+			break;
+		}
+		// turned away at capacity: the server says when a slot is likely to be free
+		const std::chrono::milliseconds retry_after = client.getRetryAfter();
+		arcforge::embedded::utils::Logger::GetInstance().Warning(
+		    "Server busy, retrying in " + std::to_string(retry_after.count()) + " ms.",
+		    kcurrent_app_name);
+		client.closeSocket();
+		std::this_thread::sleep_for(retry_after);
+	}
+	if (retval_flag != network_socket::SocketReturnValue::ksuccess) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "Session handshake failed: " + network_socket::SocketReturnValueToString(retval_flag),
+		    kcurrent_app_name);
+		exit(1);
+	}
+	if (granted.params.sample_rate != requested.sample_rate) {
+		// the wav file is not resampled on this side
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "Server refused the sample rate of the input.", kcurrent_app_name);
+		exit(1);
+	}
+	wire_encoding = granted.params.encoding;
+	if (granted.params.max_streams < stream_count) {
 		arcforge::embedded::utils::Logger::GetInstance().Error(
-		    "Client failed to connect to server.", kcurrent_app_name);
+		    "Server grants only " + std::to_string(granted.params.max_streams) + " streams.",
+		    kcurrent_app_name);
 		exit(1);
 	}
 
+	// optional: move the audio path onto a shared-memory ring, results still use the socket
+	std::unique_ptr<network_socket::ShmChannel> shm_channel;
+	if (use_shm == true) {
+		retval_flag = network_socket::ShmChannel::offer(client, shm_channel);
+		if (retval_flag != network_socket::SocketReturnValue::ksuccess) {
+			arcforge::embedded::utils::Logger::GetInstance().Error(
+			    "Server did not accept the shared-memory ring: " +
+			        network_socket::SocketReturnValueToString(retval_flag),
+			    kcurrent_app_name);
+			exit(1);
+		}
+	}
+
 	// --- 2. Open wav file ---
 	ai_asr::WavReader reader;
 	if (!reader.Open(wav_filepath, ksample_rate, 1 /*expected channels*/)) {
@@ -125,14 +248,114 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[]) {
 		std::ostringstream oss;
 		oss << "\nStarting client wav reading for '" << wav_filepath << "'..."
 		    << "\n"
-		    << "Processing audio in " << CHUNK_DURATION_MS << "ms chunks."
+		    << "Processing audio in " << granted.params.chunk_duration_ms << "ms chunks."
 		    << "\n"
 		    << "Press Ctrl+C to stop.\n";
 		arcforge::embedded::utils::Logger::GetInstance().Info(oss.str(), kcurrent_app_name);
 	}
 
-	const size_t samples_per_chunk = static_cast<size_t>((ksample_rate * CHUNK_DURATION_MS) / 1000);
+	const size_t samples_per_chunk =
+	    static_cast<size_t>((ksample_rate * granted.params.chunk_duration_ms) / 1000);
 	std::vector<float> audio_chunk;
+	std::vector<int16_t> pcm16_chunk;
+	std::vector<uint8_t> mulaw_chunk;
+	network_socket::StreamFrame result_frame;
+
+	// one result per chunk (per stream when multiplexed), each one returns a send credit
+	auto receive_results = [&]() {
+		if (stream_count > 1) {
+			for (uint32_t received = 0; received < stream_count; ++received) {
+				if (client.receiveStreamFrame(result_frame) !=
+				    network_socket::SocketReturnValue::ksuccess) {
+					break;
+				}
+				std::ostringstream oss;
+				oss << "receive:" << std::string(result_frame.payload.data(), result_frame.count)
+				    << " (stream " << result_frame.stream << ")";
+				arcforge::embedded::utils::Logger::GetInstance().Info(oss.str(),
+				                                                      kcurrent_app_name);
+			}
+			return;
+		}
+
+		//receive string from server
+		std::string result;
+		client.receiveString(result);
+		std::ostringstream oss;
+		oss << "receive:" << result;
+		arcforge::embedded::utils::Logger::GetInstance().Info(oss.str(), kcurrent_app_name);
+	};
+	// chunks sent whose results are still on their way
+	const uint32_t window = std::max<uint32_t>(granted.max_inflight_chunks, 1);
+	uint32_t in_flight = 0;
+
+	// pushed results: a thread of its own reads partials and finals as the server sends them,
+	// the sender only waits when the credit window is used up. The final that acknowledges
+	// the last chunk after the EOF marker ends the session.
+	const bool pushed = granted.params.push_results;
+	std::mutex result_mutex;
+	std::condition_variable result_cv;
+	uint32_t chunks_sent = 0;
+	uint32_t chunks_acknowledged = 0;
+	// send time of every chunk not acknowledged yet: a result is as late as the newest chunk
+	// it covers, which gives the audio-to-text latency
+	std::deque<std::chrono::steady_clock::time_point> unacknowledged_sends;
+	bool eof_sent = false;
+	bool results_done = false;
+	std::thread result_thread;
+	if (pushed == true) {
+		result_thread = std::thread([&]() {
+			network_socket::ResultMessage result;
+			while (true) {
+				const network_socket::SocketReturnValue retval = client.receiveResult(result);
+				bool last = (retval != network_socket::SocketReturnValue::ksuccess);
+				if (last == false) {
+					std::ostringstream oss;
+					oss << "receive:"
+					    << (result.kind == network_socket::ResultKind::kpartial ? "[partial] "
+					                                                            : "[final] ")
+					    << result.text;
+					arcforge::embedded::utils::Logger::GetInstance().Info(oss.str(),
+					                                                      kcurrent_app_name);
+				}
+				std::chrono::steady_clock::time_point newest_send;
+				{
+					std::lock_guard<std::mutex> lock(result_mutex);
+					chunks_acknowledged += result.acknowledged_chunks;
+					// an endpoint final may close the last chunk before the server has seen the
+					// EOF marker, only the end-of-utterance final ends the stream
+					last = last || (eof_sent == true &&
+					                result.kind == network_socket::ResultKind::kend_of_utterance);
+					results_done = last;
+					for (uint32_t i = 0;
+					     i < result.acknowledged_chunks && unacknowledged_sends.empty() == false;
+					     ++i) {
+						newest_send = unacknowledged_sends.front();
+						unacknowledged_sends.pop_front();
+					}
+				}
+				result_cv.notify_all();
+				if (newest_send != std::chrono::steady_clock::time_point()) {
+					const std::chrono::duration<double, std::milli> latency =
+					    std::chrono::steady_clock::now() - newest_send;
+					std::ostringstream oss;
+					oss << "audio-to-text latency: " << latency.count() << " ms";
+					arcforge::embedded::utils::Logger::GetInstance().Info(oss.str(),
+					                                                      kcurrent_app_name);
+				}
+				if (last == true) {
+					break;
+				}
+			}
+		});
+	}
+	auto wait_for_credit = [&]() {
+		std::unique_lock<std::mutex> lock(result_mutex);
+		while (g_stop_signal_received == false && results_done == false &&
+		       client.getSendCredits() == 0) {
+			result_cv.wait_for(lock, std::chrono::milliseconds(100));
+		}
+	};
 
 	// --- 3. Processing with conditional loop ---
 	while ((g_stop_signal_received == false) && (reader.Eof() == false)) {
@@ -140,7 +363,14 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[]) {
 		//    This ensures that regardless of how ReadSamples is implemented, the buffer we provide is always safe.
 		audio_chunk.resize(samples_per_chunk);
 
-		size_t samples_read = reader.ReadSamples(audio_chunk, samples_per_chunk);
+		size_t samples_read = 0;
+		if (wire_encoding == network_socket::SampleEncoding::kfloat32) {
+			samples_read = reader.ReadSamples(audio_chunk, samples_per_chunk);
+		} else {
+			// the wav data is int16 already, don't widen it to float only to narrow it again
+			samples_read = reader.ReadSamples(pcm16_chunk, samples_per_chunk);
+			audio_chunk.resize(samples_read);
+		}
 
 		if (samples_read > 0) {
 			{
@@ -159,24 +389,58 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[]) {
 				audio_chunk.resize(samples_read);
 			}
 
-			//send float to server
-			network_socket::SocketReturnValue retval = client.sendFloat(audio_chunk);
+			//send samples to server in the agreed encoding
+			network_socket::SocketReturnValue retval =
+			    network_socket::SocketReturnValue::kinit_state;
+			if (pushed == true && !shm_channel) {
+				wait_for_credit();
+			}
+			const auto send_time = std::chrono::steady_clock::now();
+			if (stream_count > 1) {
+				// the same chunk for every session, one result per session comes back
+				for (uint32_t stream = 0; stream < stream_count; ++stream) {
+					const auto id = static_cast<network_socket::StreamId>(stream);
+					retval = (wire_encoding == network_socket::SampleEncoding::kpcm16)
+					             ? client.sendStreamPcm16(id, pcm16_chunk)
+					             : client.sendStreamFloat(id, audio_chunk);
+					if (retval != network_socket::SocketReturnValue::ksuccess) {
+						break;
+					}
+				}
+			} else if (shm_channel) {
+				retval = shm_channel->sendFloat(audio_chunk);
+			} else if (wire_encoding == network_socket::SampleEncoding::kpcm16) {
+				retval = client.sendPcm16(pcm16_chunk);
+			} else if (wire_encoding == network_socket::SampleEncoding::kmulaw) {
+				audio_chunk.resize(pcm16_chunk.size());
+				network_socket::ConvertPcm16ToFloat(pcm16_chunk.data(), audio_chunk.data(),
+				                                    pcm16_chunk.size());
+				mulaw_chunk.resize(audio_chunk.size());
+				network_socket::ConvertFloatToMulaw(audio_chunk.data(), mulaw_chunk.data(),
+				                                    audio_chunk.size());
+				retval = client.sendMulaw(mulaw_chunk);
+			} else {
+				retval = client.sendFloat(audio_chunk);
+			}
 			if (retval > network_socket::SocketReturnValue::ksuccess) {
 				arcforge::embedded::utils::Logger::GetInstance().Error(
 				    "Client failed to send float data.", kcurrent_app_name);
 				continue;
 			}
 
-			//receive string from server
-			std::string result;
-			retval = client.receiveString(result);
-			// if (result.empty() == false) {
-			{
-				std::ostringstream oss;
-				oss << "receive:" << result;
-				arcforge::embedded::utils::Logger::GetInstance().Info(oss.str(), kcurrent_app_name);
+			if (pushed == true) {
+				std::lock_guard<std::mutex> lock(result_mutex);
+				++chunks_sent;
+				unacknowledged_sends.push_back(send_time);
+				continue;
+			}
+
+			// pipelined: wait for a result only once the credit window is full
+			++in_flight;
+			if (in_flight >= window) {
+				receive_results();
+				--in_flight;
 			}
-			// }
 		}
 	}  // end of while()
 
@@ -186,13 +450,36 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[]) {
 	} else {
 		arcforge::embedded::utils::Logger::GetInstance().Info(
 		    "\nEnd of WAV file reached in main loop.", kcurrent_app_name);
+		for (; in_flight > 0; --in_flight) {
+			receive_results();
+		}
 		//-----------------------------------------------------
 		// send EOF marker (an empty chunk)
+		if (pushed == true) {
+			std::lock_guard<std::mutex> lock(result_mutex);
+			eof_sent = true;
+		}
 		std::vector<float> empty_chunk;
-		client.sendFloat(empty_chunk);
+		if (stream_count > 1) {
+			for (uint32_t stream = 0; stream < stream_count; ++stream) {
+				client.sendStreamFloat(static_cast<network_socket::StreamId>(stream), empty_chunk);
+			}
+		} else if (shm_channel) {
+			shm_channel->sendFloat(empty_chunk);
+		} else {
+			client.sendFloat(empty_chunk);
+		}
 		arcforge::embedded::utils::Logger::GetInstance().Info(
 		    "!!!!!!!!!!!!!!!!!!!!!Sent EOF marker (empty chunk)", kcurrent_app_name);
 	}
 
+	if (result_thread.joinable()) {
+		if (g_stop_signal_received == true) {
+			// don't wait for results nobody will read
+			client.cancel();
+		}
+		result_thread.join();
+	}
+
 	return 0;
 }
\ No newline at end of file
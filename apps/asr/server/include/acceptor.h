@@ -29,6 +29,8 @@
 #include "Network/server/server.h"
 #include "Utils/logger/logger.h"
 #include "asr-task-sherpa.h"
+#include "decode-scheduler.h"
+#include "worker-pool.h"
 
 class Acceptor {
    public:
@@ -41,6 +43,24 @@ class Acceptor {
 
 	void init();
 	void setSocketPath(const std::string&);
+	// serve remote clients over TCP instead of the socket path, see Base::setTcpEndpoint()
+	void setTcpEndpoint(const std::string& host, uint16_t port);
+	// session steps run on a fixed pool of this many workers, by default one per core; set
+	// before init()
+	void setWorkerCount(size_t workers);
+	// sessions open at once, independent of the worker count since a session only holds a
+	// worker while it has input to handle
+	void setMaxSessions(size_t sessions);
+	// pins the workers round-robin to these cpus, set before init()
+	void setWorkerCpus(const std::vector<int>& cpus);
+	// connections the kernel completes ahead of accept(), set before init()
+	void setListenBacklog(int backlog);
+	// sessions one client process may run at once, further ones wait in the queue
+	void setSessionsPerClient(size_t sessions);
+	// rounds of synthetic audio init() decodes before serving, 0 skips the warm-up
+	void setWarmupPasses(int passes);
+	// decoder streams kept ready for new sessions, set before init()
+	void setStreamPoolSize(size_t streams);
 	void process();
 	~Acceptor();
 	void stop_me();
@@ -56,14 +76,78 @@ class Acceptor {
    private:
 	explicit Acceptor(std::unique_ptr<arcforge::embedded::network_socket::ServerBase>);
 	// ASRTaskStatus TaskChecker();
+	void onClientAccepted(std::unique_ptr<arcforge::embedded::network_socket::Base> client);
+	ClientKey identifyClient(const arcforge::embedded::network_socket::Base& client);
+	void startTask(ClientKey owner,
+	               std::unique_ptr<arcforge::embedded::network_socket::Base> client);
+	void watchTask(TaskHandle& handle);
+	void unwatchTask(TaskHandle& handle);
+	void stepTask(ASRTaskSherpa* task);
+	void startPendingClients();
+	bool hasCapacity();
+	void expirePendingClients(std::chrono::steady_clock::time_point now);
+	void refuseClient(arcforge::embedded::network_socket::Base& client, const std::string& why);
 
    private:
 	std::string ksocket_path_;
+	bool use_tcp_ = false;
+	std::string tcp_host_;
+	uint16_t tcp_port_ = 0;
 	std::unique_ptr<arcforge::embedded::network_socket::ServerBase> server_ = nullptr;
+	// weights loaded once in init(), each session only creates its own decoder stream on them
+	std::shared_ptr<const arcforge::embedded::ai_asr::RecognizerModel> model_;
+	// first-inference setup of the provider is meant to be paid by the warm-up, creating a
+	// stream by the pool, rather than by a session's first chunk
+	static constexpr int kWARMUP_PASSES_ = 2;
+	static constexpr int kWARMUP_AUDIO_MS_ = 1000;
+	static constexpr size_t kSTREAM_POOL_SIZE_ = ASRTaskSherpa::kDECODE_BATCH_SIZE_;
+	int warmup_passes_ = kWARMUP_PASSES_;
+	size_t stream_pool_size_ = kSTREAM_POOL_SIZE_;
+	std::shared_ptr<StreamPool> stream_pool_;
 	// std::unique_ptr<arcforge::embedded::network_socket::Base> client_connection_ = nullptr;
 	// std::unique_ptr<ASRTaskSherpa> asr_task_sherpa_ = nullptr;
 	// std::thread worker_thread_;
-	size_t timeout_value_{2000};
+	// upper bound (ms) of one event-loop wait, so process() returns to re-check the stop signal
+	int timeout_value_{2000};
 	std::vector<TaskHandle> active_task_handlers_;
-	static constexpr size_t kMAX_CONCURRENT_TASKS_ = 2;
+	// sessions share one model, so the cap is set by per-stream state rather than by model
+	// copies in memory
+	static constexpr size_t kMAX_CONCURRENT_TASKS_ = 40;
+	size_t max_sessions_ = kMAX_CONCURRENT_TASKS_;
+	// steps are compute (decode) plus short non-blocking I/O, more workers than cores only
+	// adds context switches
+	size_t worker_count_ = std::max(1u, std::thread::hardware_concurrency());
+	std::vector<int> worker_cpus_;
+	std::unique_ptr<WorkerPool> workers_;
+	// accepted connections wait in pending_clients_, unread, until there is capacity for them
+	// and their client (process) is below its session quota. Whoever waits past the deadline or
+	// finds the queue full is answered busy with a retry hint rather than left hanging.
+	static constexpr int kLISTEN_BACKLOG_ = 64;
+	int listen_backlog_ = kLISTEN_BACKLOG_;
+	static constexpr size_t kMAX_SESSIONS_PER_CLIENT_ = 2;
+	size_t sessions_per_client_limit_ = kMAX_SESSIONS_PER_CLIENT_;
+	static constexpr size_t kMAX_PENDING_CLIENTS_ = 32;
+	static constexpr std::chrono::milliseconds kPENDING_DEADLINE_{5000};
+	static constexpr std::chrono::milliseconds kBUSY_RETRY_AFTER_{1000};
+	struct PendingClient {
+		ClientKey owner;
+		std::unique_ptr<arcforge::embedded::network_socket::Base> client;
+		std::chrono::steady_clock::time_point deadline;
+	};
+	std::vector<PendingClient> pending_clients_;
+	std::map<ClientKey, size_t> sessions_per_client_;
+	// TCP clients have no pid or uid, each connection is a client of its own
+	uint32_t next_remote_client_ = 0;
+	// chunks decoding at once across all sessions, enough to fill one decode batch, and the
+	// audio seconds per second each client may have decoded, with its burst
+	static constexpr size_t kDECODE_SLOTS_ = ASRTaskSherpa::kDECODE_BATCH_SIZE_;
+	static constexpr double kCLIENT_AUDIO_SECONDS_PER_SECOND_ = 4.0;
+	static constexpr double kCLIENT_AUDIO_BURST_SECONDS_ = 8.0;
+	std::shared_ptr<DecodeScheduler> scheduler_ = std::make_shared<DecodeScheduler>(
+	    kDECODE_SLOTS_, kCLIENT_AUDIO_SECONDS_PER_SECOND_, kCLIENT_AUDIO_BURST_SECONDS_);
+	// a new session is admitted while the sessions, each streaming in real time, keep the
+	// decode slots at most this busy at the measured real-time factor
+	static constexpr double kDECODE_HEADROOM_ = 0.8;
+	// stop_me() waits this long for the cancelled sessions to finish
+	static constexpr std::chrono::milliseconds kSHUTDOWN_GRACE_{2000};
 };
\ No newline at end of file
@@ -24,11 +24,17 @@
 
 #include "pch.h"
 
-#include "ASREngine/recognizer/recognizer.h"
+#include "ASREngine/recognizer/recognizer-model.h"
+#include "ASREngine/recognizer/recognizer-stream.h"
 #include "ASREngine/wav-reader/wav-reader.h"
+#include "Network/common/audio-buffer.h"
 #include "Network/common/common-types.h"
+#include "Network/common/sample-codec.h"
 #include "Network/server/server.h"
+#include "Network/shm/shm-channel.h"
 #include "Utils/logger/logger.h"
+#include "decode-scheduler.h"
+#include "stream-pool.h"
 
 enum class ASRTaskStatus {
 	kIdle = 0x01,       // idle: task is created but not yet started
@@ -41,12 +47,39 @@ enum class ASRTaskStatus {
 
 class ASRTaskSherpa {
    public:
+	// the session's decoder streams come from streams when given, else are created here
 	static std::unique_ptr<ASRTaskSherpa> Create(
-	    std::unique_ptr<arcforge::embedded::network_socket::Base>);
-	void run();
+	    std::unique_ptr<arcforge::embedded::network_socket::Base>,
+	    std::shared_ptr<const arcforge::embedded::ai_asr::RecognizerModel> model,
+	    std::shared_ptr<StreamPool> streams = nullptr);
+	// loaded once per server, every session decodes its own stream on it; nullptr on failure
+	static std::shared_ptr<arcforge::embedded::ai_asr::RecognizerModel> LoadModel();
+	// sessions whose chunks are ready within kDECODE_BATCH_WAIT_MS_ of each other share one
+	// encoder run, up to kDECODE_BATCH_SIZE_ streams
+	static constexpr int kDECODE_BATCH_SIZE_ = 8;
+	static constexpr int kDECODE_BATCH_WAIT_MS_ = 5;
+	// a session is a state machine driven by the readiness of its input: step() handles
+	// whatever has arrived (hello, chunks, EOF) and returns as soon as it would have to wait
+	// for more, false once the session is over. The caller runs one step at a time, on any
+	// thread, and waits for inputFD() to turn readable, hangupFD() (-1 if none) to hang up or
+	// hasBufferedInput() before the next.
+	bool step();
+	// set when a step stopped because its client is over the decode rate quota: the next
+	// step is due then, whether or not more input arrives; a default time_point otherwise
+	std::chrono::steady_clock::time_point resumeAt() const;
+	int inputFD() const;
+	int hangupFD() const;
+	// input already read off the fd, see EventLoop::PendingCheck; only between steps
+	bool hasBufferedInput();
+	// ends the session once its client has been silent for kCLIENT_IDLE_TIMEOUT_; only
+	// between steps
+	bool expireIdle(std::chrono::steady_clock::time_point now);
 	bool init();
 	void stop_me();
 	bool isCompleted() const;
+	// decodes of this session queue for the shared decoder on behalf of owner; without a
+	// scheduler every chunk decodes right away
+	void setScheduler(std::shared_ptr<DecodeScheduler> scheduler, ClientKey owner);
 
 	// duplicate constructor must be deleted
 	ASRTaskSherpa(const ASRTaskSherpa&) = delete;
@@ -60,21 +93,127 @@ class ASRTaskSherpa {
 	~ASRTaskSherpa();
 
    private:
-	explicit ASRTaskSherpa();
+	ASRTaskSherpa(std::shared_ptr<const arcforge::embedded::ai_asr::RecognizerModel> model,
+	              std::shared_ptr<StreamPool> streams);
+	arcforge::embedded::ai_asr::RecognizerStream takeStream();
 	void setClient(std::unique_ptr<arcforge::embedded::network_socket::Base> client);
+	arcforge::embedded::network_socket::SessionGrant grantSession(
+	    const arcforge::embedded::network_socket::StreamParams& requested) const;
+	enum class SessionMode { klockstep, kmultiplexed, kpushed };
+	// something to read right now, without blocking
+	bool inputReady();
+	// the client has to wait for its rate quota before the next chunk, see resumeAt()
+	bool throttled();
+	// one frame each; false once the session is over
+	bool stepLockstep();
+	bool stepMultiplexed();
+	// takes every frame that has arrived, then decodes them in one go
+	bool stepPushed();
+	bool receivePushed();
+	bool decodePushed();
+	void finish(const std::string& reason);
+	static arcforge::embedded::ai_asr::SherpaConfig makeSherpaConfig();
+	// ProcessAudioChunk() within the decode scheduler, stamping slot_granted_; false when
+	// stopped while waiting
+	bool decode(arcforge::embedded::ai_asr::RecognizerStream& recognizer, const float* samples,
+	            size_t count);
+	// Debug line splitting a stamped chunk's latency into transport, socket queue, server
+	// queue and decode (see StreamParams::frame_metadata)
+	void logChunkLatency(const arcforge::embedded::network_socket::FrameInfo& frame,
+	                     std::chrono::steady_clock::time_point dequeued,
+	                     std::chrono::steady_clock::time_point decode_begin,
+	                     std::chrono::steady_clock::time_point decode_end) const;
 
    private:
-	arcforge::embedded::ai_asr::Recognizer asr_engine_;
+	// a step only starts to receive once input is ready, this bounds the wait for the rest of
+	// a frame that has begun to arrive; stop_me() does not wait for it, it cancels the
+	// connection
+	static constexpr std::chrono::milliseconds kFRAME_DEADLINE_{1000};
+	// a client that sends nothing for this long gives its slot back
+	static constexpr std::chrono::milliseconds kCLIENT_IDLE_TIMEOUT_{10000};
+	// what a session hello may ask for
+	static constexpr uint32_t kMIN_SAMPLE_RATE_ = 8000;
+	static constexpr uint32_t kMAX_SAMPLE_RATE_ = 48000;
+	static constexpr uint32_t kMIN_CHUNK_DURATION_MS_ = 10;
+	static constexpr uint32_t kMAX_CHUNK_DURATION_MS_ = 1000;
+	// float chunks on the socket are decoded in slices this long while the rest arrives
+	static constexpr uint32_t kDECODE_SLICE_MS_ = 10;
+	// logical sessions one multiplexed connection may open (e.g. an 8-mic array gateway)
+	static constexpr uint32_t kMAX_MUX_STREAMS_ = 8;
+	// credit window of a pipelined session: as many chunks as fit this much buffered audio,
+	// capped so one fast producer cannot run far ahead of its results
+	static constexpr uint32_t kSESSION_BUFFER_BYTES_ = 256 * 1024;
+	static constexpr uint32_t kMAX_INFLIGHT_CHUNKS_ = 8;
+
+	std::shared_ptr<const arcforge::embedded::ai_asr::RecognizerModel> model_;
+	std::shared_ptr<StreamPool> stream_pool_;
+	arcforge::embedded::ai_asr::RecognizerStream asr_engine_;
 	// bool stop_flag_ = false;
 	std::atomic<bool> stop_flag_ = false;
 	// std::mutex mutex_;
-	std::mutex client_mutex_;
+	// only used by the step running now, stop_me() merely cancels it
 	std::unique_ptr<arcforge::embedded::network_socket::Base> client_ = nullptr;
+	SessionMode mode_ = SessionMode::klockstep;
+	bool handshaken_ = false;
+	std::chrono::steady_clock::time_point last_input_time_ = std::chrono::steady_clock::now();
+	// float chunks are decoded slice by slice while the rest of the frame is still arriving;
+	// a frame over the granted size is drained without being decoded. The handler is built
+	// once, the state it keeps lives here.
+	arcforge::embedded::network_socket::SampleSliceHandler decode_slice_;
+	bool frame_refused_ = false;
+	bool decode_stopped_ = false;
+	// when the first slice of the frame arrived and when it got its decode slot
+	std::chrono::steady_clock::time_point first_slice_time_;
+	std::chrono::steady_clock::time_point first_slot_time_;
+	arcforge::embedded::network_socket::AudioBuffer audio_chunk_;
+	// agreed with the client per connection; compact chunks land here before being widened
+	arcforge::embedded::network_socket::SampleEncoding sample_encoding_ =
+	    arcforge::embedded::network_socket::SampleEncoding::kfloat32;
+	std::vector<int16_t> pcm16_chunk_;
+	std::vector<uint8_t> mulaw_chunk_;
+	// settled by the session hello; legacy clients keep the defaults (no frame limit)
+	arcforge::embedded::network_socket::SessionGrant session_;
+	// multiplexed connections only: the frame being processed and one decoder stream per stream
+	arcforge::embedded::network_socket::StreamFrame stream_frame_;
+	std::map<arcforge::embedded::network_socket::StreamId,
+	         std::unique_ptr<arcforge::embedded::ai_asr::RecognizerStream>>
+	    mux_sessions_;
+	// pushed-results sessions only: receivePushed() queues the chunks that have arrived and
+	// decodePushed() decodes them in one go; spare sample vectors are handed back so the
+	// steady state does not allocate. An empty chunk ends the utterance.
+	struct PushedChunk {
+		std::vector<float> samples;
+		bool end_of_utterance = false;
+		arcforge::embedded::network_socket::FrameInfo frame;
+		std::chrono::steady_clock::time_point dequeued;
+	};
+	std::queue<PushedChunk> pushed_chunks_;
+	std::vector<std::vector<float>> pushed_spare_;
+	// chunks decoded since the last result, acknowledged by the next one
+	uint32_t pushed_consumed_ = 0;
+	// audio arrived since the last end-of-utterance marker
+	bool utterance_open_ = false;
+	bool pushed_receive_done_ = false;
+	std::string pushed_receive_reason_;
+	// set once by a step, closed by stop_me() to wake a blocked reader
+	std::mutex shm_mutex_;
+	std::unique_ptr<arcforge::embedded::network_socket::ShmChannel> shm_channel_;
 	std::atomic<bool> finished_flag_{false};
+	std::shared_ptr<DecodeScheduler> scheduler_;
+	ClientKey owner_ = 0;
+	// when the last decode() got its slot: what precedes it is server queue, not decode
+	std::chrono::steady_clock::time_point slot_granted_;
+	std::chrono::steady_clock::time_point resume_at_;
 	// arcforge::embedded::ai_asr::SherpaConfig sherpa_config_;
 };
 
 struct TaskHandle {
 	std::unique_ptr<ASRTaskSherpa> task;
-	std::thread worker;
+	// the step running on a pool worker, not valid while the session waits for input
+	std::future<void> step;
+	// whose session quota the task counts against
+	ClientKey owner = 0;
+	// what the session is registered on in the event loop while it waits, -1 when not
+	int watched_input_fd = -1;
+	int watched_hangup_fd = -1;
 };
\ No newline at end of file
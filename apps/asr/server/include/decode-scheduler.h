@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2025 PotterWhite
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include "pch.h"
+
+// whom a session is accounted to: the process of a local client, pid in the high and uid in
+// the low 32 bits (SO_PEERCRED; on the target boards every local client runs as the same
+// uid), or a per-connection id with kREMOTE_CLIENT_KEY_BIT set for TCP clients, which carry
+// no identity
+using ClientKey = uint64_t;
+inline constexpr ClientKey kREMOTE_CLIENT_KEY_BIT = 1ull << 63;
+
+/*
+ * @brief Shares the decoder fairly between clients instead of between sessions.
+ *        At most decode_slots chunks decode at once. A waiting chunk goes to the client that
+ *        has been served the fewest audio seconds so far, so a batch client with many
+ *        sessions cannot starve an interactive one. Each client also has a token bucket of
+ *        audio seconds per second. acquire() never waits for the bucket, it only runs it into
+ *        debt: a session asks quotaDelay() before it takes on a chunk and, once its client has
+ *        used its burst, comes back after the refill instead of holding a worker meanwhile.
+ */
+class DecodeScheduler {
+   public:
+	DecodeScheduler(size_t decode_slots, double audio_seconds_per_second, double burst_seconds);
+
+	// blocks until a slot is free and it is client's turn, then holds the slot until
+	// release(). Returns false without a slot once stop is set; interrupt() wakes the wait.
+	bool acquire(ClientKey client, double audio_seconds, const std::atomic<bool>& stop);
+	// how long client has to hold off before it takes on a chunk of audio_seconds, zero
+	// while its rate quota allows it; never blocks
+	std::chrono::steady_clock::duration quotaDelay(ClientKey client, double audio_seconds);
+	// hands the slot back, with how long the chunk took to decode for the real-time factor
+	void release(ClientKey client, double audio_seconds,
+	             std::chrono::steady_clock::duration decode_time);
+	void interrupt();
+	// forgets a client whose last session has ended; one with a chunk still waiting or
+	// decoding is kept
+	void removeClient(ClientKey client);
+	// clients with accounting state, see removeClient()
+	size_t clientCount();
+	// seconds one slot spends decoding a second of audio, smoothed over recent chunks;
+	// 0 until the first chunk has been decoded
+	double realTimeFactor();
+
+	DecodeScheduler(const DecodeScheduler&) = delete;
+	DecodeScheduler& operator=(const DecodeScheduler&) = delete;
+
+   private:
+	struct ClientState {
+		// virtual time of the fair share
+		double served_seconds = 0.0;
+		double tokens = 0.0;
+		std::chrono::steady_clock::time_point refilled;
+		size_t waiting = 0;
+		size_t decoding = 0;
+	};
+	struct Waiter {
+		uint64_t ticket;
+		ClientKey client;
+	};
+
+	void refillLocked(ClientState& state, std::chrono::steady_clock::time_point now) const;
+	const Waiter* pickNextLocked();
+	double minActiveServedLocked() const;
+	void removeWaiterLocked(uint64_t ticket);
+
+	std::mutex mutex_;
+	std::condition_variable cv_;
+	const size_t decode_slots_;
+	const double audio_seconds_per_second_;
+	const double burst_seconds_;
+	size_t decoding_ = 0;
+	// weight of the newest chunk in the real-time factor
+	static constexpr double kRTF_SMOOTHING_ = 0.1;
+	double real_time_factor_ = 0.0;
+	uint64_t next_ticket_ = 0;
+	std::map<ClientKey, ClientState> clients_;
+	std::vector<Waiter> waiters_;
+};
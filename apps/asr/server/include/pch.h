@@ -22,11 +22,15 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <csignal>  // For signal handling
+#include <functional>
+#include <future>
 #include <iostream>
+#include <map>
 #include <mutex>
 #include <queue>
 #include <sstream>
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2025 PotterWhite
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include "ASREngine/recognizer/recognizer-stream.h"
+#include "pch.h"
+
+/*
+ * @brief Decoder streams created ahead of the sessions that will use them, so accepting a
+ *        client does not include building its stream. Streams are not handed back: a used
+ *        one carries its utterance state, the acceptor tops the pool up with fresh ones
+ *        while the sessions run.
+ */
+class StreamPool {
+   public:
+	StreamPool(std::shared_ptr<const arcforge::embedded::ai_asr::RecognizerModel> model,
+	           size_t target);
+
+	// a ready stream, or a freshly created one when the pool has run dry
+	arcforge::embedded::ai_asr::RecognizerStream take();
+	// creates streams until target are ready; call it off the session path
+	void refill();
+
+	StreamPool(const StreamPool&) = delete;
+	StreamPool& operator=(const StreamPool&) = delete;
+
+   private:
+	const std::shared_ptr<const arcforge::embedded::ai_asr::RecognizerModel> model_;
+	const size_t target_;
+	std::mutex mutex_;
+	std::vector<arcforge::embedded::ai_asr::RecognizerStream> ready_;
+};
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2025 PotterWhite
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "pch.h"
+
+/*
+ * @brief Fixed set of worker threads, started once and fed from one queue.
+ *        Sessions do not own a worker: each step of a session (whatever input has arrived,
+ *        see ASRTaskSherpa::step()) is one job, so the pool is sized to the cores and the
+ *        thread count and stack memory stay the same however many sessions are open. Workers
+ *        can be pinned round-robin to a list of cpus, e.g. the big cores of the SoC, leaving
+ *        the rest to the event loop and the NPU driver.
+ */
+class WorkerPool {
+   public:
+	// an empty cpus list leaves placement to the scheduler; job_done is called on the worker
+	// after every job, once its future is ready
+	WorkerPool(size_t workers, const std::vector<int>& cpus,
+	           std::function<void()> job_done = nullptr);
+	// jobs still queued are dropped, running ones are waited for
+	~WorkerPool();
+
+	// runs job on the next free worker; the future becomes ready once it has returned
+	std::future<void> submit(std::function<void()> job);
+	size_t size() const;
+
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+
+   private:
+	void workerLoop();
+
+	std::mutex mutex_;
+	std::condition_variable cv_;
+	bool stopping_ = false;
+	std::function<void()> job_done_;
+	std::queue<std::packaged_task<void()>> jobs_;
+	std::vector<std::thread> workers_;
+};
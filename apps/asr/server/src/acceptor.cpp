@@ -49,11 +49,10 @@ Acceptor::~Acceptor() {
 		task_handler.task->stop_me();
 	}
 
-	for (auto& task_handler : active_task_handlers_) {
-		if (task_handler.worker.joinable() == true) {
-			task_handler.worker.join();
-		}
-	}
+	// joins the workers, i.e. waits for every step still running; the tasks, and with them
+	// their connections, go after that
+	workers_.reset();
+	active_task_handlers_.clear();
 }
 
 // Acceptor::~Acceptor() {
@@ -73,21 +72,91 @@ void Acceptor::setSocketPath(const std::string& path) {
 	ksocket_path_ = path;
 }
 
+void Acceptor::setTcpEndpoint(const std::string& host, uint16_t port) {
+	use_tcp_ = true;
+	tcp_host_ = host;
+	tcp_port_ = port;
+}
+
+void Acceptor::setWorkerCount(size_t workers) {
+	worker_count_ = std::max<size_t>(workers, 1);
+}
+
+void Acceptor::setMaxSessions(size_t sessions) {
+	max_sessions_ = std::max<size_t>(sessions, 1);
+}
+
+void Acceptor::setWorkerCpus(const std::vector<int>& cpus) {
+	worker_cpus_ = cpus;
+}
+
+void Acceptor::setListenBacklog(int backlog) {
+	listen_backlog_ = std::max(backlog, 1);
+}
+
+void Acceptor::setSessionsPerClient(size_t sessions) {
+	sessions_per_client_limit_ = std::max<size_t>(sessions, 1);
+}
+
+void Acceptor::setWarmupPasses(int passes) {
+	warmup_passes_ = std::max(passes, 0);
+}
+
+void Acceptor::setStreamPoolSize(size_t streams) {
+	stream_pool_size_ = streams;
+}
+
 void Acceptor::init() {
 
-	// -- 2. create server object
+	// -- 1. load the model every session will share
+	model_ = ASRTaskSherpa::LoadModel();
+	if (model_ == nullptr) {
+		std::ostringstream oss;
+		oss << "[ServerPID:" << getpid() << "] FATAL: ASR model failed to load.";
+		arcforge::embedded::utils::Logger::GetInstance().Error(oss.str(), kcurrent_app_name);
+		return;
+	}
+
+	// -- 2. warm it up and have streams ready before the first client can connect
+	if (warmup_passes_ > 0 && model_->WarmUp(warmup_passes_, kWARMUP_AUDIO_MS_) == false) {
+		arcforge::embedded::utils::Logger::GetInstance().Warning(
+		    "Model warm-up failed, the first sessions pay for it.", kcurrent_app_name);
+	}
+	stream_pool_ = std::make_shared<StreamPool>(model_, stream_pool_size_);
+	stream_pool_->refill();
+
+	// -- 3. start the workers the session steps will run on; every step that ends wakes the
+	//       loop up, so its session is watched again (or recycled) without waiting a timeout
+	arcforge::embedded::network_socket::EventLoop* loop = &server_->getEventLoop();
+	workers_ = std::make_unique<WorkerPool>(worker_count_, worker_cpus_,
+	                                        [loop]() { loop->wakeup(); });
+
+	// -- 4. create server object
 	server_->setSocketPath(ksocket_path_);
+	server_->setListenBacklog(listen_backlog_);
+	if (use_tcp_ == true) {
+		// remote front-ends: small chunks and results, so no Nagle delay (the default options)
+		server_->setTcpEndpoint(tcp_host_, tcp_port_);
+	}
 
-	// -- 2. unlink exist server
-	if (server_->unlinkSocketPath() ==
+	// -- 5. unlink exist server
+	if (use_tcp_ == false && server_->unlinkSocketPath() ==
 	    arcforge::embedded::network_socket::SocketReturnValue::ksuccess) {
 		std::ostringstream oss;
 		oss << "[ServerPID:" << getpid() << "] Removed existing socket file: " << ksocket_path_;
 		arcforge::embedded::utils::Logger::GetInstance().Info(oss.str(), kcurrent_app_name);
 	}
 
-	// -- 3. Start the server
-	if (server_->startServer(timeout_value_) >
+	// -- 6. prefer io_uring for the session sockets, accepted clients inherit it
+	if (server_->setIoBackend(arcforge::embedded::network_socket::IoBackend::kio_uring) !=
+	    arcforge::embedded::network_socket::SocketReturnValue::ksuccess) {
+		arcforge::embedded::utils::Logger::GetInstance().Info(
+		    "io_uring unavailable, sessions use posix send()/recv()", kcurrent_app_name);
+	}
+
+	// -- 7. Start the server
+	//       no accept timeout: readiness of the listening fd is reported by the event loop
+	if (server_->startServer() >
 	    arcforge::embedded::network_socket::SocketReturnValue::ksuccess) {
 		std::ostringstream oss;
 		oss << "[ServerPID:" << getpid() << "] FATAL: Server failed to start on " << ksocket_path_;
@@ -97,9 +166,26 @@ void Acceptor::init() {
 		return;
 	}
 
+	// -- 8. Switch the server to event-driven accepting
+	if (server_->enableEventMode(
+	        [this](std::unique_ptr<arcforge::embedded::network_socket::Base> client) {
+		        onClientAccepted(std::move(client));
+	        }) != arcforge::embedded::network_socket::SocketReturnValue::ksuccess) {
+		std::ostringstream oss;
+		oss << "[ServerPID:" << getpid() << "] FATAL: Server failed to enter event mode on "
+		    << ksocket_path_;
+		arcforge::embedded::utils::Logger::GetInstance().Error(oss.str(), kcurrent_app_name);
+		return;
+	}
+
 	std::ostringstream oss;
-	oss << "[ServerPID:" << getpid() << "] Server started and waiting for any client to come in "
-	    << ksocket_path_;
+	oss << "[ServerPID:" << getpid() << "] Server started and waiting for any client to come in ";
+	if (use_tcp_ == true) {
+		oss << "on TCP " << (tcp_host_.empty() ? "*" : tcp_host_) << ":"
+		    << server_->getLocalPort();
+	} else {
+		oss << ksocket_path_;
+	}
 	arcforge::embedded::utils::Logger::GetInstance().Info(oss.str(), kcurrent_app_name);
 
 	oss.clear();
@@ -137,69 +223,249 @@ void Acceptor::process() {
 	/*-----------------------------------------
 	 * stage 1st. check if we have room in queue
 	 ------------------------------------------*/
+	// a session between steps waits in the event loop, on its input; one whose step has
+	// ended either goes back there or, finished or silent for too long, is recycled. A
+	// session held back by its client's rate quota waits for its resume time instead.
+	const auto checked = std::chrono::steady_clock::now();
+	auto next_resume = std::chrono::steady_clock::time_point::max();
 	for (auto it = active_task_handlers_.begin(); it != active_task_handlers_.end();) {
-		if (it->task->isCompleted() == true) {
-			it->worker.join();
-
+		if (it->step.valid() == true &&
+		    it->step.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+			++it;
+			continue;
+		}
+		it->step = std::future<void>();
+		if (it->task->isCompleted() == true || it->task->expireIdle(checked) == true) {
+			unwatchTask(*it);
+			auto owner = sessions_per_client_.find(it->owner);
+			if (owner != sessions_per_client_.end() && --owner->second == 0) {
+				sessions_per_client_.erase(owner);
+				// every TCP connection and every local process is a client of its own
+				scheduler_->removeClient(it->owner);
+			}
 			it = active_task_handlers_.erase(it);
-		} else {
+			continue;
+		}
+		const auto resume_at = it->task->resumeAt();
+		if (resume_at != std::chrono::steady_clock::time_point()) {
+			if (resume_at <= checked) {
+				ASRTaskSherpa* task = it->task.get();
+				it->step = workers_->submit([task]() { task->step(); });
+			} else {
+				next_resume = std::min(next_resume, resume_at);
+			}
 			++it;
+			continue;
 		}
+		// the input fd may have changed during the step (shm ring, io_uring multishot)
+		if (it->watched_input_fd != it->task->inputFD()) {
+			unwatchTask(*it);
+			watchTask(*it);
+		}
+		++it;
 	}
-
-	if (active_task_handlers_.size() >= kMAX_CONCURRENT_TASKS_) {
-		arcforge::embedded::utils::Logger::GetInstance().Info("Task Queue is full, try next time",
-		                                                    kcurrent_app_name);
-		return;
+	// a finished session may let a queued connection in, one that waited too long is sent away
+	const auto now = std::chrono::steady_clock::now();
+	expirePendingClients(now);
+	startPendingClients();
+
+	// the listening fd stays in the interest set even at capacity: new connections wait in
+	// pending_clients_, where they can be answered busy, not unseen in the listen() backlog
+	int timeout = timeout_value_;
+	if (next_resume != std::chrono::steady_clock::time_point::max()) {
+		const auto until_resume =
+		    std::chrono::duration_cast<std::chrono::milliseconds>(next_resume - now).count();
+		timeout = std::min(timeout, static_cast<int>(std::max<int64_t>(until_resume + 1, 0)));
+	}
+	for (const PendingClient& pending : pending_clients_) {
+		const auto until_deadline =
+		    std::chrono::duration_cast<std::chrono::milliseconds>(pending.deadline - now).count();
+		timeout = std::min(timeout, static_cast<int>(std::max<int64_t>(until_deadline + 1, 0)));
 	}
 
 	/*-----------------------------------------
-	 * stage 2nd. accept client
+	 * stage 2nd. wait for readiness, onClientAccepted() is dispatched from here
 	 ------------------------------------------*/
-	// if runs to this place means we have room for more client
-	arcforge::embedded::utils::Logger::GetInstance().Error("hey, acceptclient start ",
-	                                                     kcurrent_app_name);
-	arcforge::embedded::network_socket::SocketAcceptReturn accept_retval = server_->acceptClient();
-	if (arcforge::embedded::network_socket::SocketReturnValueIsSuccess(accept_retval.return_value) ==
-	    false) {
-		if (accept_retval.return_value ==
-		    // timeout is not an error
-		    arcforge::embedded::network_socket::SocketReturnValue::kaccept_timeout) {
-			arcforge::embedded::utils::Logger::GetInstance().Debug(
-			    "acceptClient() timeout, try next time", kcurrent_app_name);
-			return;
-		}
-
-		// error occurrs
+	arcforge::embedded::network_socket::SocketReturnValue retval =
+	    server_->getEventLoop().runOnce(timeout);
+	if (retval != arcforge::embedded::network_socket::SocketReturnValue::ksuccess) {
 		arcforge::embedded::utils::Logger::GetInstance().Error(
-		    "acceptClient() return" + arcforge::embedded::network_socket::SocketReturnValueToString(
-		                                  accept_retval.return_value),
+		    "event loop returned " +
+		        arcforge::embedded::network_socket::SocketReturnValueToString(retval),
 		    kcurrent_app_name);
+	}
+
+	/*-----------------------------------------
+	 * stage 5th. replace the streams the new sessions took, while they run
+	 ------------------------------------------*/
+	if (stream_pool_ != nullptr) {
+		stream_pool_->refill();
+	}
+}
+
+void Acceptor::onClientAccepted(std::unique_ptr<arcforge::embedded::network_socket::Base> client) {
+	const ClientKey owner = identifyClient(*client);
+
+	if (pending_clients_.size() >= kMAX_PENDING_CLIENTS_) {
+		refuseClient(*client, "Client " + std::to_string(owner) + " found the queue full");
 		return;
 	}
 
+	// behind whoever is already waiting, so a burst of arrivals is served in order
+	const arcforge::embedded::network_socket::Base* arrived = client.get();
+	pending_clients_.push_back(
+	    {owner, std::move(client), std::chrono::steady_clock::now() + kPENDING_DEADLINE_});
+	startPendingClients();
+	if (pending_clients_.empty() == false && pending_clients_.back().client.get() == arrived) {
+		arcforge::embedded::utils::Logger::GetInstance().Info(
+		    "Client " + std::to_string(owner) + " queued, " +
+		        std::to_string(pending_clients_.size()) + " connection(s) waiting.",
+		    kcurrent_app_name);
+	}
+}
+
+ClientKey Acceptor::identifyClient(const arcforge::embedded::network_socket::Base& client) {
+	arcforge::embedded::network_socket::PeerCredentials peer;
+	if (client.getPeerCredentials(peer) !=
+	    arcforge::embedded::network_socket::SocketReturnValue::ksuccess) {
+		return kREMOTE_CLIENT_KEY_BIT | next_remote_client_++;
+	}
+	arcforge::embedded::utils::Logger::GetInstance().Info(
+	    "Client pid " + std::to_string(peer.pid) + " uid " + std::to_string(peer.uid) +
+	        " connected.",
+	    kcurrent_app_name);
+	return (static_cast<ClientKey>(static_cast<uint32_t>(peer.pid)) << 32) |
+	       static_cast<ClientKey>(peer.uid);
+}
+
+void Acceptor::startTask(ClientKey owner,
+                         std::unique_ptr<arcforge::embedded::network_socket::Base> client) {
 	/*-----------------------------------------
 	 * stage 3rd. Create new Task
 	 ------------------------------------------*/
 	arcforge::embedded::utils::Logger::GetInstance().Info(
-	    "\nNew client connected. Creating worker thread.", kcurrent_app_name);
+	    "\nNew client connected. Handing it to a worker.", kcurrent_app_name);
+
+	auto new_task = ASRTaskSherpa::Create(std::move(client), model_, stream_pool_);
 
-	auto new_task = ASRTaskSherpa::Create(std::move(accept_retval.client));
+	new_task->setScheduler(scheduler_, owner);
 
 	/*-----------------------------------------
-	 * stage 4th. Create work to do the previous created Task
+	 * stage 4th. Wait for its first frame; each step then runs on a pool worker
 	 *------------------------------------------*/
-	// std::thread t(&ASRTaskSherpa::run, asr_task_sherpa_.get());
-	// std::thread t(&ASRTaskSherpa::run);
-	// t.detach();
-	auto new_worker = std::thread(&ASRTaskSherpa::run, new_task.get());
+	TaskHandle handle;
+	handle.task = std::move(new_task);
+	handle.owner = owner;
+	active_task_handlers_.push_back(std::move(handle));
+	watchTask(active_task_handlers_.back());
+	++sessions_per_client_[owner];
+}
 
-	// worker_thread_.detach();
-	// worker_thread_.join();
+// registers the session's input on the event loop until it is ready for a step
+void Acceptor::watchTask(TaskHandle& handle) {
+	ASRTaskSherpa* task = handle.task.get();
+	arcforge::embedded::network_socket::EventLoop& loop = server_->getEventLoop();
+	const auto on_ready = [this, task](uint32_t /*events*/) { stepTask(task); };
 
-	active_task_handlers_.push_back({std::move(new_task), std::move(new_worker)});
-	// active_task_handlers_.emplace_back(std::move(new_task),
-	//                                    std::thread(&ASRTaskSherpa::run, new_task.get()));
+	const int input_fd = task->inputFD();
+	if (loop.addFD(input_fd, arcforge::embedded::network_socket::kevent_readable, on_ready,
+	               [task]() { return task->hasBufferedInput(); }) !=
+	    arcforge::embedded::network_socket::SocketReturnValue::ksuccess) {
+		// nothing would ever wake the session: let one step end it
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "Session input cannot be watched, stopping the session.", kcurrent_app_name);
+		task->stop_me();
+		handle.step = workers_->submit([task]() { task->step(); });
+		return;
+	}
+	handle.watched_input_fd = input_fd;
+
+	// a same-host client that vanishes shows on its socket, not on the ring
+	const int hangup_fd = task->hangupFD();
+	if (hangup_fd >= 0 &&
+	    loop.addFD(hangup_fd, arcforge::embedded::network_socket::kevent_hangup, on_ready) ==
+	        arcforge::embedded::network_socket::SocketReturnValue::ksuccess) {
+		handle.watched_hangup_fd = hangup_fd;
+	}
+}
+
+void Acceptor::unwatchTask(TaskHandle& handle) {
+	arcforge::embedded::network_socket::EventLoop& loop = server_->getEventLoop();
+	if (handle.watched_input_fd >= 0) {
+		loop.removeFD(handle.watched_input_fd);
+		handle.watched_input_fd = -1;
+	}
+	if (handle.watched_hangup_fd >= 0) {
+		loop.removeFD(handle.watched_hangup_fd);
+		handle.watched_hangup_fd = -1;
+	}
+}
+
+// input arrived: the session leaves the event loop for one step on a pool worker
+void Acceptor::stepTask(ASRTaskSherpa* task) {
+	for (TaskHandle& handle : active_task_handlers_) {
+		if (handle.task.get() != task) {
+			continue;
+		}
+		unwatchTask(handle);
+		if (handle.step.valid() == false) {
+			handle.step = workers_->submit([task]() { task->step(); });
+		}
+		return;
+	}
+}
+
+// oldest first, skipping clients that are still at their quota
+void Acceptor::startPendingClients() {
+	auto it = pending_clients_.begin();
+	while (it != pending_clients_.end() && hasCapacity() == true) {
+		auto sessions = sessions_per_client_.find(it->owner);
+		if (sessions != sessions_per_client_.end() &&
+		    sessions->second >= sessions_per_client_limit_) {
+			++it;
+			continue;
+		}
+		PendingClient pending = std::move(*it);
+		it = pending_clients_.erase(it);
+		startTask(pending.owner, std::move(pending.client));
+	}
+}
+
+// a free worker is not enough: the sessions streaming in real time, each keeping a decode
+// slot busy for the measured real-time factor, must leave the slots some headroom
+bool Acceptor::hasCapacity() {
+	const size_t active = active_task_handlers_.size();
+	if (active >= max_sessions_) {
+		return false;
+	}
+	if (active == 0) {
+		// nothing running that a new session could slow down
+		return true;
+	}
+	const double load = static_cast<double>(active + 1) * scheduler_->realTimeFactor();
+	return load <= static_cast<double>(kDECODE_SLOTS_) * kDECODE_HEADROOM_;
+}
+
+void Acceptor::expirePendingClients(std::chrono::steady_clock::time_point now) {
+	for (auto it = pending_clients_.begin(); it != pending_clients_.end();) {
+		if (it->deadline > now) {
+			++it;
+			continue;
+		}
+		refuseClient(*it->client, "Client " + std::to_string(it->owner) +
+		                              " waited past its deadline in the queue");
+		it = pending_clients_.erase(it);
+	}
+}
+
+// the connection is closed by its owner right after, the hint tells the client when to retry
+void Acceptor::refuseClient(arcforge::embedded::network_socket::Base& client,
+                            const std::string& why) {
+	arcforge::embedded::utils::Logger::GetInstance().Warning(
+	    why + ", answered busy (retry after " + std::to_string(kBUSY_RETRY_AFTER_.count()) +
+	        " ms).",
+	    kcurrent_app_name);
+	client.sendBusy(kBUSY_RETRY_AFTER_);
 }
 
 // void Acceptor::process() {
@@ -253,13 +519,46 @@ void Acceptor::process() {
 // }
 
 void Acceptor::stop_me() {
+	const auto begin = std::chrono::steady_clock::now();
+
+	// queued connections were never read from, closing them is all they need
+	pending_clients_.clear();
+
+	// stop_me() cancels the connection instead of waiting for the step to let go of it, so
+	// every session is interrupted at once; one that waits for input has no step to end
 	for (auto& task_handler : active_task_handlers_) {
+		unwatchTask(task_handler);
 		if (task_handler.task->isCompleted() == false) {
 			arcforge::embedded::utils::Logger::GetInstance().Info(
 			    "Acceptor will send stop signal to ASRTaskSherpa.");
 			task_handler.task->stop_me();
 		}
 	}
+
+	// drain: steps finish the chunk they are on and return, a stuck one is left to the
+	// destructor instead of holding up the rest
+	const auto give_up = begin + kSHUTDOWN_GRACE_;
+	for (auto it = active_task_handlers_.begin(); it != active_task_handlers_.end();) {
+		if (it->step.valid() == true &&
+		    it->step.wait_until(give_up) != std::future_status::ready) {
+			++it;
+			continue;
+		}
+		it = active_task_handlers_.erase(it);
+	}
+
+	const auto drain_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+	                          std::chrono::steady_clock::now() - begin)
+	                          .count();
+	if (active_task_handlers_.empty() == true) {
+		arcforge::embedded::utils::Logger::GetInstance().Info(
+		    "All sessions drained in " + std::to_string(drain_ms) + " ms.", kcurrent_app_name);
+	} else {
+		arcforge::embedded::utils::Logger::GetInstance().Warning(
+		    std::to_string(active_task_handlers_.size()) + " session(s) still running after " +
+		        std::to_string(drain_ms) + " ms.",
+		    kcurrent_app_name);
+	}
 }
 // void Acceptor::stop_me() {
 // 	if (asr_task_sherpa_ != nullptr) {
@@ -49,18 +49,38 @@ const std::string PROVIDER = "rknn";
 const int NUM_THREADS = -4;
 
 std::unique_ptr<ASRTaskSherpa> ASRTaskSherpa::Create(
-    std::unique_ptr<arcforge::embedded::network_socket::Base> client) {
+    std::unique_ptr<arcforge::embedded::network_socket::Base> client,
+    std::shared_ptr<const arcforge::embedded::ai_asr::RecognizerModel> model,
+    std::shared_ptr<StreamPool> streams) {
 
 	// return std::make_unique<ASRTaskSherpa>();
-	auto task = std::unique_ptr<ASRTaskSherpa>(new ASRTaskSherpa());
+	auto task = std::unique_ptr<ASRTaskSherpa>(
+	    new ASRTaskSherpa(std::move(model), std::move(streams)));
 	task->setClient(std::move(client));
 
 	return task;
 }
 
-ASRTaskSherpa::ASRTaskSherpa() {
+ASRTaskSherpa::ASRTaskSherpa(
+    std::shared_ptr<const arcforge::embedded::ai_asr::RecognizerModel> model,
+    std::shared_ptr<StreamPool> streams)
+    : model_(std::move(model)), stream_pool_(std::move(streams)), asr_engine_(takeStream()) {
 	arcforge::embedded::utils::Logger::GetInstance().Info("constructor of ASRTaskSherpa class",
 	                                                      kcurrent_app_name);
+	decode_slice_ = [this](const arcforge::embedded::network_socket::SampleSlice& slice) {
+		if (slice.offset == 0) {
+			frame_refused_ = session_.max_frame_samples != 0 &&
+			                 slice.frame_count > session_.max_frame_samples;
+			first_slice_time_ = std::chrono::steady_clock::now();
+			first_slot_time_ = first_slice_time_;
+		}
+		if (frame_refused_ == false && decode_stopped_ == false) {
+			decode_stopped_ = (decode(asr_engine_, slice.samples, slice.count) == false);
+			if (slice.offset == 0) {
+				first_slot_time_ = slot_granted_;
+			}
+		}
+	};
 	init();
 }
 
@@ -69,6 +89,13 @@ ASRTaskSherpa::~ASRTaskSherpa() {
 	                                                      kcurrent_app_name);
 }
 
+arcforge::embedded::ai_asr::RecognizerStream ASRTaskSherpa::takeStream() {
+	if (stream_pool_ != nullptr) {
+		return stream_pool_->take();
+	}
+	return arcforge::embedded::ai_asr::RecognizerStream(model_);
+}
+
 void ASRTaskSherpa::setClient(std::unique_ptr<arcforge::embedded::network_socket::Base> client) {
 	client_ = std::move(client);
 }
@@ -77,144 +104,800 @@ bool ASRTaskSherpa::isCompleted() const {
 	return finished_flag_;
 }
 
+void ASRTaskSherpa::setScheduler(std::shared_ptr<DecodeScheduler> scheduler, ClientKey owner) {
+	scheduler_ = std::move(scheduler);
+	owner_ = owner;
+}
+
+bool ASRTaskSherpa::decode(arcforge::embedded::ai_asr::RecognizerStream& recognizer,
+                           const float* samples, size_t count) {
+	const int sample_rate = static_cast<int>(session_.params.sample_rate);
+	if (scheduler_ == nullptr) {
+		slot_granted_ = std::chrono::steady_clock::now();
+		recognizer.ProcessAudioChunk(samples, count, sample_rate);
+		return true;
+	}
+	const double audio_seconds =
+	    static_cast<double>(count) / static_cast<double>(std::max(sample_rate, 1));
+	if (scheduler_->acquire(owner_, audio_seconds, stop_flag_) == false) {
+		return false;
+	}
+	slot_granted_ = std::chrono::steady_clock::now();
+	recognizer.ProcessAudioChunk(samples, count, sample_rate);
+	scheduler_->release(owner_, audio_seconds, std::chrono::steady_clock::now() - slot_granted_);
+	return true;
+}
+
+void ASRTaskSherpa::logChunkLatency(const arcforge::embedded::network_socket::FrameInfo& frame,
+                                    std::chrono::steady_clock::time_point dequeued,
+                                    std::chrono::steady_clock::time_point decode_begin,
+                                    std::chrono::steady_clock::time_point decode_end) const {
+	if (frame.has_metadata == false) {
+		return;
+	}
+	// FrameInfo counts steady_clock nanoseconds, which client and server share on one host
+	const auto at = [](int64_t ns) {
+		return std::chrono::steady_clock::time_point(
+		    std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+		        std::chrono::nanoseconds(ns)));
+	};
+	const auto us = [](std::chrono::steady_clock::duration span) {
+		return std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(span).count());
+	};
+
+	std::string line = "chunk #" + std::to_string(frame.sequence) + ": ";
+	if (frame.kernel_rx_ns != 0) {
+		line += "transport " + us(at(frame.kernel_rx_ns) - at(frame.sent_ns)) +
+		        " us, socket queue " + us(dequeued - at(frame.kernel_rx_ns)) + " us, ";
+	} else {
+		// no kernel timestamp on this transport
+		line += "client to worker " + us(dequeued - at(frame.sent_ns)) + " us, ";
+	}
+	line += "server queue " + us(decode_begin - dequeued) + " us, decode " +
+	        us(decode_end - decode_begin) + " us";
+	arcforge::embedded::utils::Logger::GetInstance().Debug(line, kcurrent_app_name);
+}
+
+arcforge::embedded::ai_asr::SherpaConfig ASRTaskSherpa::makeSherpaConfig() {
+	return arcforge::embedded::ai_asr::SherpaConfig::Builder()
+	    .setFirstEncoderPath(ENCODER_PATH)
+	    .setSecondDecoderPath(DECODER_PATH)
+	    .setThirdJoinerPath(JOINER_PATH)
+	    .setFourthTokensPath(TOKENS_PATH)
+	    .setFifthProvider(PROVIDER)
+	    .setSixthNumThreads(NUM_THREADS)
+	    .setTwelfthEndpointDetectionSupport(
+	        arcforge::embedded::ai_asr::SherpaEndPointSupport::kenable)
+	    .setThirteenthMaxBatchSize(kDECODE_BATCH_SIZE_)
+	    .setFourteenthMaxBatchWaitMs(kDECODE_BATCH_WAIT_MS_)
+	    .build();
+}
+
+std::shared_ptr<arcforge::embedded::ai_asr::RecognizerModel> ASRTaskSherpa::LoadModel() {
+	return arcforge::embedded::ai_asr::RecognizerModel::Create(makeSherpaConfig());
+}
+
 bool ASRTaskSherpa::init() {
-	// --- 1. Init ASR Engine  ---
-	arcforge::embedded::ai_asr::SherpaConfig config =
-	    arcforge::embedded::ai_asr::SherpaConfig::Builder()
-	        .setFirstEncoderPath(ENCODER_PATH)
-	        .setSecondDecoderPath(DECODER_PATH)
-	        .setThirdJoinerPath(JOINER_PATH)
-	        .setFourthTokensPath(TOKENS_PATH)
-	        .setFifthProvider(PROVIDER)
-	        .setSixthNumThreads(NUM_THREADS)
-	        .setTwelfthEndpointDetectionSupport(
-	            arcforge::embedded::ai_asr::SherpaEndPointSupport::kenable)
-	        .build();
-
-	bool Erfolg = asr_engine_.Initialize(config);
+	// --- 1. Init ASR Engine: a stream on the shared model ---
+	bool Erfolg = asr_engine_.IsValid();
 	if (!Erfolg) {
 		arcforge::embedded::utils::Logger::GetInstance().Error(
 		    "Failed to initialize ASR engine. Exiting.", kcurrent_app_name);
 		return false;
 	}
 
+	// clients without a hello stream at the model's rate
+	session_.params.sample_rate = static_cast<uint32_t>(asr_engine_.GetExpectedSampleRate());
+
 	arcforge::embedded::utils::Logger::GetInstance().Info("ASRTaskSherpa has done with init!",
 	                                                      kcurrent_app_name);
 
 	return true;
 }
 
-void ASRTaskSherpa::run() {
+arcforge::embedded::network_socket::SessionGrant ASRTaskSherpa::grantSession(
+    const arcforge::embedded::network_socket::StreamParams& requested) const {
+	arcforge::embedded::network_socket::SessionGrant grant;
+	grant.params.protocol_version =
+	    std::min(requested.protocol_version, arcforge::embedded::network_socket::kprotocol_version);
+	// sherpa resamples anything in this range, other rates get the model's own
+	if (requested.sample_rate >= kMIN_SAMPLE_RATE_ && requested.sample_rate <= kMAX_SAMPLE_RATE_) {
+		grant.params.sample_rate = requested.sample_rate;
+	} else {
+		grant.params.sample_rate = static_cast<uint32_t>(asr_engine_.GetExpectedSampleRate());
+	}
+	// takeHello() already turned an unknown encoding into float32
+	grant.params.encoding = requested.encoding;
+	grant.params.chunk_duration_ms =
+	    std::clamp(requested.chunk_duration_ms, kMIN_CHUNK_DURATION_MS_, kMAX_CHUNK_DURATION_MS_);
+	// one result per chunk, in order; a pipelined client need not wait for it before sending
+	// the next chunk, up to the credit window
+	grant.params.pipelined_results = requested.pipelined_results;
+	// twice the agreed chunk, so a client that rounds up is not cut off
+	grant.max_frame_samples =
+	    grant.params.sample_rate * grant.params.chunk_duration_ms / 1000 * 2;
+	// results pushed as the decoder has them, for the whole connection; multiplexed sessions
+	// keep one answer per chunk
+	grant.params.push_results = requested.push_results && requested.max_streams <= 1;
+	// stamped chunks let logChunkLatency() tell where the time went
+	grant.params.frame_metadata = requested.frame_metadata;
+	grant.max_inflight_chunks = 1;
+	if (grant.params.pipelined_results == true || grant.params.push_results == true) {
+		uint32_t sample_bytes = sizeof(float);
+		if (grant.params.encoding == arcforge::embedded::network_socket::SampleEncoding::kpcm16) {
+			sample_bytes = sizeof(int16_t);
+		} else if (grant.params.encoding ==
+		           arcforge::embedded::network_socket::SampleEncoding::kmulaw) {
+			sample_bytes = sizeof(uint8_t);
+		}
+		const uint32_t chunk_bytes = grant.max_frame_samples / 2 * sample_bytes;
+		grant.max_inflight_chunks =
+		    std::clamp<uint32_t>(kSESSION_BUFFER_BYTES_ / std::max<uint32_t>(chunk_bytes, 1), 1,
+		                         kMAX_INFLIGHT_CHUNKS_);
+	}
+	grant.idle_timeout_ms = static_cast<uint32_t>(kCLIENT_IDLE_TIMEOUT_.count());
+	grant.params.max_streams = std::clamp<uint32_t>(requested.max_streams, 1, kMAX_MUX_STREAMS_);
+
 	arcforge::embedded::utils::Logger::GetInstance().Info(
-	    "Worker thread started for a new client.");
+	    "Session granted: " + std::to_string(grant.params.sample_rate) + " Hz, " +
+	        std::to_string(grant.params.chunk_duration_ms) + " ms chunks, " +
+	        std::to_string(grant.max_inflight_chunks) + " in flight.",
+	    kcurrent_app_name);
+	return grant;
+}
 
-	while (stop_flag_ == false) {
+bool ASRTaskSherpa::step() {
+	resume_at_ = std::chrono::steady_clock::time_point();
+	// chunks a throttled step left undecoded go first
+	if (mode_ == SessionMode::kpushed && pushed_chunks_.empty() == false &&
+	    finished_flag_ == false && stop_flag_ == false) {
+		decodePushed();
+	}
+	// a wake-up with nothing to read, e.g. the signal of a frame an earlier step already
+	// took, ends the step right away
+	while (finished_flag_ == false && stop_flag_ == false && throttled() == false &&
+	       inputReady() == true) {
+		switch (mode_) {
+			case SessionMode::kmultiplexed:
+				stepMultiplexed();
+				break;
+			case SessionMode::kpushed:
+				stepPushed();
+				break;
+			case SessionMode::klockstep:
+			default:
+				stepLockstep();
+				break;
+		}
+	}
+	if (stop_flag_ == true && finished_flag_ == false) {
+		finish("stop requested.");
+	}
+	return finished_flag_ == false;
+}
 
-		std::vector<float> audio_chunk;
-		arcforge::embedded::network_socket::SocketReturnValue retval;
+bool ASRTaskSherpa::inputReady() {
+	if (shm_channel_ != nullptr) {
+		if (shm_channel_->armReadiness() == true) {
+			return true;
+		}
+		// a client that vanished never writes its EOF into the ring, the read notices the
+		// hangup on the socket instead
+		struct pollfd control = {client_->getFD(), POLLRDHUP, 0};
+		return ::poll(&control, 1, 0) > 0;
+	}
+	if (client_->hasBufferedData() == true) {
+		return true;
+	}
+	struct pollfd input = {client_->getReadinessFD(), POLLIN, 0};
+	return ::poll(&input, 1, 0) > 0;
+}
+
+std::chrono::steady_clock::time_point ASRTaskSherpa::resumeAt() const {
+	return resume_at_;
+}
 
-		// step 1: Safely receive data
-		// Before accessing client_, we must lock.
-		// Must protect the entire receiveFloat call to ensure that the main thread does not reset client_ during reception.
-		{
-			std::lock_guard<std::mutex> lock(client_mutex_);
+bool ASRTaskSherpa::throttled() {
+	const auto now = std::chrono::steady_clock::now();
+	if (resume_at_ > now) {
+		return true;
+	}
+	if (scheduler_ == nullptr) {
+		return false;
+	}
+	// the granted chunk length stands in for the chunk not read yet
+	const double chunk_seconds = static_cast<double>(session_.params.chunk_duration_ms) / 1000.0;
+	const auto delay = scheduler_->quotaDelay(owner_, chunk_seconds);
+	if (delay == std::chrono::steady_clock::duration::zero()) {
+		return false;
+	}
+	resume_at_ = now + delay;
+	return true;
+}
 
-			// check again for client_ because it might have been destroyed by stop_me() between loops
-			if (!client_) {
-				// if client_ is null, it means we are asked to stop, so just exit the loop
+int ASRTaskSherpa::inputFD() const {
+	if (shm_channel_ != nullptr) {
+		return shm_channel_->getReadinessFD();
+	}
+	return client_->getReadinessFD();
+}
+
+int ASRTaskSherpa::hangupFD() const {
+	return (shm_channel_ != nullptr) ? client_->getFD() : -1;
+}
+
+bool ASRTaskSherpa::hasBufferedInput() {
+	if (shm_channel_ != nullptr) {
+		return shm_channel_->armReadiness();
+	}
+	return client_->hasBufferedData();
+}
+
+bool ASRTaskSherpa::expireIdle(std::chrono::steady_clock::time_point now) {
+	if (finished_flag_ == true || now - last_input_time_ < kCLIENT_IDLE_TIMEOUT_) {
+		return false;
+	}
+	finish("Client idle for too long.");
+	return true;
+}
+
+void ASRTaskSherpa::finish(const std::string& reason) {
+	mux_sessions_.clear();
+	pushed_chunks_ = {};
+	pushed_spare_.clear();
+	finished_flag_ = true;
+	arcforge::embedded::utils::Logger::GetInstance().Info("Session finished. Reason: " + reason,
+	                                                      kcurrent_app_name);
+}
+
+// one frame of a plain session: the opening hello, shm and encoding offers, then one chunk
+// and its answer at a time
+bool ASRTaskSherpa::stepLockstep() {
+	arcforge::embedded::network_socket::SocketReturnValue retval;
+	const float* samples = nullptr;
+	size_t sample_count = 0;
+	bool streamed = false;
+	uint32_t streamed_count = 0;
+	arcforge::embedded::network_socket::FrameInfo frame;
+
+	// audio_chunk_ keeps its storage across chunks, so steady-state receives neither
+	// allocate nor zero-fill
+	if (shm_channel_ != nullptr) {
+		// same-host client: the recognizer reads the samples in place from the ring,
+		// stop_me() closes the ring to wake it
+		retval = shm_channel_->peekFloat(samples, sample_count);
+	} else {
+		const auto deadline = std::chrono::steady_clock::now() + kFRAME_DEADLINE_;
+		switch (sample_encoding_) {
+			case arcforge::embedded::network_socket::SampleEncoding::kpcm16:
+				retval = client_->receivePcm16(pcm16_chunk_, deadline);
 				break;
-			}
+			case arcforge::embedded::network_socket::SampleEncoding::kmulaw:
+				retval = client_->receiveMulaw(mulaw_chunk_, deadline);
+				break;
+			case arcforge::embedded::network_socket::SampleEncoding::kfloat32:
+			default:
+				retval = client_->receiveFloatStreaming(
+				    session_.params.sample_rate * kDECODE_SLICE_MS_ / 1000, decode_slice_,
+				    streamed_count, deadline);
+				streamed = true;
+				break;
+		}
+		if (retval == arcforge::embedded::network_socket::SocketReturnValue::ksuccess) {
+			frame = client_->getLastFrameInfo();
+		}
+	}
+
+	// the client offered a shared-memory ring instead of its first chunk
+	if (retval == arcforge::embedded::network_socket::SocketReturnValue::kreceived_fds) {
+		std::unique_ptr<arcforge::embedded::network_socket::ShmChannel> channel;
+		retval = arcforge::embedded::network_socket::ShmChannel::accept(*client_, channel);
+		if (retval == arcforge::embedded::network_socket::SocketReturnValue::ksuccess) {
+			arcforge::embedded::utils::Logger::GetInstance().Info(
+			    "Client switched audio to shared-memory ring.", kcurrent_app_name);
+			std::lock_guard<std::mutex> shm_lock(shm_mutex_);
+			shm_channel_ = std::move(channel);
+			return true;
+		}
+	}
 
-			// This call may block for a long time, but we must hold the lock to prevent client_ from being reset.
-			retval = client_->receiveFloat(audio_chunk);
+	// the client asked for a compact sample format before its first chunk
+	if (retval == arcforge::embedded::network_socket::SocketReturnValue::kreceived_encoding_offer) {
+		retval = client_->acceptSampleEncoding(sample_encoding_);
+		if (retval == arcforge::embedded::network_socket::SocketReturnValue::ksuccess) {
+			return true;
 		}
+	}
 
-		// --- Step 2: Process received data ---
-		// if (receive failed, including being interrupted by stop_me), exit the loop
-		if (retval != arcforge::embedded::network_socket::SocketReturnValue::ksuccess) {
-			std::string reason;
-			switch (retval) {
-				case arcforge::embedded::network_socket::SocketReturnValue::ksuccess:
-					reason = "Successful receive.";
-					break;
-				case arcforge::embedded::network_socket::SocketReturnValue::keof:
-					reason = "Client closed connection gracefully (EOF).";
-					break;
-				case arcforge::embedded::network_socket::SocketReturnValue::kpeer_abnormally_closed:
-					reason = "Peer abnormally closed connection.";
-					break;
-				case arcforge::embedded::network_socket::SocketReturnValue::kreceived_illegal:
-					reason =
-					    "recv() failed, likely because server initiated shutdown by closing the "
-					    "socket.";
-					break;
-				case arcforge::embedded::network_socket::SocketReturnValue::kreceived_null:
-				case arcforge::embedded::network_socket::SocketReturnValue::kreceivelength_failed:
-				case arcforge::embedded::network_socket::SocketReturnValue::ksendcount_failed:
-				case arcforge::embedded::network_socket::SocketReturnValue::ksenddata_failed:
-				case arcforge::embedded::network_socket::SocketReturnValue::ksendlength_failed:
-				case arcforge::embedded::network_socket::SocketReturnValue::kcount_too_large:
-				case arcforge::embedded::network_socket::SocketReturnValue::kempty_string:
-				case arcforge::embedded::network_socket::SocketReturnValue::kfd_illegal:
-				case arcforge::embedded::network_socket::SocketReturnValue::ksocketpath_empty:
-				case arcforge::embedded::network_socket::SocketReturnValue::kconnect_server_failed:
-				case arcforge::embedded::network_socket::SocketReturnValue::klisten_error:
-				case arcforge::embedded::network_socket::SocketReturnValue::kbind_error:
-				case arcforge::embedded::network_socket::SocketReturnValue::kaccept_timeout:
-				case arcforge::embedded::network_socket::SocketReturnValue::ksetsocketopt_error:
-				case arcforge::embedded::network_socket::SocketReturnValue::kimpl_nullptr_error:
-				case arcforge::embedded::network_socket::SocketReturnValue::kinit_state:
-				case arcforge::embedded::network_socket::SocketReturnValue::kunknownerror:
-				default:
-					reason = "An unexpected socket error occurred: " +
-					         arcforge::embedded::network_socket::SocketReturnValueToString(retval);
-					break;
+	// versioned clients open with a hello: rate, encoding and limits are settled once
+	// per session instead of being guessed per chunk
+	if (retval == arcforge::embedded::network_socket::SocketReturnValue::kreceived_hello) {
+		arcforge::embedded::network_socket::StreamParams requested;
+		retval = client_->takeHello(requested);
+		if (retval == arcforge::embedded::network_socket::SocketReturnValue::ksuccess) {
+			session_ = grantSession(requested);
+			retval = client_->answerHello(session_);
+		}
+		if (retval == arcforge::embedded::network_socket::SocketReturnValue::ksuccess) {
+			sample_encoding_ = session_.params.encoding;
+			if (session_.params.frame_metadata == true) {
+				// best effort: without them the latency log lumps transport and queue
+				client_->setReceiveTimestamps(true);
 			}
-			arcforge::embedded::utils::Logger::GetInstance().Info(
-			    "Exiting worker thread. Reason: " + reason);
-			break;
+			handshaken_ = true;
+			if (session_.params.max_streams > 1) {
+				// every further frame carries a stream id
+				mode_ = SessionMode::kmultiplexed;
+				arcforge::embedded::utils::Logger::GetInstance().Info(
+				    "Connection multiplexes up to " + std::to_string(session_.params.max_streams) +
+				        " sessions.",
+				    kcurrent_app_name);
+			} else if (session_.params.push_results == true) {
+				// audio and results part ways from here on
+				mode_ = SessionMode::kpushed;
+				arcforge::embedded::utils::Logger::GetInstance().Info(
+				    "Session pushes results as the decoder produces them.", kcurrent_app_name);
+			}
+			return true;
 		}
+	}
 
-		// --- Step 3: ASR processing (this is pure computation, no locking needed) ---
-		asr_engine_.ProcessAudioChunk(audio_chunk);
-		std::string recognized_text = asr_engine_.GetCurrentText();
+	// the rest of a frame did not come in time; if that broke the framing, the next receive
+	// says so
+	if (retval == arcforge::embedded::network_socket::SocketReturnValue::kio_timeout) {
+		return true;
+	}
+	if (retval == arcforge::embedded::network_socket::SocketReturnValue::ksuccess) {
+		last_input_time_ = std::chrono::steady_clock::now();
+	}
 
-		// --- Step 4: Safely send result ---
-		// Similarly, lock before accessing client_
-		{
-			std::lock_guard<std::mutex> lock(client_mutex_);
+	// a handshaken client keeps its connection across utterances (see ClientPool): EOF
+	// only closes the utterance, the next one skips connect and hello
+	if (retval == arcforge::embedded::network_socket::SocketReturnValue::keof &&
+	    handshaken_ == true && shm_channel_ == nullptr) {
+		asr_engine_.ResetStream();
+		last_input_time_ = std::chrono::steady_clock::now();
+		arcforge::embedded::utils::Logger::GetInstance().Info(
+		    "Utterance ended, session stays open.", kcurrent_app_name);
+		return true;
+	}
 
-			if (!client_) {
-				arcforge::embedded::utils::Logger::GetInstance().Warning(
-				    "Client connection was closed before sending result.");
+	// --- Step 2: Process received data ---
+	// if (receive failed, including being interrupted by stop_me), the session is over
+	if (retval != arcforge::embedded::network_socket::SocketReturnValue::ksuccess) {
+		std::string reason;
+		switch (retval) {
+			case arcforge::embedded::network_socket::SocketReturnValue::ksuccess:
+				reason = "Successful receive.";
 				break;
-			}
+			case arcforge::embedded::network_socket::SocketReturnValue::keof:
+				reason = "Client closed connection gracefully (EOF).";
+				break;
+			case arcforge::embedded::network_socket::SocketReturnValue::kpeer_abnormally_closed:
+				reason = "Peer abnormally closed connection.";
+				break;
+			case arcforge::embedded::network_socket::SocketReturnValue::kcancelled:
+				reason = "Connection cancelled for shutdown.";
+				break;
+			case arcforge::embedded::network_socket::SocketReturnValue::kreceived_illegal:
+				reason =
+				    "recv() failed, likely because server initiated shutdown by closing the "
+				    "socket.";
+				break;
+			case arcforge::embedded::network_socket::SocketReturnValue::kio_timeout:
+			case arcforge::embedded::network_socket::SocketReturnValue::kreceived_null:
+			case arcforge::embedded::network_socket::SocketReturnValue::kreceivelength_failed:
+			case arcforge::embedded::network_socket::SocketReturnValue::kreceived_fds:
+			case arcforge::embedded::network_socket::SocketReturnValue::kreceived_encoding_offer:
+			case arcforge::embedded::network_socket::SocketReturnValue::kreceived_hello:
+			case arcforge::embedded::network_socket::SocketReturnValue::kserver_busy:
+			case arcforge::embedded::network_socket::SocketReturnValue::ksendcount_failed:
+			case arcforge::embedded::network_socket::SocketReturnValue::ksenddata_failed:
+			case arcforge::embedded::network_socket::SocketReturnValue::ksendlength_failed:
+			case arcforge::embedded::network_socket::SocketReturnValue::kno_send_credit:
+			case arcforge::embedded::network_socket::SocketReturnValue::kcount_too_large:
+			case arcforge::embedded::network_socket::SocketReturnValue::kempty_string:
+			case arcforge::embedded::network_socket::SocketReturnValue::kfd_illegal:
+			case arcforge::embedded::network_socket::SocketReturnValue::ksocketpath_empty:
+			case arcforge::embedded::network_socket::SocketReturnValue::kbuffer_too_small:
+			case arcforge::embedded::network_socket::SocketReturnValue::ksample_encoding_mismatch:
+			case arcforge::embedded::network_socket::SocketReturnValue::kconnect_server_failed:
+			case arcforge::embedded::network_socket::SocketReturnValue::klisten_error:
+			case arcforge::embedded::network_socket::SocketReturnValue::kbind_error:
+			case arcforge::embedded::network_socket::SocketReturnValue::kaccept_timeout:
+			case arcforge::embedded::network_socket::SocketReturnValue::ksetsocketopt_error:
+			case arcforge::embedded::network_socket::SocketReturnValue::kepoll_error:
+			case arcforge::embedded::network_socket::SocketReturnValue::kpool_closed:
+			case arcforge::embedded::network_socket::SocketReturnValue::kpeer_credentials_unavailable:
+			case arcforge::embedded::network_socket::SocketReturnValue::kimpl_nullptr_error:
+			case arcforge::embedded::network_socket::SocketReturnValue::kio_backend_unavailable:
+			case arcforge::embedded::network_socket::SocketReturnValue::kinit_state:
+			case arcforge::embedded::network_socket::SocketReturnValue::kunknownerror:
+			default:
+				reason = "An unexpected socket error occurred: " +
+				         arcforge::embedded::network_socket::SocketReturnValueToString(retval);
+				break;
+		}
+		finish(reason);
+		return false;
+	}
+
+	if (streamed == true) {
+		// already decoded while it arrived
+		sample_count = streamed_count;
+	} else if (shm_channel_ == nullptr) {
+		// compact wire formats are widened to float here
+		switch (sample_encoding_) {
+			case arcforge::embedded::network_socket::SampleEncoding::kpcm16:
+				audio_chunk_.resize(pcm16_chunk_.size());
+				arcforge::embedded::network_socket::ConvertPcm16ToFloat(
+				    pcm16_chunk_.data(), audio_chunk_.data(), pcm16_chunk_.size());
+				break;
+			case arcforge::embedded::network_socket::SampleEncoding::kmulaw:
+				audio_chunk_.resize(mulaw_chunk_.size());
+				arcforge::embedded::network_socket::ConvertMulawToFloat(
+				    mulaw_chunk_.data(), audio_chunk_.data(), mulaw_chunk_.size());
+				break;
+			case arcforge::embedded::network_socket::SampleEncoding::kfloat32:
+			default:
+				break;
+		}
+		samples = audio_chunk_.data();
+		sample_count = audio_chunk_.size();
+	}
+
+	if (session_.max_frame_samples != 0 && sample_count > session_.max_frame_samples) {
+		finish("chunk of " + std::to_string(sample_count) + " samples exceeds the granted " +
+		       std::to_string(session_.max_frame_samples) + ".");
+		return false;
+	}
+
+	// --- Step 3: ASR processing ---
+	// a streamed chunk was decoded between its first slice and the end of its receive
+	const bool decoded = (streamed == true) ? (decode_stopped_ == false)
+	                                        : decode(asr_engine_, samples, sample_count);
+	if (streamed == true) {
+		logChunkLatency(frame, first_slice_time_, first_slot_time_, last_input_time_);
+	} else {
+		logChunkLatency(frame, last_input_time_, slot_granted_, std::chrono::steady_clock::now());
+	}
+	if (decoded == false) {
+		finish("stop requested while waiting to decode.");
+		return false;
+	}
+	if (shm_channel_ != nullptr) {
+		shm_channel_->releaseFloat();
+	}
+
+	// --- Step 4: send result ---
+	// a client that stopped reading must not pin this worker either
+	retval = client_->sendString(asr_engine_.GetCurrentText(),
+	                             std::chrono::steady_clock::now() + kCLIENT_IDLE_TIMEOUT_);
+	if (retval != arcforge::embedded::network_socket::SocketReturnValue::ksuccess) {
+		finish("failed to send a result: " +
+		       arcforge::embedded::network_socket::SocketReturnValueToString(retval));
+		return false;
+	}
+
+	// --- Step 5: Reset ASR stream ---
+	asr_engine_.ResetStream();
+	return true;
+}
 
-			retval = client_->sendString(recognized_text);
+// one frame of a multiplexed connection: each stream id gets its own recognizer, all of
+// them driven from this session's steps
+bool ASRTaskSherpa::stepMultiplexed() {
+	arcforge::embedded::network_socket::SocketReturnValue retval = client_->receiveStreamFrame(
+	    stream_frame_, std::chrono::steady_clock::now() + kFRAME_DEADLINE_);
+
+	if (retval == arcforge::embedded::network_socket::SocketReturnValue::kio_timeout) {
+		return true;
+	}
+	if (retval == arcforge::embedded::network_socket::SocketReturnValue::keof) {
+		// one session ended, the others go on
+		mux_sessions_.erase(stream_frame_.stream);
+		last_input_time_ = std::chrono::steady_clock::now();
+		arcforge::embedded::utils::Logger::GetInstance().Info(
+		    "Stream " + std::to_string(stream_frame_.stream) + " ended.", kcurrent_app_name);
+		if (mux_sessions_.empty()) {
+			finish("All multiplexed sessions ended.");
+			return false;
 		}
+		return true;
+	}
+	if (retval != arcforge::embedded::network_socket::SocketReturnValue::ksuccess) {
+		finish(arcforge::embedded::network_socket::SocketReturnValueToString(retval));
+		return false;
+	}
+	last_input_time_ = std::chrono::steady_clock::now();
+	if (stream_frame_.kind != arcforge::embedded::network_socket::StreamFrameKind::ksamples) {
+		// results only flow towards the client
+		return true;
+	}
+	if (session_.max_frame_samples != 0 && stream_frame_.count > session_.max_frame_samples) {
+		finish("chunk exceeds the granted frame size.");
+		return false;
+	}
 
-		// if send failed, exit the loop
-		if (retval != arcforge::embedded::network_socket::SocketReturnValue::ksuccess) {
-			arcforge::embedded::utils::Logger::GetInstance().Error(
-			    "Failed to send string data, exiting worker thread.");
+	auto session = mux_sessions_.find(stream_frame_.stream);
+	if (session == mux_sessions_.end()) {
+		if (mux_sessions_.size() >= session_.params.max_streams) {
+			arcforge::embedded::utils::Logger::GetInstance().Warning(
+			    "Stream " + std::to_string(stream_frame_.stream) +
+			        " is over the granted session count, chunk dropped.",
+			    kcurrent_app_name);
+			return true;
+		}
+		auto recognizer =
+		    std::make_unique<arcforge::embedded::ai_asr::RecognizerStream>(takeStream());
+		if (recognizer->IsValid() == false) {
+			finish("recognizer for a new stream failed to initialize.");
+			return false;
+		}
+		session = mux_sessions_.emplace(stream_frame_.stream, std::move(recognizer)).first;
+	}
+
+	// widen compact encodings, float frames are used in place
+	const float* samples = reinterpret_cast<const float*>(stream_frame_.payload.data());
+	switch (stream_frame_.encoding) {
+		case arcforge::embedded::network_socket::SampleEncoding::kpcm16:
+			audio_chunk_.resize(stream_frame_.count);
+			arcforge::embedded::network_socket::ConvertPcm16ToFloat(
+			    reinterpret_cast<const int16_t*>(stream_frame_.payload.data()),
+			    audio_chunk_.data(), stream_frame_.count);
+			samples = audio_chunk_.data();
+			break;
+		case arcforge::embedded::network_socket::SampleEncoding::kmulaw:
+			audio_chunk_.resize(stream_frame_.count);
+			arcforge::embedded::network_socket::ConvertMulawToFloat(
+			    reinterpret_cast<const uint8_t*>(stream_frame_.payload.data()),
+			    audio_chunk_.data(), stream_frame_.count);
+			samples = audio_chunk_.data();
+			break;
+		case arcforge::embedded::network_socket::SampleEncoding::kfloat32:
+		default:
+			break;
+	}
+
+	if (decode(*session->second, samples, stream_frame_.count) == false) {
+		finish("stop requested.");
+		return false;
+	}
+	retval = client_->sendStreamString(stream_frame_.stream, session->second->GetCurrentText(),
+	                                   std::chrono::steady_clock::now() + kCLIENT_IDLE_TIMEOUT_);
+	if (retval != arcforge::embedded::network_socket::SocketReturnValue::ksuccess) {
+		finish("failed to send a result.");
+		return false;
+	}
+	session->second->ResetStream();
+	return true;
+}
+
+// audio and results decoupled: the step takes every chunk that has arrived, decodes them
+// in one go and pushes a partial after the batch, a final at every endpoint and at the end
+// of each utterance. The client never waits a round trip per chunk.
+bool ASRTaskSherpa::stepPushed() {
+	do {
+		if (receivePushed() == false) {
+			pushed_receive_done_ = true;
 			break;
 		}
+	} while (stop_flag_ == false && inputReady() == true);
+	return decodePushed();
+}
 
-		// --- Step 5: Reset ASR stream (no locking needed) ---
-		asr_engine_.ResetStream();
+// queues one chunk (or the end-of-utterance marker); false once the client is done sending,
+// with the reason in pushed_receive_reason_
+bool ASRTaskSherpa::receivePushed() {
+	arcforge::embedded::network_socket::SocketReturnValue retval;
+	const float* samples = nullptr;
+	size_t sample_count = 0;
+	if (shm_channel_ != nullptr) {
+		retval = shm_channel_->peekFloat(samples, sample_count);
+	} else {
+		const auto deadline = std::chrono::steady_clock::now() + kFRAME_DEADLINE_;
+		switch (sample_encoding_) {
+			case arcforge::embedded::network_socket::SampleEncoding::kpcm16:
+				retval = client_->receivePcm16(pcm16_chunk_, deadline);
+				break;
+			case arcforge::embedded::network_socket::SampleEncoding::kmulaw:
+				retval = client_->receiveMulaw(mulaw_chunk_, deadline);
+				break;
+			case arcforge::embedded::network_socket::SampleEncoding::kfloat32:
+			default:
+				retval = client_->receiveFloat(audio_chunk_, deadline);
+				break;
+		}
 	}
 
-	// universal cleanup after loop exit
-	finished_flag_ = true;
-	arcforge::embedded::utils::Logger::GetInstance().Info(
-	    "ASRTaskSherpa run loop finished, worker thread is now exiting.");
+	// the client offered a shared-memory ring instead of its first chunk
+	if (retval == arcforge::embedded::network_socket::SocketReturnValue::kreceived_fds &&
+	    shm_channel_ == nullptr) {
+		std::unique_ptr<arcforge::embedded::network_socket::ShmChannel> channel;
+		retval = arcforge::embedded::network_socket::ShmChannel::accept(*client_, channel);
+		if (retval == arcforge::embedded::network_socket::SocketReturnValue::ksuccess) {
+			arcforge::embedded::utils::Logger::GetInstance().Info(
+			    "Client switched audio to shared-memory ring.", kcurrent_app_name);
+			std::lock_guard<std::mutex> shm_lock(shm_mutex_);
+			shm_channel_ = std::move(channel);
+			return true;
+		}
+	}
+
+	if (retval == arcforge::embedded::network_socket::SocketReturnValue::kio_timeout) {
+		return true;
+	}
+	if (retval == arcforge::embedded::network_socket::SocketReturnValue::keof) {
+		// the utterance ends; on the socket the session stays open for the next one, the
+		// ring is closed for good
+		PushedChunk end_of_utterance;
+		end_of_utterance.end_of_utterance = true;
+		pushed_chunks_.push(std::move(end_of_utterance));
+		last_input_time_ = std::chrono::steady_clock::now();
+		utterance_open_ = false;
+		if (shm_channel_ != nullptr) {
+			pushed_receive_reason_ = "Client closed connection gracefully (EOF).";
+			return false;
+		}
+		return true;
+	}
+	// a client that got its end-of-utterance final simply hangs up
+	if (retval == arcforge::embedded::network_socket::SocketReturnValue::kpeer_abnormally_closed &&
+	    utterance_open_ == false) {
+		pushed_receive_reason_ = "Client closed connection after its last utterance.";
+		return false;
+	}
+	if (retval != arcforge::embedded::network_socket::SocketReturnValue::ksuccess) {
+		pushed_receive_reason_ =
+		    arcforge::embedded::network_socket::SocketReturnValueToString(retval);
+		return false;
+	}
+	last_input_time_ = std::chrono::steady_clock::now();
+	utterance_open_ = true;
+
+	if (shm_channel_ == nullptr) {
+		switch (sample_encoding_) {
+			case arcforge::embedded::network_socket::SampleEncoding::kpcm16:
+				sample_count = pcm16_chunk_.size();
+				break;
+			case arcforge::embedded::network_socket::SampleEncoding::kmulaw:
+				sample_count = mulaw_chunk_.size();
+				break;
+			case arcforge::embedded::network_socket::SampleEncoding::kfloat32:
+			default:
+				samples = audio_chunk_.data();
+				sample_count = audio_chunk_.size();
+				break;
+		}
+	}
+	if (session_.max_frame_samples != 0 && sample_count > session_.max_frame_samples) {
+		pushed_receive_reason_ = "chunk of " + std::to_string(sample_count) +
+		                         " samples exceeds the granted " +
+		                         std::to_string(session_.max_frame_samples) + ".";
+		return false;
+	}
+
+	PushedChunk chunk;
+	chunk.dequeued = last_input_time_;
+	if (shm_channel_ == nullptr) {
+		chunk.frame = client_->getLastFrameInfo();
+	}
+	if (pushed_spare_.empty() == false) {
+		chunk.samples = std::move(pushed_spare_.back());
+		pushed_spare_.pop_back();
+	}
+	// compact wire formats are widened straight into the queued chunk
+	chunk.samples.resize(sample_count);
+	if (shm_channel_ == nullptr &&
+	    sample_encoding_ == arcforge::embedded::network_socket::SampleEncoding::kpcm16) {
+		arcforge::embedded::network_socket::ConvertPcm16ToFloat(
+		    pcm16_chunk_.data(), chunk.samples.data(), sample_count);
+	} else if (shm_channel_ == nullptr &&
+	           sample_encoding_ == arcforge::embedded::network_socket::SampleEncoding::kmulaw) {
+		arcforge::embedded::network_socket::ConvertMulawToFloat(
+		    mulaw_chunk_.data(), chunk.samples.data(), sample_count);
+	} else {
+		std::copy(samples, samples + sample_count, chunk.samples.begin());
+	}
+	if (shm_channel_ != nullptr) {
+		shm_channel_->releaseFloat();
+	}
+	pushed_chunks_.push(std::move(chunk));
+	return true;
+}
+
+// decodes the queued chunks and pushes their results; false once the session is over
+bool ASRTaskSherpa::decodePushed() {
+	auto push_result = [this](arcforge::embedded::network_socket::ResultKind kind,
+	                          std::string text) {
+		arcforge::embedded::network_socket::ResultMessage result;
+		result.kind = kind;
+		result.acknowledged_chunks = pushed_consumed_;
+		result.text = std::move(text);
+		pushed_consumed_ = 0;
+		// a client that stopped reading must not pin this worker either
+		return client_->sendResult(result,
+		                           std::chrono::steady_clock::now() + kCLIENT_IDLE_TIMEOUT_);
+	};
+
+	arcforge::embedded::network_socket::SocketReturnValue retval =
+	    arcforge::embedded::network_socket::SocketReturnValue::ksuccess;
+	bool decoded = true;
+	for (; pushed_chunks_.empty() == false; pushed_chunks_.pop()) {
+		PushedChunk& chunk = pushed_chunks_.front();
+		if (chunk.end_of_utterance == true) {
+			asr_engine_.InputFinished();
+			retval = push_result(arcforge::embedded::network_socket::ResultKind::kend_of_utterance,
+			                     asr_engine_.GetCurrentText());
+			// a stream whose input has finished takes no more audio, Reset() does not undo
+			// that: the next utterance of the session gets a fresh one
+			asr_engine_ = takeStream();
+			if (asr_engine_.IsValid() == false) {
+				finish("recognizer for the next utterance failed to initialize.");
+				return false;
+			}
+		} else {
+			if (throttled() == true) {
+				// the rest is decoded by the step at resumeAt()
+				break;
+			}
+			if (decode(asr_engine_, chunk.samples.data(), chunk.samples.size()) == false) {
+				decoded = false;
+				break;
+			}
+			logChunkLatency(chunk.frame, chunk.dequeued, slot_granted_,
+			                std::chrono::steady_clock::now());
+			++pushed_consumed_;
+			if (asr_engine_.IsEndpoint() == true) {
+				retval = push_result(arcforge::embedded::network_socket::ResultKind::kfinal,
+				                     asr_engine_.GetCurrentText());
+				asr_engine_.ResetStream();
+			}
+			pushed_spare_.push_back(std::move(chunk.samples));
+		}
+		if (retval != arcforge::embedded::network_socket::SocketReturnValue::ksuccess) {
+			break;
+		}
+	}
+	if (retval == arcforge::embedded::network_socket::SocketReturnValue::ksuccess &&
+	    decoded == true && pushed_consumed_ > 0) {
+		retval = push_result(arcforge::embedded::network_socket::ResultKind::kpartial,
+		                     asr_engine_.GetCurrentText());
+	}
+
+	if (retval != arcforge::embedded::network_socket::SocketReturnValue::ksuccess) {
+		finish("failed to push a result: " +
+		       arcforge::embedded::network_socket::SocketReturnValueToString(retval));
+		return false;
+	}
+	if (decoded == false) {
+		finish("stop requested.");
+		return false;
+	}
+	if (pushed_receive_done_ == true && pushed_chunks_.empty() == true) {
+		finish(pushed_receive_reason_);
+		return false;
+	}
+	return true;
 }
 
 // stop_me() final thread-safe version
 void ASRTaskSherpa::stop_me() {
 	stop_flag_ = true;
-	std::lock_guard<std::mutex> lock(client_mutex_);
+	// a decode waiting for its turn gives up
+	if (scheduler_) {
+		scheduler_->interrupt();
+	}
+	{
+		// a reader parked on the shm ring does not notice the socket being cancelled below
+		std::lock_guard<std::mutex> shm_lock(shm_mutex_);
+		if (shm_channel_) {
+			shm_channel_->close();
+		}
+	}
+	// a receive or send blocked on the socket returns kcancelled right away, so the running
+	// step ends; the connection is closed with the task once no step runs any more
 	if (client_) {
-		client_.reset();
+		client_->cancel();
 	}
 }
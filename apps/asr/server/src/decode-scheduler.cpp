@@ -0,0 +1,187 @@
+// Copyright (c) 2025 PotterWhite
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "decode-scheduler.h"
+
+DecodeScheduler::DecodeScheduler(size_t decode_slots, double audio_seconds_per_second,
+                                 double burst_seconds)
+    : decode_slots_(std::max<size_t>(decode_slots, 1)),
+      audio_seconds_per_second_(audio_seconds_per_second),
+      burst_seconds_(burst_seconds) {}
+
+bool DecodeScheduler::acquire(ClientKey client, double audio_seconds,
+                              const std::atomic<bool>& stop) {
+	std::unique_lock<std::mutex> lock(mutex_);
+
+	auto inserted = clients_.try_emplace(client);
+	ClientState& state = inserted.first->second;
+	if (inserted.second == true) {
+		state.tokens = burst_seconds_;
+		state.refilled = std::chrono::steady_clock::now();
+	}
+	if (state.waiting == 0 && state.decoding == 0) {
+		// back from idle: at most one burst behind the clients being served now, so a short
+		// gap between chunks keeps its share but long absence is not saved up as a head start
+		state.served_seconds =
+		    std::max(state.served_seconds, minActiveServedLocked() - burst_seconds_);
+	}
+	const uint64_t ticket = next_ticket_++;
+	waiters_.push_back({ticket, client});
+	++state.waiting;
+
+	while (true) {
+		if (stop == true) {
+			removeWaiterLocked(ticket);
+			--state.waiting;
+			cv_.notify_all();
+			return false;
+		}
+
+		const Waiter* next = pickNextLocked();
+		if (next != nullptr && next->ticket == ticket && decoding_ < decode_slots_) {
+			removeWaiterLocked(ticket);
+			--state.waiting;
+			++state.decoding;
+			++decoding_;
+			// may run the bucket into debt, quotaDelay() has the client pay it back
+			refillLocked(state, std::chrono::steady_clock::now());
+			state.tokens -= audio_seconds;
+			state.served_seconds += audio_seconds;
+			// a slot may be left for the next one in line
+			cv_.notify_all();
+			return true;
+		}
+
+		cv_.wait(lock);
+	}
+}
+
+std::chrono::steady_clock::duration DecodeScheduler::quotaDelay(ClientKey client,
+                                                                double audio_seconds) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	auto it = clients_.find(client);
+	if (it == clients_.end()) {
+		// a new client starts with a full bucket
+		return std::chrono::steady_clock::duration::zero();
+	}
+	ClientState& state = it->second;
+	refillLocked(state, std::chrono::steady_clock::now());
+	// capped at the burst so that a chunk longer than the burst still gets through
+	const double tokens_needed = std::min(audio_seconds, burst_seconds_);
+	if (state.tokens >= tokens_needed) {
+		return std::chrono::steady_clock::duration::zero();
+	}
+	const auto refill =
+	    std::chrono::duration<double>((tokens_needed - state.tokens) / audio_seconds_per_second_);
+	return std::chrono::duration_cast<std::chrono::microseconds>(refill) +
+	       std::chrono::microseconds(1);
+}
+
+void DecodeScheduler::release(ClientKey client, double audio_seconds,
+                               std::chrono::steady_clock::duration decode_time) {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto it = clients_.find(client);
+		if (it != clients_.end() && it->second.decoding > 0) {
+			--it->second.decoding;
+			--decoding_;
+		}
+		if (audio_seconds > 0.0) {
+			const double sample =
+			    std::chrono::duration<double>(decode_time).count() / audio_seconds;
+			if (real_time_factor_ == 0.0) {
+				real_time_factor_ = sample;
+			} else {
+				real_time_factor_ += kRTF_SMOOTHING_ * (sample - real_time_factor_);
+			}
+		}
+	}
+	cv_.notify_all();
+}
+
+void DecodeScheduler::removeClient(ClientKey client) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	auto it = clients_.find(client);
+	// coming back later it starts again at most one burst behind the active clients, as
+	// after any idle period
+	if (it != clients_.end() && it->second.waiting == 0 && it->second.decoding == 0) {
+		clients_.erase(it);
+	}
+}
+
+size_t DecodeScheduler::clientCount() {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return clients_.size();
+}
+
+double DecodeScheduler::realTimeFactor() {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return real_time_factor_;
+}
+
+void DecodeScheduler::interrupt() {
+	{
+		// taken so that a waiter between its stop check and its wait cannot miss this
+		std::lock_guard<std::mutex> lock(mutex_);
+	}
+	cv_.notify_all();
+}
+
+void DecodeScheduler::refillLocked(ClientState& state,
+                                   std::chrono::steady_clock::time_point now) const {
+	const double elapsed = std::chrono::duration<double>(now - state.refilled).count();
+	state.tokens = std::min(burst_seconds_, state.tokens + elapsed * audio_seconds_per_second_);
+	state.refilled = now;
+}
+
+// the waiter whose client has been served least, oldest first
+const DecodeScheduler::Waiter* DecodeScheduler::pickNextLocked() {
+	const Waiter* next = nullptr;
+	double next_served = 0.0;
+	for (const Waiter& waiter : waiters_) {
+		const ClientState& state = clients_[waiter.client];
+		if (next == nullptr || state.served_seconds < next_served ||
+		    (state.served_seconds == next_served && waiter.ticket < next->ticket)) {
+			next = &waiter;
+			next_served = state.served_seconds;
+		}
+	}
+	return next;
+}
+
+double DecodeScheduler::minActiveServedLocked() const {
+	double served = 0.0;
+	bool found = false;
+	for (const auto& [client, state] : clients_) {
+		if (state.waiting == 0 && state.decoding == 0) {
+			continue;
+		}
+		if (found == false || state.served_seconds < served) {
+			served = state.served_seconds;
+			found = true;
+		}
+	}
+	return served;
+}
+
+void DecodeScheduler::removeWaiterLocked(uint64_t ticket) {
+	auto same_ticket = [ticket](const Waiter& waiter) { return waiter.ticket == ticket; };
+	waiters_.erase(std::remove_if(waiters_.begin(), waiters_.end(), same_ticket), waiters_.end());
+}
@@ -27,9 +27,15 @@
 #include "common-types.h"
 
 static std::atomic<bool> g_stop_signal_received(false);
+// woken by the signal handler, so process() returns without waiting out its event-loop timeout
+static std::atomic<arcforge::embedded::network_socket::EventLoop*> g_event_loop(nullptr);
 
 void SignalHandler(int signal_num) {
 	g_stop_signal_received = true;
+	arcforge::embedded::network_socket::EventLoop* loop = g_event_loop;
+	if (loop != nullptr) {
+		loop->wakeup();
+	}
 
 	std::ostringstream oss;
 	oss << "\nInterrupt signal (" << signal_num << ") received. Shutting down...";
@@ -78,8 +84,57 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[]) {
 
 	// socket path initialize
 	auto server = std::make_unique<arcforge::embedded::network_socket::ServerBase>();
+	g_event_loop = &server->getEventLoop();
 	auto acceptor = Acceptor::Create(std::move(server));
 	acceptor->setSocketPath(ksocket_path);
+	for (int i = 1; i + 1 < argc; ++i) {
+		// --tcp [host:]port, without a host every local IPv4/IPv6 address is served
+		if (std::string(argv[i]) == "--tcp") {
+			const std::string endpoint = argv[++i];
+			const size_t colon = endpoint.rfind(':');
+			std::string host = (colon == std::string::npos) ? "" : endpoint.substr(0, colon);
+			if (host.size() >= 2 && host.front() == '[' && host.back() == ']') {
+				host = host.substr(1, host.size() - 2);
+			}
+			const size_t port_at = (colon == std::string::npos) ? 0 : colon + 1;
+			acceptor->setTcpEndpoint(host, static_cast<uint16_t>(std::atoi(&endpoint[port_at])));
+		}
+		// --workers N: threads the session steps run on, by default one per core
+		if (std::string(argv[i]) == "--workers") {
+			acceptor->setWorkerCount(static_cast<size_t>(std::max(std::atoi(argv[++i]), 1)));
+		}
+		// --max-sessions N: sessions open at once, further connections wait in the queue
+		if (std::string(argv[i]) == "--max-sessions") {
+			acceptor->setMaxSessions(static_cast<size_t>(std::max(std::atoi(argv[++i]), 1)));
+		}
+		// --backlog N: connections the kernel holds ready ahead of accept()
+		if (std::string(argv[i]) == "--backlog") {
+			acceptor->setListenBacklog(std::atoi(argv[++i]));
+		}
+		// --sessions-per-client N: sessions one client process may run at once
+		if (std::string(argv[i]) == "--sessions-per-client") {
+			acceptor->setSessionsPerClient(
+			    static_cast<size_t>(std::max(std::atoi(argv[++i]), 1)));
+		}
+		// --warmup N: rounds of synthetic audio decoded at startup, 0 to skip
+		if (std::string(argv[i]) == "--warmup") {
+			acceptor->setWarmupPasses(std::atoi(argv[++i]));
+		}
+		// --stream-pool N: decoder streams kept ready for new sessions
+		if (std::string(argv[i]) == "--stream-pool") {
+			acceptor->setStreamPoolSize(static_cast<size_t>(std::max(std::atoi(argv[++i]), 0)));
+		}
+		// --cpus 4,5,6,7: pin the workers round-robin to these cpus
+		if (std::string(argv[i]) == "--cpus") {
+			std::istringstream cpu_list(argv[++i]);
+			std::vector<int> cpus;
+			std::string cpu;
+			while (std::getline(cpu_list, cpu, ',')) {
+				cpus.push_back(std::atoi(cpu.c_str()));
+			}
+			acceptor->setWorkerCpus(cpus);
+		}
+	}
 	acceptor->init();
 
 	while (1) {
@@ -93,6 +148,7 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[]) {
 			acceptor->process();
 		}
 	}
+	g_event_loop = nullptr;
 	// recognizer will be cleaned up automatically when main ends
 
 	std::stringstream ss;
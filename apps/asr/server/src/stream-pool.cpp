@@ -0,0 +1,57 @@
+// Copyright (c) 2025 PotterWhite
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "stream-pool.h"
+
+StreamPool::StreamPool(std::shared_ptr<const arcforge::embedded::ai_asr::RecognizerModel> model,
+                       size_t target)
+    : model_(std::move(model)), target_(target) {
+	ready_.reserve(target_);
+}
+
+arcforge::embedded::ai_asr::RecognizerStream StreamPool::take() {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (ready_.empty() == false) {
+			arcforge::embedded::ai_asr::RecognizerStream stream = std::move(ready_.back());
+			ready_.pop_back();
+			return stream;
+		}
+	}
+	return arcforge::embedded::ai_asr::RecognizerStream(model_);
+}
+
+void StreamPool::refill() {
+	while (true) {
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			if (ready_.size() >= target_) {
+				return;
+			}
+		}
+		// created unlocked, a session taking a stream meanwhile is not held up by it
+		arcforge::embedded::ai_asr::RecognizerStream stream(model_);
+		if (stream.IsValid() == false) {
+			return;
+		}
+		std::lock_guard<std::mutex> lock(mutex_);
+		ready_.push_back(std::move(stream));
+	}
+}
@@ -0,0 +1,100 @@
+// Copyright (c) 2025 PotterWhite
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "worker-pool.h"
+#include "Utils/logger/logger.h"
+#include "common-types.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+WorkerPool::WorkerPool(size_t workers, const std::vector<int>& cpus,
+                       std::function<void()> job_done)
+    : job_done_(std::move(job_done)) {
+	workers = std::max<size_t>(workers, 1);
+	workers_.reserve(workers);
+	for (size_t i = 0; i < workers; ++i) {
+		workers_.emplace_back(&WorkerPool::workerLoop, this);
+		if (cpus.empty() == true) {
+			continue;
+		}
+		// best effort: an offline or out-of-range cpu only costs the pinning
+		const int cpu = cpus[i % cpus.size()];
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		if (cpu >= 0 && cpu < CPU_SETSIZE) {
+			CPU_SET(static_cast<size_t>(cpu), &set);
+		}
+		if (CPU_COUNT(&set) == 0 ||
+		    pthread_setaffinity_np(workers_.back().native_handle(), sizeof(set), &set) != 0) {
+			arcforge::embedded::utils::Logger::GetInstance().Warning(
+			    "Could not pin worker " + std::to_string(i) + " to cpu " + std::to_string(cpu) +
+			        ".",
+			    kcurrent_app_name);
+		}
+	}
+}
+
+WorkerPool::~WorkerPool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stopping_ = true;
+	}
+	cv_.notify_all();
+	for (auto& worker : workers_) {
+		if (worker.joinable() == true) {
+			worker.join();
+		}
+	}
+}
+
+std::future<void> WorkerPool::submit(std::function<void()> job) {
+	std::packaged_task<void()> task(std::move(job));
+	std::future<void> done = task.get_future();
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		jobs_.push(std::move(task));
+	}
+	cv_.notify_one();
+	return done;
+}
+
+size_t WorkerPool::size() const {
+	return workers_.size();
+}
+
+void WorkerPool::workerLoop() {
+	while (true) {
+		std::packaged_task<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			cv_.wait(lock, [this]() { return stopping_ == true || jobs_.empty() == false; });
+			if (stopping_ == true) {
+				return;
+			}
+			task = std::move(jobs_.front());
+			jobs_.pop();
+		}
+		task();
+		if (job_done_) {
+			job_done_();
+		}
+	}
+}
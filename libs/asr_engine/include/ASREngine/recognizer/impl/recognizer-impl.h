@@ -29,13 +29,8 @@
 // #include <vector>
 
 #include "ASREngine/recognizer/recognizer-config.h"
-
-namespace sherpa_onnx {
-namespace cxx {
-class OnlineRecognizer;
-class OnlineStream;
-}  // namespace cxx
-}  // namespace sherpa_onnx
+#include "ASREngine/recognizer/recognizer-model.h"
+#include "ASREngine/recognizer/recognizer-stream.h"
 
 namespace arcforge {
 namespace embedded {
@@ -48,6 +43,8 @@ class RecognizerImpl {
 
 	bool Initialize(const SherpaConfig& user_config);
 	void ProcessAudioChunk(const std::vector<float>& audio_chunk);
+	void ProcessAudioChunk(const float* samples, size_t count);
+	void ProcessAudioChunk(const float* samples, size_t count, int sample_rate);
 	void InputFinished();
 	std::string GetCurrentText();
 	bool IsEndpoint() const;
@@ -61,13 +58,11 @@ class RecognizerImpl {
 	RecognizerImpl& operator=(RecognizerImpl&&) noexcept;
 
    private:
-	// PIMPL for Sherpa-ONNX types, even within Impl's header for maximum cleanliness if needed
-	// For unique_ptr members, we'll need to include their headers in .cpp
-	std::unique_ptr<sherpa_onnx::cxx::OnlineRecognizer> recognizer_ptr_;
-	std::unique_ptr<sherpa_onnx::cxx::OnlineStream> stream_ptr_;
+	// a Recognizer is a model it owns alone plus the one stream decoding on it
+	std::shared_ptr<RecognizerModel> model_;
+	std::unique_ptr<RecognizerStream> stream_;
 
 	std::string last_displayed_text_;
-	int expected_sample_rate_ = 16000;
 };
 
 }  // namespace ai_asr
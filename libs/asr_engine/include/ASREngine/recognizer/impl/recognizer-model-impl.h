@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2025 PotterWhite
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// libs/asr_engine/include/ASREngine/recognizer/impl/recognizer-model-impl.h
+#pragma once
+
+#include "ASREngine/pch.h"
+#include "ASREngine/recognizer/recognizer-config.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+namespace sherpa_onnx {
+namespace cxx {
+class OnlineRecognizer;
+class OnlineStream;
+}  // namespace cxx
+}  // namespace sherpa_onnx
+
+namespace arcforge {
+namespace embedded {
+namespace ai_asr {
+
+class RecognizerModelImpl {
+   public:
+	RecognizerModelImpl();
+	~RecognizerModelImpl();
+
+	bool Initialize(const SherpaConfig& user_config);
+	// nullptr when sherpa could not create the stream
+	std::unique_ptr<sherpa_onnx::cxx::OnlineStream> CreateStream() const;
+	// runs the decoder until stream has no complete frame left; with batching enabled the
+	// stream is decoded together with the other streams that are ready at about the same time
+	void DecodeReady(const sherpa_onnx::cxx::OnlineStream& stream) const;
+	std::string GetText(const sherpa_onnx::cxx::OnlineStream& stream) const;
+	bool IsEndpoint(const sherpa_onnx::cxx::OnlineStream& stream) const;
+	void Reset(const sherpa_onnx::cxx::OnlineStream& stream) const;
+	int GetExpectedSampleRate() const;
+	bool WarmUp(int passes, int audio_ms) const;
+
+	RecognizerModelImpl(const RecognizerModelImpl&) = delete;
+	RecognizerModelImpl& operator=(const RecognizerModelImpl&) = delete;
+
+   private:
+	// streams that joined one batch; the first to join collects and decodes it
+	struct DecodeBatch {
+		std::vector<const sherpa_onnx::cxx::OnlineStream*> streams;
+		bool done = false;
+	};
+	void decodeBatch(const sherpa_onnx::cxx::OnlineStream* const* streams, size_t count) const;
+
+	std::unique_ptr<sherpa_onnx::cxx::OnlineRecognizer> recognizer_ptr_;
+	int expected_sample_rate_ = 16000;
+
+	// the rknn runtime is not re-entrant across contexts of one model, so decodes on that
+	// provider take turns; cpu/cuda decode different streams concurrently
+	bool serialize_decodes_ = false;
+	mutable std::mutex decode_mutex_;
+
+	// see SherpaConfig::getThirteenthMaxBatchSize()
+	size_t max_batch_size_ = 1;
+	std::chrono::milliseconds max_batch_wait_{0};
+	mutable std::mutex batch_mutex_;
+	mutable std::condition_variable batch_cv_;
+	// the batch still taking streams, nullptr when none is being collected
+	mutable std::shared_ptr<DecodeBatch> open_batch_;
+	// DecodeReady() callers in a batch that is collecting or decoding
+	mutable size_t in_flight_ = 0;
+};
+
+}  // namespace ai_asr
+}  // namespace embedded
+}  // namespace arcforge
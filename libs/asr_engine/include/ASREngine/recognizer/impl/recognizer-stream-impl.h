@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2025 PotterWhite
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// libs/asr_engine/include/ASREngine/recognizer/impl/recognizer-stream-impl.h
+#pragma once
+
+#include "ASREngine/pch.h"
+#include "ASREngine/recognizer/recognizer-model.h"
+
+namespace sherpa_onnx {
+namespace cxx {
+class OnlineStream;
+}  // namespace cxx
+}  // namespace sherpa_onnx
+
+namespace arcforge {
+namespace embedded {
+namespace ai_asr {
+
+class RecognizerModelImpl;
+
+class RecognizerStreamImpl {
+   public:
+	explicit RecognizerStreamImpl(std::shared_ptr<const RecognizerModel> model);
+	~RecognizerStreamImpl();
+
+	bool IsValid() const;
+	void ProcessAudioChunk(const float* samples, size_t count, int sample_rate);
+	void InputFinished();
+	std::string GetCurrentText() const;
+	bool IsEndpoint() const;
+	void ResetStream();
+	int GetExpectedSampleRate() const;
+
+	RecognizerStreamImpl(const RecognizerStreamImpl&) = delete;
+	RecognizerStreamImpl& operator=(const RecognizerStreamImpl&) = delete;
+
+   private:
+	const RecognizerModelImpl& model() const;
+
+	// keeps the weights alive for as long as this stream refers to them
+	std::shared_ptr<const RecognizerModel> model_;
+	std::unique_ptr<sherpa_onnx::cxx::OnlineStream> stream_ptr_;
+};
+
+}  // namespace ai_asr
+}  // namespace embedded
+}  // namespace arcforge
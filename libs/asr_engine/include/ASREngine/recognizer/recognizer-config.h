@@ -44,13 +44,16 @@ class SherpaConfig {
 	std::string tenth_decoding_method_;
 	SherpaDebug eleventh_debug_level_;
 	SherpaEndPointSupport twelfth_enable_endpoint_detection_;
+	int thirteenth_max_batch_size_;
+	int fourteenth_max_batch_wait_ms_;
 
 	// --- Private Constructor (Declaration only) ---
 	SherpaConfig(const std::string& enc_path, const std::string& dec_path,
 	             const std::string& join_path, const std::string& tok_path,
 	             const std::string& provider, int num_threads, float rule1, float rule2,
 	             float rule3, const std::string& dec_method, SherpaDebug debug,
-	             SherpaEndPointSupport endpoint_detection);
+	             SherpaEndPointSupport endpoint_detection, int max_batch_size,
+	             int max_batch_wait_ms);
 
    public:
 	// --- Public Getters (adjusted names) ---
@@ -68,6 +71,10 @@ class SherpaConfig {
 	SherpaEndPointSupport getTwelfthEndpointDetectionSupport() const {
 		return twelfth_enable_endpoint_detection_;
 	}
+	// streams of one model decoded together; 1 decodes every stream on its own
+	int getThirteenthMaxBatchSize() const { return thirteenth_max_batch_size_; }
+	// how long a ready stream waits for others to fill its batch
+	int getFourteenthMaxBatchWaitMs() const { return fourteenth_max_batch_wait_ms_; }
 
 	// --- Disable Copying and Assignment ---
 	SherpaConfig(const SherpaConfig&) = delete;
@@ -93,6 +100,8 @@ class SherpaConfig {
 		std::string b_tenth_decoding_method_;
 		SherpaDebug b_eleventh_debug_level_;
 		SherpaEndPointSupport b_twelfth_enable_endpoint_detection_;
+		int b_thirteenth_max_batch_size_;
+		int b_fourteenth_max_batch_wait_ms_;
 
 	   public:
 		// --- Builder Constructor (Declaration only) ---
@@ -111,6 +120,8 @@ class SherpaConfig {
 		Builder& setTenthDecodingMethod(const std::string& method);
 		Builder& setEleventhDebugLevel(SherpaDebug level);
 		Builder& setTwelfthEndpointDetectionSupport(SherpaEndPointSupport enable);
+		Builder& setThirteenthMaxBatchSize(int size);
+		Builder& setFourteenthMaxBatchWaitMs(int wait_ms);
 
 		// Helper to initialize builder from an existing config
 		Builder& fromConfig(const SherpaConfig& existingConfig);
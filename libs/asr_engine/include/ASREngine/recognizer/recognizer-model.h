@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2025 PotterWhite
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// libs/asr_engine/include/ASREngine/recognizer/recognizer-model.h
+#pragma once
+
+#include "ASREngine/common/common-types.h"
+#include "ASREngine/pch.h"
+#include "ASREngine/recognizer/recognizer-config.h"
+
+namespace arcforge {
+namespace embedded {
+namespace ai_asr {
+
+// forward declaration of the PIMPL implementation class
+class RecognizerModelImpl;
+
+/*
+ * @brief The loaded encoder/decoder/joiner weights. Loaded once and shared by every
+ *        RecognizerStream built from it; all members are safe to use from several threads.
+ */
+class RecognizerModel {
+   public:
+	/*
+	 * @brief Loads the model described by config.
+	 * @return nullptr when the model files could not be loaded.
+	 */
+	static std::shared_ptr<RecognizerModel> Create(const SherpaConfig& config);
+	~RecognizerModel();
+
+	int GetExpectedSampleRate() const;
+	/*
+	 * @brief Decodes passes rounds of audio_ms of synthetic audio through encoder, decoder and
+	 *        joiner, alone and, with batching enabled, as a full batch. The provider's lazy
+	 *        first-inference setup is paid here instead of in the first chunk of a session.
+	 * @return false when the model is not loaded.
+	 */
+	bool WarmUp(int passes, int audio_ms) const;
+
+	RecognizerModel(const RecognizerModel&) = delete;
+	RecognizerModel& operator=(const RecognizerModel&) = delete;
+	RecognizerModel(RecognizerModel&&) = delete;
+	RecognizerModel& operator=(RecognizerModel&&) = delete;
+
+   private:
+	RecognizerModel();
+
+	friend class RecognizerStreamImpl;
+	std::unique_ptr<RecognizerModelImpl> impl_;
+};
+
+}  // namespace ai_asr
+}  // namespace embedded
+}  // namespace arcforge
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2025 PotterWhite
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// libs/asr_engine/include/ASREngine/recognizer/recognizer-stream.h
+#pragma once
+
+#include "ASREngine/common/common-types.h"
+#include "ASREngine/pch.h"
+#include "ASREngine/recognizer/recognizer-model.h"
+
+namespace arcforge {
+namespace embedded {
+namespace ai_asr {
+
+// forward declaration of the PIMPL implementation class
+class RecognizerStreamImpl;
+
+/*
+ * @brief Per-utterance decoder state on top of a shared RecognizerModel. Cheap to create,
+ *        one per session; a single stream must only be used from one thread at a time.
+ */
+class RecognizerStream {
+   public:
+	explicit RecognizerStream(std::shared_ptr<const RecognizerModel> model);
+	~RecognizerStream();
+
+	// false when the model was null or sherpa could not create the stream
+	bool IsValid() const;
+	/*
+	 * @brief Synchronously processes a chunk of audio data.
+	 * @param audio_chunk A vector of floats representing the audio data.
+	 */
+	void ProcessAudioChunk(const std::vector<float>& audio_chunk);
+	/*
+	 * @brief Same as above for samples the caller keeps in its own (reused) storage.
+	 */
+	void ProcessAudioChunk(const float* samples, size_t count);
+	/*
+	 * @brief Same, for audio captured at another rate than GetExpectedSampleRate(); the
+	 *        samples are resampled on the way in.
+	 */
+	void ProcessAudioChunk(const float* samples, size_t count, int sample_rate);
+	void InputFinished();
+	std::string GetCurrentText() const;
+	bool IsEndpoint() const;
+	void ResetStream();
+	int GetExpectedSampleRate() const;
+
+	RecognizerStream(const RecognizerStream&) = delete;
+	RecognizerStream& operator=(const RecognizerStream&) = delete;
+	RecognizerStream(RecognizerStream&&) noexcept;
+	RecognizerStream& operator=(RecognizerStream&&) noexcept;
+
+   private:
+	std::unique_ptr<RecognizerStreamImpl> impl_;
+};
+
+}  // namespace ai_asr
+}  // namespace embedded
+}  // namespace arcforge
@@ -48,6 +48,15 @@ class Recognizer {
 	 * @param audio_chunk A vector of floats representing the audio data.
 	 */
 	void ProcessAudioChunk(const std::vector<float>& audio_chunk);
+	/*
+	 * @brief Same as above for samples the caller keeps in its own (reused) storage.
+	 */
+	void ProcessAudioChunk(const float* samples, size_t count);
+	/*
+	 * @brief Same, for audio captured at another rate than GetExpectedSampleRate(); the
+	 *        samples are resampled on the way in.
+	 */
+	void ProcessAudioChunk(const float* samples, size_t count, int sample_rate);
 	void InputFinished();
 	std::string GetCurrentText() const;
 	bool IsEndpoint() const;
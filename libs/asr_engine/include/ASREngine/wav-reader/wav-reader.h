@@ -38,6 +38,8 @@ class WavReader {
 	void Close();
 
 	size_t ReadSamples(std::vector<float>& out_samples, size_t num_samples_to_read);
+	// raw 16-bit samples of the first channel, for senders that keep the wire format compact
+	size_t ReadSamples(std::vector<int16_t>& out_samples, size_t num_samples_to_read);
 	bool IsOpened() const { return is_opened_; }
 	bool Eof() const { return eof_ || !wav_file_.is_open(); }
 
@@ -56,6 +58,7 @@ class WavReader {
 	std::streamoff data_chunk_pos_ = 0;
 	size_t data_chunk_size_ = 0;
 	size_t bytes_read_from_data_chunk_ = 0;
+	std::vector<int16_t> pcm16_scratch_;
 
 	bool ParseWavHeader(int expected_sample_rate, int expected_channels);
 };
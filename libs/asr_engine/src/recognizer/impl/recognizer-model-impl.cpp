@@ -0,0 +1,270 @@
+// Copyright (c) 2025 PotterWhite
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// libs/asr_engine/src/recognizer/impl/recognizer-model-impl.cpp
+#include "ASREngine/recognizer/impl/recognizer-model-impl.h"
+#include "Utils/logger/logger.h"
+
+#include "sherpa-onnx/c-api/cxx-api.h"
+
+namespace arcforge {
+namespace embedded {
+namespace ai_asr {
+
+using namespace sherpa_onnx::cxx;
+
+RecognizerModelImpl::RecognizerModelImpl() = default;
+
+RecognizerModelImpl::~RecognizerModelImpl() {
+	arcforge::embedded::utils::Logger::GetInstance().Info("RecognizerModelImpl cleaned up.",
+	                                                      kcurrent_lib_name);
+}
+
+bool RecognizerModelImpl::Initialize(const SherpaConfig& sherpa_config) {
+	OnlineRecognizerConfig config;
+
+	config.model_config.transducer.encoder = sherpa_config.getFirstEncoderPath();
+	config.model_config.transducer.decoder = sherpa_config.getSecondDecoderPath();
+	config.model_config.transducer.joiner = sherpa_config.getThirdJoinerPath();
+	config.model_config.tokens = sherpa_config.getFourthTokensPath();
+	config.model_config.provider = sherpa_config.getFifthProvider();
+	config.model_config.num_threads = sherpa_config.getSixthNumThreads();
+
+	if (sherpa_config.getEleventhDebugLevel() == SherpaDebug::ktrue) {
+		config.model_config.debug = true;
+	} else {
+		config.model_config.debug = false;
+	}
+
+	config.feat_config.sample_rate = expected_sample_rate_;
+
+	config.rule1_min_trailing_silence = sherpa_config.getSeventhRule1MinTrailingSilence();
+	config.rule2_min_trailing_silence = sherpa_config.getEighthRule2MinTrailingSilence();
+	config.rule3_min_utterance_length = sherpa_config.getNinthRule3MinUtteranceLength();
+	config.decoding_method = sherpa_config.getTenthDecodingMethod();
+	if (sherpa_config.getTwelfthEndpointDetectionSupport() == SherpaEndPointSupport::kenable) {
+		config.enable_endpoint = true;
+	} else {
+		config.enable_endpoint = false;
+	}
+
+	serialize_decodes_ = (sherpa_config.getFifthProvider() == "rknn");
+	max_batch_size_ = static_cast<size_t>(std::max(sherpa_config.getThirteenthMaxBatchSize(), 1));
+	max_batch_wait_ = std::chrono::milliseconds(sherpa_config.getFourteenthMaxBatchWaitMs());
+
+	std::ostringstream oss;
+	oss << "Loading Sherpa-ONNX model (Impl) with provider: " << sherpa_config.getFifthProvider()
+	    << ", max batch: " << max_batch_size_;
+	arcforge::embedded::utils::Logger::GetInstance().Info(oss.str(), kcurrent_lib_name);
+
+	try {
+		recognizer_ptr_ = std::make_unique<OnlineRecognizer>(OnlineRecognizer::Create(config));
+
+		if (recognizer_ptr_->Get() == nullptr) {
+			arcforge::embedded::utils::Logger::GetInstance().Error(
+			    "Failed to create OnlineRecognizer (internal pointer is null).", kcurrent_lib_name);
+
+			recognizer_ptr_.reset();
+
+			return false;
+		}
+	} catch (const std::exception& e) {
+		std::ostringstream oss_catch;
+		oss_catch << "Exception during RecognizerModelImpl::Initialize: " << e.what();
+		arcforge::embedded::utils::Logger::GetInstance().Error(oss_catch.str(), kcurrent_lib_name);
+
+		recognizer_ptr_.reset();
+		return false;
+	}
+
+	arcforge::embedded::utils::Logger::GetInstance().Info("Sherpa-ONNX model (Impl) loaded.",
+	                                                      kcurrent_lib_name);
+	return true;
+}
+
+std::unique_ptr<OnlineStream> RecognizerModelImpl::CreateStream() const {
+	if (!recognizer_ptr_) {
+		return nullptr;
+	}
+
+	try {
+		auto stream = std::make_unique<OnlineStream>(recognizer_ptr_->CreateStream());
+		if (stream->Get() == nullptr) {
+			arcforge::embedded::utils::Logger::GetInstance().Error(
+			    "Failed to create OnlineStream (internal pointer is null).", kcurrent_lib_name);
+			return nullptr;
+		}
+		return stream;
+	} catch (const std::exception& e) {
+		std::ostringstream oss;
+		oss << "Exception during RecognizerModelImpl::CreateStream: " << e.what();
+		arcforge::embedded::utils::Logger::GetInstance().Error(oss.str(), kcurrent_lib_name);
+		return nullptr;
+	}
+}
+
+void RecognizerModelImpl::DecodeReady(const OnlineStream& stream) const {
+	if (max_batch_size_ <= 1) {
+		const OnlineStream* single = &stream;
+		decodeBatch(&single, 1);
+		return;
+	}
+	// nothing to decode yet, so no reason to hold up a batch
+	if (recognizer_ptr_->IsReady(&stream) == false) {
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(batch_mutex_);
+	++in_flight_;
+	std::shared_ptr<DecodeBatch> batch = open_batch_;
+	const bool leader = (batch == nullptr);
+	if (leader) {
+		batch = std::make_shared<DecodeBatch>();
+		open_batch_ = batch;
+	}
+	batch->streams.push_back(&stream);
+
+	if (leader == false) {
+		if (batch->streams.size() >= max_batch_size_) {
+			batch_cv_.notify_all();
+		}
+		batch_cv_.wait(lock, [&batch]() { return batch->done; });
+		return;
+	}
+
+	// only a stream queued or decoding elsewhere can still join, a lone caller decodes at once
+	batch_cv_.wait_for(lock, max_batch_wait_, [this, &batch]() {
+		return batch->streams.size() >= max_batch_size_ || in_flight_ <= batch->streams.size();
+	});
+	// later streams start the next batch while this one decodes
+	open_batch_.reset();
+	lock.unlock();
+
+	decodeBatch(batch->streams.data(), batch->streams.size());
+
+	lock.lock();
+	batch->done = true;
+	in_flight_ -= batch->streams.size();
+	batch_cv_.notify_all();
+}
+
+void RecognizerModelImpl::decodeBatch(const OnlineStream* const* streams, size_t count) const {
+	std::unique_lock<std::mutex> lock(decode_mutex_, std::defer_lock);
+	if (serialize_decodes_) {
+		lock.lock();
+	}
+
+	if (count == 1) {
+		while (recognizer_ptr_->IsReady(streams[0])) {
+			recognizer_ptr_->Decode(streams[0]);
+		}
+		return;
+	}
+
+	// the C++ wrapper only batches a contiguous array of streams it owns, so the C call takes
+	// the handles of ours; streams drop out as their buffered frames run out
+	std::vector<const SherpaOnnxOnlineStream*> ready;
+	ready.reserve(count);
+	while (true) {
+		ready.clear();
+		for (size_t i = 0; i < count; ++i) {
+			if (recognizer_ptr_->IsReady(streams[i])) {
+				ready.push_back(streams[i]->Get());
+			}
+		}
+		if (ready.empty()) {
+			break;
+		}
+		SherpaOnnxDecodeMultipleOnlineStreams(recognizer_ptr_->Get(), ready.data(),
+		                                      static_cast<int32_t>(ready.size()));
+	}
+}
+
+std::string RecognizerModelImpl::GetText(const OnlineStream& stream) const {
+	return recognizer_ptr_->GetResult(&stream).text;
+}
+
+bool RecognizerModelImpl::IsEndpoint(const OnlineStream& stream) const {
+	return recognizer_ptr_->IsEndpoint(&stream);
+}
+
+void RecognizerModelImpl::Reset(const OnlineStream& stream) const {
+	recognizer_ptr_->Reset(&stream);
+}
+
+int RecognizerModelImpl::GetExpectedSampleRate() const {
+	return expected_sample_rate_;
+}
+
+bool RecognizerModelImpl::WarmUp(int passes, int audio_ms) const {
+	if (!recognizer_ptr_) {
+		return false;
+	}
+	const auto begin = std::chrono::steady_clock::now();
+
+	// faint noise rather than silence, so the features are not a constant the provider could
+	// take a shortcut on; fixed seed, the result is thrown away anyway
+	const size_t count = static_cast<size_t>(std::max(audio_ms, 1)) *
+	                     static_cast<size_t>(expected_sample_rate_) / 1000;
+	std::vector<float> noise(count);
+	uint32_t seed = 0x2545F491u;
+	for (float& sample : noise) {
+		seed = seed * 1664525u + 1013904223u;
+		sample = (static_cast<float>(seed >> 8) / static_cast<float>(1u << 24) - 0.5f) * 0.02f;
+	}
+
+	// one stream alone takes the single-stream path, a full batch the batched one; both may
+	// have first-run costs of their own (graph setup per input shape)
+	std::vector<size_t> rounds{1};
+	if (max_batch_size_ > 1) {
+		rounds.push_back(max_batch_size_);
+	}
+	for (int pass = 0; pass < passes; ++pass) {
+		for (size_t batch : rounds) {
+			std::vector<std::unique_ptr<OnlineStream>> streams;
+			std::vector<const OnlineStream*> handles;
+			for (size_t i = 0; i < batch; ++i) {
+				std::unique_ptr<OnlineStream> stream = CreateStream();
+				if (stream == nullptr) {
+					return false;
+				}
+				stream->AcceptWaveform(expected_sample_rate_, noise.data(),
+				                       static_cast<int32_t>(noise.size()));
+				stream->InputFinished();
+				handles.push_back(stream.get());
+				streams.push_back(std::move(stream));
+			}
+			decodeBatch(handles.data(), handles.size());
+		}
+	}
+
+	const auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+	                            std::chrono::steady_clock::now() - begin)
+	                            .count();
+	arcforge::embedded::utils::Logger::GetInstance().Info(
+	    "Model warmed up with " + std::to_string(passes) + " pass(es) of " +
+	        std::to_string(audio_ms) + " ms in " + std::to_string(elapsed_ms) + " ms.",
+	    kcurrent_lib_name);
+	return true;
+}
+
+}  // namespace ai_asr
+}  // namespace embedded
+}  // namespace arcforge
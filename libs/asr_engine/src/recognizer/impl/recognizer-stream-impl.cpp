@@ -0,0 +1,118 @@
+// Copyright (c) 2025 PotterWhite
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// libs/asr_engine/src/recognizer/impl/recognizer-stream-impl.cpp
+#include "ASREngine/recognizer/impl/recognizer-stream-impl.h"
+#include "ASREngine/recognizer/impl/recognizer-model-impl.h"
+#include "Utils/logger/logger.h"
+
+#include "sherpa-onnx/c-api/cxx-api.h"
+
+namespace arcforge {
+namespace embedded {
+namespace ai_asr {
+
+using namespace sherpa_onnx::cxx;
+
+RecognizerStreamImpl::RecognizerStreamImpl(std::shared_ptr<const RecognizerModel> model)
+    : model_(std::move(model)) {
+	if (!model_ || !model_->impl_) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "RecognizerStream created without a loaded model.", kcurrent_lib_name);
+		model_.reset();
+		return;
+	}
+	stream_ptr_ = model_->impl_->CreateStream();
+	if (!stream_ptr_) {
+		model_.reset();
+	}
+}
+
+RecognizerStreamImpl::~RecognizerStreamImpl() = default;
+
+const RecognizerModelImpl& RecognizerStreamImpl::model() const {
+	return *model_->impl_;
+}
+
+bool RecognizerStreamImpl::IsValid() const {
+	return model_ && stream_ptr_;
+}
+
+void RecognizerStreamImpl::ProcessAudioChunk(const float* samples, size_t count,
+                                             int sample_rate) {
+	if (!IsValid()) {
+		arcforge::embedded::utils::Logger::GetInstance().Error("ASR (Impl) not initialized.",
+		                                                       kcurrent_lib_name);
+		return;
+	}
+	if (samples == nullptr || count == 0) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "Warning: Received empty audio chunk (Impl).", kcurrent_lib_name);
+		return;
+	}
+
+	// sherpa resamples internally when sample_rate differs from the model's
+	stream_ptr_->AcceptWaveform(sample_rate, samples, static_cast<int32_t>(count));
+	model().DecodeReady(*stream_ptr_);
+}
+
+void RecognizerStreamImpl::InputFinished() {
+	if (IsValid()) {
+		stream_ptr_->InputFinished();
+		model().DecodeReady(*stream_ptr_);
+	}
+}
+
+std::string RecognizerStreamImpl::GetCurrentText() const {
+	if (!IsValid()) {
+		return "";
+	}
+	return model().GetText(*stream_ptr_);
+}
+
+bool RecognizerStreamImpl::IsEndpoint() const {
+	if (!IsValid()) {
+		return false;
+	}
+	return model().IsEndpoint(*stream_ptr_);
+}
+
+void RecognizerStreamImpl::ResetStream() {
+	if (IsValid()) {
+		model().Reset(*stream_ptr_);
+
+		arcforge::embedded::utils::Logger::GetInstance().Info(
+		    "[ASR Stream Reset (Impl) for new utterance]", kcurrent_lib_name);
+	} else {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "Cannot reset stream, recognizer or stream not initialized.", kcurrent_lib_name);
+	}
+}
+
+int RecognizerStreamImpl::GetExpectedSampleRate() const {
+	if (!model_) {
+		return kdefault_sample_rate;
+	}
+	return model().GetExpectedSampleRate();
+}
+
+}  // namespace ai_asr
+}  // namespace embedded
+}  // namespace arcforge
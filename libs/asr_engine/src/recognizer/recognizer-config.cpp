@@ -30,20 +30,22 @@ SherpaConfig::SherpaConfig(const std::string& enc_path, const std::string& dec_p
                            const std::string& join_path, const std::string& tok_path,
                            const std::string& provider, int num_threads, float rule1, float rule2,
                            float rule3, const std::string& dec_method, SherpaDebug debug,
-                           SherpaEndPointSupport endpoint_detection)
-    : first_encoder_path_(enc_path),                          // Adjusted member name
-      second_decoder_path_(dec_path),                         // Adjusted member name
-      third_joiner_path_(join_path),                          // Adjusted member name
-      fourth_tokens_path_(tok_path),                          // Adjusted member name
-      fifth_provider_(provider),                              // Adjusted member name
-      sixth_num_threads_(num_threads),                        // Adjusted member name
-      seventh_rule1_min_trailing_silence_(rule1),             // Adjusted member name
-      eighth_rule2_min_trailing_silence_(rule2),              // Adjusted member name
-      ninth_rule3_min_utterance_length_(rule3),               // Adjusted member name
-      tenth_decoding_method_(dec_method),                     // Adjusted member name
-      eleventh_debug_level_(debug),                           // Adjusted member name
-      twelfth_enable_endpoint_detection_(endpoint_detection)  // Adjusted member name
-{
+                           SherpaEndPointSupport endpoint_detection, int max_batch_size,
+                           int max_batch_wait_ms)
+    : first_encoder_path_(enc_path),                           // Adjusted member name
+      second_decoder_path_(dec_path),                          // Adjusted member name
+      third_joiner_path_(join_path),                           // Adjusted member name
+      fourth_tokens_path_(tok_path),                           // Adjusted member name
+      fifth_provider_(provider),                               // Adjusted member name
+      sixth_num_threads_(num_threads),                         // Adjusted member name
+      seventh_rule1_min_trailing_silence_(rule1),              // Adjusted member name
+      eighth_rule2_min_trailing_silence_(rule2),               // Adjusted member name
+      ninth_rule3_min_utterance_length_(rule3),                // Adjusted member name
+      tenth_decoding_method_(dec_method),                      // Adjusted member name
+      eleventh_debug_level_(debug),                            // Adjusted member name
+      twelfth_enable_endpoint_detection_(endpoint_detection),  // Adjusted member name
+      thirteenth_max_batch_size_(max_batch_size),
+      fourteenth_max_batch_wait_ms_(max_batch_wait_ms) {
 	// Constructor body
 }
 
@@ -60,7 +62,9 @@ SherpaConfig::Builder::Builder()
       b_ninth_rule3_min_utterance_length_(20.0f),
       b_tenth_decoding_method_("greedy_search"),
       b_eleventh_debug_level_(SherpaDebug::kfalse),
-      b_twelfth_enable_endpoint_detection_(SherpaEndPointSupport::kdisable) {
+      b_twelfth_enable_endpoint_detection_(SherpaEndPointSupport::kdisable),
+      b_thirteenth_max_batch_size_(1),
+      b_fourteenth_max_batch_wait_ms_(0) {
 	// Builder constructor body
 }
 
@@ -136,6 +140,16 @@ SherpaConfig::Builder& SherpaConfig::Builder::setTwelfthEndpointDetectionSupport
 	return *this;
 }
 
+SherpaConfig::Builder& SherpaConfig::Builder::setThirteenthMaxBatchSize(int size) {
+	b_thirteenth_max_batch_size_ = std::max(size, 1);
+	return *this;
+}
+
+SherpaConfig::Builder& SherpaConfig::Builder::setFourteenthMaxBatchWaitMs(int wait_ms) {
+	b_fourteenth_max_batch_wait_ms_ = std::max(wait_ms, 0);
+	return *this;
+}
+
 SherpaConfig::Builder& SherpaConfig::Builder::fromConfig(const SherpaConfig& existingConfig) {
 	this->b_first_encoder_path_ = existingConfig.getFirstEncoderPath();
 	this->b_second_decoder_path_ = existingConfig.getSecondDecoderPath();
@@ -151,6 +165,8 @@ SherpaConfig::Builder& SherpaConfig::Builder::fromConfig(const SherpaConfig& exi
 	this->b_eleventh_debug_level_ = existingConfig.getEleventhDebugLevel();
 	this->b_twelfth_enable_endpoint_detection_ =
 	    existingConfig.getTwelfthEndpointDetectionSupport();
+	this->b_thirteenth_max_batch_size_ = existingConfig.getThirteenthMaxBatchSize();
+	this->b_fourteenth_max_batch_wait_ms_ = existingConfig.getFourteenthMaxBatchWaitMs();
 	return *this;
 }
 
@@ -190,7 +206,8 @@ SherpaConfig SherpaConfig::Builder::build() {
 	                    b_fourth_tokens_path_, b_fifth_provider_, b_sixth_num_threads_,
 	                    b_seventh_rule1_min_trailing_silence_, b_eighth_rule2_min_trailing_silence_,
 	                    b_ninth_rule3_min_utterance_length_, b_tenth_decoding_method_,
-	                    b_eleventh_debug_level_, b_twelfth_enable_endpoint_detection_);
+	                    b_eleventh_debug_level_, b_twelfth_enable_endpoint_detection_,
+	                    b_thirteenth_max_batch_size_, b_fourteenth_max_batch_wait_ms_);
 }
 
 }  // namespace ai_asr
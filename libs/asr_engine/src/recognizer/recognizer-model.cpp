@@ -0,0 +1,52 @@
+// Copyright (c) 2025 PotterWhite
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// libs/asr_engine/src/recognizer/recognizer-model.cpp
+#include "ASREngine/recognizer/recognizer-model.h"
+#include "ASREngine/recognizer/impl/recognizer-model-impl.h"
+#include "Utils/logger/logger.h"
+
+namespace arcforge {
+namespace embedded {
+namespace ai_asr {
+
+RecognizerModel::RecognizerModel() : impl_(std::make_unique<RecognizerModelImpl>()) {}
+
+RecognizerModel::~RecognizerModel() {}
+
+std::shared_ptr<RecognizerModel> RecognizerModel::Create(const SherpaConfig& config) {
+	std::shared_ptr<RecognizerModel> model(new RecognizerModel());
+	if (model->impl_->Initialize(config) == false) {
+		return nullptr;
+	}
+	return model;
+}
+
+int RecognizerModel::GetExpectedSampleRate() const {
+	return impl_->GetExpectedSampleRate();
+}
+
+bool RecognizerModel::WarmUp(int passes, int audio_ms) const {
+	return impl_->WarmUp(passes, audio_ms);
+}
+
+}  // namespace ai_asr
+}  // namespace embedded
+}  // namespace arcforge
@@ -0,0 +1,117 @@
+// Copyright (c) 2025 PotterWhite
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// libs/asr_engine/src/recognizer/recognizer-stream.cpp
+#include "ASREngine/recognizer/recognizer-stream.h"
+#include "ASREngine/recognizer/impl/recognizer-stream-impl.h"
+#include "Utils/logger/logger.h"
+
+namespace arcforge {
+namespace embedded {
+namespace ai_asr {
+
+RecognizerStream::RecognizerStream(std::shared_ptr<const RecognizerModel> model)
+    : impl_(std::make_unique<RecognizerStreamImpl>(std::move(model))) {}
+
+RecognizerStream::~RecognizerStream() {}
+
+RecognizerStream::RecognizerStream(RecognizerStream&& other) noexcept
+    : impl_(std::move(other.impl_)) {}
+
+RecognizerStream& RecognizerStream::operator=(RecognizerStream&& other) noexcept {
+	if (this != &other) {
+		impl_ = std::move(other.impl_);
+	}
+	return *this;
+}
+
+bool RecognizerStream::IsValid() const {
+	return impl_ && impl_->IsValid();
+}
+
+void RecognizerStream::ProcessAudioChunk(const std::vector<float>& audio_chunk) {
+	ProcessAudioChunk(audio_chunk.data(), audio_chunk.size());
+}
+
+void RecognizerStream::ProcessAudioChunk(const float* samples, size_t count) {
+	ProcessAudioChunk(samples, count, GetExpectedSampleRate());
+}
+
+void RecognizerStream::ProcessAudioChunk(const float* samples, size_t count, int sample_rate) {
+	if (impl_) {
+		impl_->ProcessAudioChunk(samples, count, sample_rate);
+	} else {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "RecognizerStream::ProcessAudioChunk called on a null PIMPL.", kcurrent_lib_name);
+	}
+}
+
+void RecognizerStream::InputFinished() {
+	if (impl_) {
+		impl_->InputFinished();
+	} else {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "RecognizerStream::InputFinished called on a null PIMPL.", kcurrent_lib_name);
+	}
+}
+
+std::string RecognizerStream::GetCurrentText() const {
+	if (impl_) {
+		return impl_->GetCurrentText();
+	}
+
+	arcforge::embedded::utils::Logger::GetInstance().Error(
+	    "RecognizerStream::GetCurrentText called on a null PIMPL.", kcurrent_lib_name);
+	return "";
+}
+
+bool RecognizerStream::IsEndpoint() const {
+	if (impl_) {
+		return impl_->IsEndpoint();
+	}
+
+	arcforge::embedded::utils::Logger::GetInstance().Error(
+	    "RecognizerStream::IsEndpoint called on a null PIMPL.", kcurrent_lib_name);
+	return false;
+}
+
+void RecognizerStream::ResetStream() {
+	if (impl_) {
+		impl_->ResetStream();
+	} else {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "RecognizerStream::ResetStream called on a null PIMPL.", kcurrent_lib_name);
+	}
+}
+
+int RecognizerStream::GetExpectedSampleRate() const {
+	if (impl_) {
+		return impl_->GetExpectedSampleRate();
+	}
+
+	arcforge::embedded::utils::Logger::GetInstance().Error(
+	    "RecognizerStream::GetExpectedSampleRate called on a null PIMPL.", kcurrent_lib_name);
+
+	return kdefault_sample_rate;
+}
+
+}  // namespace ai_asr
+}  // namespace embedded
+}  // namespace arcforge
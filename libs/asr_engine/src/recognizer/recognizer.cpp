@@ -62,6 +62,24 @@ void Recognizer::ProcessAudioChunk(const std::vector<float>& audio_chunk) {
 	}
 }
 
+void Recognizer::ProcessAudioChunk(const float* samples, size_t count) {
+	if (impl_) {
+		impl_->ProcessAudioChunk(samples, count);
+	} else {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "Recognizer::ProcessAudioChunk called on a null PIMPL.", kcurrent_lib_name);
+	}
+}
+
+void Recognizer::ProcessAudioChunk(const float* samples, size_t count, int sample_rate) {
+	if (impl_) {
+		impl_->ProcessAudioChunk(samples, count, sample_rate);
+	} else {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "Recognizer::ProcessAudioChunk called on a null PIMPL.", kcurrent_lib_name);
+	}
+}
+
 void Recognizer::InputFinished() {
 	if (impl_) {
 		impl_->InputFinished();
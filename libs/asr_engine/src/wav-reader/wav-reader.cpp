@@ -243,7 +243,7 @@ bool WavReader::ParseWavHeader(int expected_sample_rate, int expected_channels)
 	return true;
 }
 
-size_t WavReader::ReadSamples(std::vector<float>& out_samples, size_t num_samples_to_read) {
+size_t WavReader::ReadSamples(std::vector<int16_t>& out_samples, size_t num_samples_to_read) {
 	if (!is_opened_ || eof_) {
 		out_samples.clear();
 		return 0;
@@ -327,8 +327,7 @@ size_t WavReader::ReadSamples(std::vector<float>& out_samples, size_t num_sample
 
 	for (size_t i = 0; i < samples_just_read_per_channel; ++i) {
 
-		out_samples[i] =
-		    static_cast<float>(temp_s16_buffer[i * static_cast<size_t>(channels_)]) / 32768.0f;
+		out_samples[i] = temp_s16_buffer[i * static_cast<size_t>(channels_)];
 	}
 
 	if (bytes_read_from_data_chunk_ >= data_chunk_size_) {
@@ -341,6 +340,16 @@ size_t WavReader::ReadSamples(std::vector<float>& out_samples, size_t num_sample
 	return samples_just_read_per_channel;
 }
 
+size_t WavReader::ReadSamples(std::vector<float>& out_samples, size_t num_samples_to_read) {
+	size_t samples_read = ReadSamples(pcm16_scratch_, num_samples_to_read);
+
+	out_samples.resize(samples_read);
+	for (size_t i = 0; i < samples_read; ++i) {
+		out_samples[i] = static_cast<float>(pcm16_scratch_[i]) / 32768.0f;
+	}
+	return samples_read;
+}
+
 }  // namespace ai_asr
 }  // namespace embedded
 }  // namespace arcforge
\ No newline at end of file
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include "Network/common/audio-buffer.h"
 #include "Network/common/common-types.h"
 #include "Network/pch.h"
 
@@ -50,18 +51,167 @@ class Base {
 
 	virtual SocketStatus isSocketFDValid() const;
 	virtual void closeSocket();
+	// wakes every call blocked on this connection from any thread without taking its locks
+	// (async-signal-safe); they and all later sends/receives return kcancelled until
+	// closeSocket(). The socket itself stays open, closing it is up to the owner.
+	virtual void cancel();
+	virtual bool isCancelled() const;
 
 	//getter & setter
 	virtual int getFD() const;
 	virtual void setFD(int);
 	virtual const std::string& getSocketPath();
 	virtual void setSocketPath(const std::string& path);
+	// kio_uring: header and body of a frame go out as linked sends in one syscall and rx is
+	// served from a multishot receive. The socket data is then owned by the ring, so don't
+	// mix it with raw recv()/epoll readiness on getFD(). Returns kio_backend_unavailable
+	// (and stays on kposix) when the build or the kernel lacks io_uring.
+	virtual SocketReturnValue setIoBackend(IoBackend backend);
+	virtual IoBackend getIoBackend() const;
+	// must be chosen before connectToServer()/startServer(); accepted connections inherit it.
+	// kseqpacket ignores the io_uring backend: every frame is already a single syscall.
+	virtual SocketReturnValue setSocketType(SocketType type);
+	virtual SocketType getSocketType() const;
+	// switches connectToServer()/startServer() from the socket path to TCP. An empty host
+	// listens on every address (IPv4 and IPv6) or connects to the loopback; port 0 lets
+	// startServer() pick a free port, read it back with getLocalPort(). TCP carries
+	// kstream framing only and cannot pass the memfd of ShmChannel::offer().
+	virtual void setTcpEndpoint(const std::string& host, uint16_t port);
+	// before connectToServer()/startServer(); accepted connections inherit the options
+	virtual void setTcpOptions(const TcpOptions& options);
+	virtual TransportFamily getTransportFamily() const;
+	// bound port of a TCP socket, 0 for Unix-domain sockets
+	virtual uint16_t getLocalPort() const;
+	// SO_PEERCRED of a Unix-domain connection, so a server can tell its clients apart;
+	// kpeer_credentials_unavailable over TCP
+	virtual SocketReturnValue getPeerCredentials(PeerCredentials& credentials) const;
+	// SO_TIMESTAMPNS: FrameInfo::kernel_rx_ns records when the kernel took a frame in. Turn
+	// it on before the first sample frame, the io_uring rx ring cannot deliver timestamps and
+	// is not attached while they are on. TCP and kseqpacket only, the kernel does not stamp
+	// Unix-domain stream data and kernel_rx_ns stays 0 there.
+	virtual SocketReturnValue setReceiveTimestamps(bool enable);
+	// sequence, send time and kernel ingress of the last sample frame a single-frame receive
+	// returned (receiveFloat/receivePcm16/receiveMulaw/receiveFloatStreaming); a batch
+	// receive leaves the first frame of its batch here
+	virtual FrameInfo getLastFrameInfo() const;
 
 	// rx & tx
+	// full duplex: sends and receives are serialised per direction, so one thread may block
+	// in a receive while another sends on the same connection. closeSocket() from a third
+	// thread wakes the pending calls, which then fail instead of hanging.
 	virtual SocketReturnValue sendFloat(const std::vector<float>& data);
 	virtual SocketReturnValue receiveFloat(std::vector<float>& data);
+	// allocation-free receives: storage is reused across frames and never zero-filled.
+	// The span variant drops a frame larger than capacity and returns kbuffer_too_small;
+	// the pooled variant takes a buffer from this connection's pool when handed an empty one.
+	virtual SocketReturnValue receiveFloat(AudioBuffer& buffer);
+	virtual SocketReturnValue receiveFloat(float* dst, size_t capacity, size_t& count);
+	virtual SocketReturnValue receiveFloat(PooledAudioBuffer& buffer);
+	virtual std::shared_ptr<AudioBufferPool> getBufferPool();
 	virtual SocketReturnValue sendString(const std::string& message);
 	virtual SocketReturnValue receiveString(std::string& message);
+	// timed variants: give up with kio_timeout once deadline passes and nothing arrived/left.
+	// A timeout in the middle of a stream frame breaks the framing of that direction, every
+	// later call on it fails and the connection should be closed. Packets are never split.
+	virtual SocketReturnValue sendFloat(const std::vector<float>& data, Deadline deadline);
+	virtual SocketReturnValue receiveFloat(std::vector<float>& data, Deadline deadline);
+	virtual SocketReturnValue receiveFloat(AudioBuffer& buffer, Deadline deadline);
+	virtual SocketReturnValue receiveFloat(float* dst, size_t capacity, size_t& count,
+	                                       Deadline deadline);
+	virtual SocketReturnValue sendString(const std::string& message, Deadline deadline);
+	virtual SocketReturnValue receiveString(std::string& message, Deadline deadline);
+	// streaming receive of one float frame: on_slice gets slice_samples at a time (the last
+	// slice may be shorter) as soon as they have arrived, so a large frame can be decoded
+	// while the rest is in flight and is never held whole. The handler runs with the receive
+	// side locked and must not receive on this connection. Other frames come back as from
+	// receiveFloat(); in packet mode the frame arrives at once and is only handed over in
+	// slices.
+	virtual SocketReturnValue receiveFloatStreaming(size_t slice_samples,
+	                                                const SampleSliceHandler& on_slice,
+	                                                uint32_t& frame_count);
+	virtual SocketReturnValue receiveFloatStreaming(size_t slice_samples,
+	                                                const SampleSliceHandler& on_slice,
+	                                                uint32_t& frame_count, Deadline deadline);
+	// batched float frames. receiveFloatBatch() waits for the first frame like receiveFloat()
+	// and then takes up to frames.size() - 1 more that are already queued, never waiting for
+	// them; an EOF marker or any other non-sample frame ends the batch and is reported by the
+	// next call. sendFloatBatch() hands the whole batch to the kernel at once
+	// (recvmmsg()/sendmmsg() in packet mode); frames_sent counts the frames that went out.
+	virtual SocketReturnValue receiveFloatBatch(std::vector<AudioBuffer>& frames,
+	                                            size_t& frame_count);
+	virtual SocketReturnValue receiveFloatBatch(std::vector<AudioBuffer>& frames,
+	                                            size_t& frame_count, Deadline deadline);
+	virtual SocketReturnValue sendFloatBatch(const std::vector<std::vector<float>>& frames,
+	                                         size_t& frames_sent);
+	virtual SocketReturnValue sendFloatBatch(const std::vector<std::vector<float>>& frames,
+	                                         size_t& frames_sent, Deadline deadline);
+	// compact sample frames: pcm16 halves the bytes of float32 and is lossless for audio that
+	// came from 16-bit PCM anyway. A frame in an encoding the receiver did not ask for is
+	// dropped with ksample_encoding_mismatch, the next one is read normally.
+	virtual SocketReturnValue sendPcm16(const std::vector<int16_t>& samples);
+	virtual SocketReturnValue sendPcm16(const std::vector<int16_t>& samples, Deadline deadline);
+	virtual SocketReturnValue receivePcm16(std::vector<int16_t>& samples);
+	virtual SocketReturnValue receivePcm16(std::vector<int16_t>& samples, Deadline deadline);
+	virtual SocketReturnValue sendMulaw(const std::vector<uint8_t>& samples);
+	virtual SocketReturnValue receiveMulaw(std::vector<uint8_t>& samples);
+	virtual SocketReturnValue receiveMulaw(std::vector<uint8_t>& samples, Deadline deadline);
+	// client: offer a preferred encoding and block until the server answers with the agreed
+	// one. Server: a sample receive returns kreceived_encoding_offer when the offer arrives,
+	// acceptSampleEncoding() then answers it (unknown encodings fall back to kfloat32).
+	virtual SocketReturnValue negotiateSampleEncoding(SampleEncoding preferred,
+	                                                  SampleEncoding& agreed);
+	virtual SocketReturnValue acceptSampleEncoding(SampleEncoding& agreed);
+	virtual SampleEncoding getSampleEncoding() const;
+	// versioned session handshake, a superset of the encoding negotiation above. Client: send
+	// a hello with the stream parameters and block until the server's grant arrives. Server:
+	// a sample receive returns kreceived_hello, takeHello() hands over what the client asked
+	// for and answerHello() sends the grant. The granted encoding applies to the connection.
+	virtual SocketReturnValue handshake(const StreamParams& requested, SessionGrant& granted);
+	virtual SocketReturnValue takeHello(StreamParams& requested);
+	virtual SocketReturnValue answerHello(const SessionGrant& granted);
+	// admission control. Server: answer a connection it cannot serve yet, in place of the
+	// welcome; the client's handshake() (or a pending receiveString()/receiveResult()) then
+	// returns kserver_busy and getRetryAfter() tells when to reconnect.
+	virtual SocketReturnValue sendBusy(std::chrono::milliseconds retry_after);
+	virtual std::chrono::milliseconds getRetryAfter() const;
+	// true while received bytes wait in user space (read-ahead, batched packets, io_uring
+	// buffers) for the next receive: epoll on the fd does not report them. A reader driven by
+	// readiness checks this before it waits, see EventLoop::addFD().
+	virtual bool hasBufferedData() const;
+	// the fd to wait on for more input: the socket, or the io_uring ring once its multishot
+	// receive took over the socket. It can change after a receive.
+	virtual int getReadinessFD() const;
+	// multiplexed connection (granted max_streams > 1): many logical sessions share one
+	// socket, every frame names its stream. An empty sample frame ends that stream only and
+	// comes back from receiveStreamFrame() as keof with frame.stream set.
+	virtual SocketReturnValue sendStreamFloat(StreamId stream, const std::vector<float>& data);
+	virtual SocketReturnValue sendStreamPcm16(StreamId stream,
+	                                          const std::vector<int16_t>& samples);
+	virtual SocketReturnValue sendStreamString(StreamId stream, const std::string& message);
+	virtual SocketReturnValue sendStreamString(StreamId stream, const std::string& message,
+	                                           Deadline deadline);
+	virtual SocketReturnValue receiveStreamFrame(StreamFrame& frame);
+	virtual SocketReturnValue receiveStreamFrame(StreamFrame& frame, Deadline deadline);
+	// pushed results (granted push_results): the server sends partial and final hypotheses
+	// on its own schedule, each naming how many chunks it consumed since the previous one;
+	// receiveResult() returns that many credits. A plain sendString() answer is taken as a
+	// partial result acknowledging one chunk, so clients can use it against either server.
+	virtual SocketReturnValue sendResult(const ResultMessage& result);
+	virtual SocketReturnValue sendResult(const ResultMessage& result, Deadline deadline);
+	virtual SocketReturnValue receiveResult(ResultMessage& result);
+	virtual SocketReturnValue receiveResult(ResultMessage& result, Deadline deadline);
+	// credit-based flow control, set up by handshake(): a sample frame may only leave while
+	// the session has a credit, each result received returns one. Without a credit the send
+	// is refused with kno_send_credit and nothing goes out; EOF markers are always allowed.
+	// kunlimited_send_credits when no window was granted.
+	virtual uint32_t getSendCredits() const;
+	virtual uint32_t getSendCredits(StreamId stream) const;
+	// pass fds to the peer with SCM_RIGHTS. receiveFloat() on the other side returns
+	// kreceived_fds when it meets such a frame, receiveFDs() then hands the fds over.
+	// With io_uring rx, only the opening frame of a connection (after the hello, if any) may
+	// carry fds.
+	virtual SocketReturnValue sendFDs(const std::vector<int>& fds);
+	virtual SocketReturnValue receiveFDs(std::vector<int>& fds);
 
 	// // log
 	// virtual void log(const std::string& msg);
@@ -73,6 +223,8 @@ class Base {
 	virtual SocketReturnValue connectToServer();
 
 	// server-utilized-only functions
+	// connections the kernel queues for accept(), before startServer(); default 1
+	virtual void setListenBacklog(int backlog);
 	virtual SocketReturnValue startServer(const size_t& timeout = static_cast<size_t>(-1));
 
 	virtual SocketAcceptReturn acceptClient();
@@ -23,6 +23,8 @@
 // libs/network/include/Network/base/impl/base-impl.h
 #pragma once
 
+#include "Network/base/impl/io-uring.h"
+#include "Network/common/audio-buffer.h"
 #include "Network/common/common-types.h"
 #include "Network/pch.h"
 
@@ -31,6 +33,49 @@ namespace embedded {
 namespace network_socket {
 
 inline constexpr int killegal_fd_value = -1;
+// header of a frame that carries SCM_RIGHTS fds instead of a float count (low bits: fd count)
+inline constexpr uint32_t kfd_frame_tag = 0xFD500000u;
+inline constexpr uint32_t kfd_frame_tag_mask = 0xFFFF0000u;
+inline constexpr size_t kmax_passed_fds = 8;
+// compact sample frames: the top byte names the encoding, the low 24 bits carry the count.
+// A float frame header is a bare count and never reaches these bits (see kmax_frame_samples).
+inline constexpr uint32_t ksample_frame_tag_mask = 0xFF000000u;
+inline constexpr uint32_t ksample_frame_count_mask = 0x00FFFFFFu;
+inline constexpr uint32_t kpcm16_frame_tag = 0xA1000000u;
+inline constexpr uint32_t kmulaw_frame_tag = 0xA2000000u;
+// header-only frames of the encoding negotiation, the low byte holds a SampleEncoding
+inline constexpr uint32_t kencoding_offer_tag = 0xE5000000u;
+inline constexpr uint32_t kencoding_answer_tag = 0xE6000000u;
+// session handshake frames, the low 24 bits carry the body length in bytes. The body is a
+// list of uint32 words; a peer reads the words it knows and ignores any that follow.
+inline constexpr uint32_t khello_tag = 0xE7000000u;
+inline constexpr uint32_t kwelcome_tag = 0xE8000000u;
+inline constexpr uint32_t kmax_hello_bytes = 256;
+inline constexpr uint32_t kmax_frame_samples = 1024 * 1024;
+// frame metadata (StreamParams::frame_metadata): a sample header with this bit is followed by
+// [sequence, send time low, send time high]; a packet carries the words at its end instead, so
+// the samples still land in the caller's storage. No count reaches the bit.
+inline constexpr uint32_t kframe_metadata_bit = 0x00800000u;
+inline constexpr size_t kframe_metadata_words = 3;
+static_assert(kmax_frame_samples < kframe_metadata_bit, "a count must not set the metadata bit");
+// multiplexed frames: a prefix word (tag | kind | stream id) in front of the usual sample
+// header or text length
+inline constexpr uint32_t kmux_frame_tag = 0xB5000000u;
+inline constexpr uint32_t kmux_kind_mask = 0x00FF0000u;
+inline constexpr uint32_t kmux_kind_shift = 16;
+inline constexpr uint32_t kmux_stream_mask = 0x0000FFFFu;
+inline constexpr uint32_t kmax_text_bytes = 1024 * 1024;
+// pushed results: tag | ResultKind, then the acknowledged chunk count and the text length.
+// A bare text length never reaches the tag bits (see kmax_text_bytes).
+inline constexpr uint32_t kresult_frame_tag = 0xE9000000u;
+inline constexpr uint32_t kresult_kind_mask = 0x000000FFu;
+// admission refused: tag | body length, then the milliseconds after which to try again.
+// Read wherever the client waits for the server first (welcome, string or result).
+inline constexpr uint32_t kbusy_tag = 0xEA000000u;
+// key of the only session on a connection that is not multiplexed
+inline constexpr StreamId kplain_session = 0;
+// frames moved by one batched call (recvmmsg()/sendmmsg() vector length)
+inline constexpr size_t kmax_batch_frames = 64;
 
 class BaseImpl;
 
@@ -52,24 +97,93 @@ class BaseImpl {
 	BaseImpl(const BaseImpl&) = delete;
 	BaseImpl& operator=(const BaseImpl&) = delete;
 
-	// permit move semantics
-	BaseImpl(BaseImpl&&) noexcept = default;
-	BaseImpl& operator=(BaseImpl&&) noexcept = default;
+	// not movable either: cancelled_ is an atomic, and cancel() may touch it from another
+	// thread at any time. Base moves by handing over its impl_ pointer instead.
+	BaseImpl(BaseImpl&&) = delete;
+	BaseImpl& operator=(BaseImpl&&) = delete;
 
 	SocketStatus isSocketFDValid_safe();
 	void closeSocket_safe();
+	// lock-free on purpose: runs while another thread holds the locks in a blocking call
+	void cancel();
+	bool isCancelled() const;
 
 	// getter and setter
 	int getFD_safe();
 	void setFD_safe(int);
 	const std::string& getSocketPath_safe();
 	void setSocketPath_safe(const std::string& path);
+	void setTcpEndpoint_safe(const std::string& host, uint16_t port);
+	void setTcpOptions_safe(const TcpOptions& options);
+	TransportFamily getTransportFamily_safe();
+	uint16_t getLocalPort_safe();
+	SocketReturnValue getPeerCredentials_safe(PeerCredentials& credentials);
+	SocketReturnValue setReceiveTimestamps_safe(bool enable);
+	FrameInfo getLastFrameInfo_safe();
+	SocketReturnValue setIoBackend_safe(IoBackend backend);
+	IoBackend getIoBackend_safe();
+	SocketReturnValue setSocketType_safe(SocketType type);
+	SocketType getSocketType_safe();
+	void setListenBacklog_safe(int backlog);
+	uint32_t getRetryAfter_safe();
+	bool hasBufferedData_safe();
+	int getReadinessFD_safe();
+	std::shared_ptr<AudioBufferPool> getBufferPool_safe();
 
 	// rx & tx methods
-	SocketReturnValue receiveFloat_safe(std::vector<float>& data);
-	SocketReturnValue sendString_safe(const std::string& message);
-	SocketReturnValue sendFloat_safe(const std::vector<float>& data);
-	SocketReturnValue receiveString_safe(std::string& message);
+	SocketReturnValue receiveFloat_safe(std::vector<float>& data,
+	                                    const Deadline& deadline = kno_deadline);
+	SocketReturnValue receiveFloat_safe(AudioBuffer& buffer,
+	                                    const Deadline& deadline = kno_deadline);
+	SocketReturnValue receiveFloat_safe(float* dst, size_t capacity, size_t& count,
+	                                    const Deadline& deadline = kno_deadline);
+	SocketReturnValue sendString_safe(const std::string& message,
+	                                  const Deadline& deadline = kno_deadline);
+	SocketReturnValue sendFloat_safe(const std::vector<float>& data,
+	                                 const Deadline& deadline = kno_deadline);
+	SocketReturnValue receiveString_safe(std::string& message,
+	                                     const Deadline& deadline = kno_deadline);
+	SocketReturnValue sendResult_safe(const ResultMessage& result,
+	                                  const Deadline& deadline = kno_deadline);
+	SocketReturnValue receiveResult_safe(ResultMessage& result,
+	                                     const Deadline& deadline = kno_deadline);
+	SocketReturnValue sendPcm16_safe(const int16_t* samples, size_t count,
+	                                 const Deadline& deadline = kno_deadline);
+	SocketReturnValue receivePcm16_safe(std::vector<int16_t>& samples,
+	                                    const Deadline& deadline = kno_deadline);
+	SocketReturnValue sendMulaw_safe(const uint8_t* samples, size_t count,
+	                                 const Deadline& deadline = kno_deadline);
+	SocketReturnValue receiveMulaw_safe(std::vector<uint8_t>& samples,
+	                                    const Deadline& deadline = kno_deadline);
+	SocketReturnValue negotiateSampleEncoding_safe(SampleEncoding preferred,
+	                                               SampleEncoding& agreed);
+	SocketReturnValue acceptSampleEncoding_safe(SampleEncoding& agreed);
+	SampleEncoding getSampleEncoding_safe();
+	SocketReturnValue handshake_safe(const StreamParams& requested, SessionGrant& granted);
+	SocketReturnValue takeHello_safe(StreamParams& requested);
+	SocketReturnValue answerHello_safe(const SessionGrant& granted);
+	SocketReturnValue sendBusy_safe(uint32_t retry_after_ms);
+	SocketReturnValue sendStreamSamples_safe(StreamId stream, SampleEncoding encoding,
+	                                         const void* samples, size_t count,
+	                                         const Deadline& deadline = kno_deadline);
+	SocketReturnValue sendStreamString_safe(StreamId stream, const std::string& message,
+	                                        const Deadline& deadline = kno_deadline);
+	SocketReturnValue receiveStreamFrame_safe(StreamFrame& frame,
+	                                          const Deadline& deadline = kno_deadline);
+	// several frames per syscall: drains what is queued behind the first frame, emits a
+	// whole batch with one sendmsg()/sendmmsg()
+	SocketReturnValue receiveFloatBatch_safe(std::vector<AudioBuffer>& frames, size_t& frame_count,
+	                                         const Deadline& deadline = kno_deadline);
+	SocketReturnValue receiveFloatStreaming_safe(size_t slice_samples,
+	                                             const SampleSliceHandler& on_slice,
+	                                             uint32_t& frame_count,
+	                                             const Deadline& deadline = kno_deadline);
+	SocketReturnValue sendFloatBatch_safe(const std::vector<std::vector<float>>& frames,
+	                                      size_t& frames_sent,
+	                                      const Deadline& deadline = kno_deadline);
+	SocketReturnValue sendFDs_safe(const std::vector<int>& fds);
+	SocketReturnValue receiveFDs_safe(std::vector<int>& fds);
+	uint32_t getSendCredits_safe(StreamId stream);
 
 	// // log functions
 	// void log_safe(const std::string& msg);
@@ -93,6 +207,104 @@ class BaseImpl {
 	void setFD(int);
 	const std::string& getSocketPath() const;
 	void setSocketPath(const std::string& path);
+	bool isPacketMode() const;
+	int nativeSocketType() const;
+	void attachTxRing();
+	void attachRxRing();
+	void detachIoUring();
+
+	// holds all three locks; socketfd_, socket_type_ and io_backend_ only change under it,
+	// so the rx and tx paths can read them with just their own lock
+	struct ExclusiveAccess {
+		std::unique_lock<std::mutex> send_lock;
+		std::unique_lock<std::mutex> receive_lock;
+		std::unique_lock<std::mutex> socket_lock;
+	};
+	ExclusiveAccess lockExclusive(bool interrupt_pending_io);
+
+	// deadline handling: a frame abandoned halfway leaves that direction out of sync
+	SocketReturnValue beginReceive(const Deadline& deadline, const std::string& caller);
+	SocketReturnValue beginSend(const Deadline& deadline, const std::string& caller);
+	SocketReturnValue waitForSocket(short events, const Deadline& deadline,
+	                                SocketReturnValue failure, const std::string& caller);
+	SocketReturnValue abandonReceive(size_t bytes_in_frame, const std::string& caller);
+	void drainCancelFD();
+
+	// framing helpers shared by every rx & tx method
+	SocketReturnValue transmitFrame(const void* header, size_t header_len, const void* body,
+	                                size_t body_len, SocketReturnValue header_failure,
+	                                const std::string& caller, const void* trailer = nullptr,
+	                                size_t trailer_len = 0);
+	SocketReturnValue receiveExact(void* dst, size_t len, const std::string& caller);
+	SocketReturnValue discardExact(size_t len, const std::string& caller);
+	// SCM_RIGHTS fds and the SO_TIMESTAMPNS ingress time of one recvmsg()
+	void collectAncillaryData(const struct msghdr& msg);
+	void closePassedFDs();
+	SocketReturnValue receiveFloatFrame(AudioBuffer& buffer, const std::string& caller);
+	SocketReturnValue receiveFloatCount(uint32_t& count);
+	SocketReturnValue receiveFloatBody(float* dst, uint32_t count);
+	// frame headers of every sample encoding; a frame in another encoding than expected is
+	// dropped whole and reported as ksample_encoding_mismatch
+	SocketReturnValue receiveSampleHeader(SampleEncoding expected, uint32_t& count,
+	                                      const std::string& caller);
+	SocketReturnValue validateSampleHeader(uint32_t header, SampleEncoding expected,
+	                                       uint32_t& count, SampleEncoding& frame_encoding,
+	                                       const std::string& caller);
+	// header of a busy frame was read in place of an answer: keeps its retry hint
+	SocketReturnValue takeBusyFrame(size_t body_len, const std::string& caller);
+	// body_in_place: the caller storage receivePacket() filled first, a hello body is
+	// gathered from there and the staging buffer
+	// body_len comes back without the metadata trailer
+	SocketReturnValue validateSamplePacket(uint32_t header, SampleEncoding expected,
+	                                       uint32_t& count, const void* body_in_place,
+	                                       size_t in_place_capacity, size_t& body_len,
+	                                       const std::string& caller);
+	void takeFrameMetadata(const uint32_t (&words)[kframe_metadata_words]);
+	// prefix + header of a multiplexed frame -> frame fields and body length
+	SocketReturnValue validateStreamHeader(const uint32_t (&words)[2], StreamFrame& frame,
+	                                       size_t& body_len, const std::string& caller);
+	// reads one handshake frame (header + word list) outside the sample path
+	SocketReturnValue receiveHandshakeFrame(uint32_t& tag, std::vector<uint32_t>& words,
+	                                        const std::string& caller);
+	template <typename Sample>
+	SocketReturnValue receiveSamples(std::vector<Sample>& samples, SampleEncoding encoding,
+	                                 const std::string& caller);
+	SocketReturnValue transmitSamples(uint32_t tag, const void* samples, size_t count,
+	                                  size_t sample_bytes, const std::string& caller);
+	// a sample frame with the metadata of tx_frame_metadata_ in its place, see
+	// kframe_metadata_bit
+	SocketReturnValue transmitSampleFrame(uint32_t header, const void* body, size_t body_len,
+	                                      const std::string& caller);
+	// TCP transport
+	SocketReturnValue connectTcp();
+	SocketReturnValue startTcpServer(const size_t& timeout);
+	SocketReturnValue applyTcpOptions(int fd, const TcpOptions& options);
+	// listen() + optional accept timeout, shared by both transports
+	SocketReturnValue listenOn(int sock_fd, const size_t& timeout);
+	// SOCK_SEQPACKET: one recvmsg() per frame
+	SocketReturnValue receivePacket(void* header, size_t header_len, void* body,
+	                                size_t body_capacity, size_t& body_len,
+	                                const std::string& caller);
+	void takePacketOverflow(void* dst, size_t len, size_t offset = 0);
+	// batches: stageAhead() tops the staging buffer up without blocking and returns the
+	// bytes staged; the take/receive helpers only consume complete float frames
+	size_t stageAhead(size_t want);
+	bool takeStagedFloatFrame(AudioBuffer& buffer);
+	size_t receivePacketBatch(std::vector<AudioBuffer>& frames, size_t first, size_t limit);
+	// credit window of the handshake: a sample frame of a stream takes one credit, a result
+	// on the same stream returns it. The plain (not multiplexed) session counts as one stream.
+	uint32_t takeSendCredits(StreamId stream, uint32_t wanted);
+	void returnSendCredits(StreamId stream, uint32_t count);
+	SocketReturnValue refuseWithoutCredit(StreamId stream, const std::string& caller);
+	// packets a batch read past a non-sample frame, handed out by receivePacket() in order
+	void queuePacket(const struct mmsghdr& message, uint32_t header, const AudioBuffer& in_place,
+	                 const char* overflow);
+	SocketReturnValue takeQueuedPacket(void* header, size_t header_len, void* body,
+	                                   size_t body_capacity, size_t& body_len);
+	SocketReturnValue transmitStreamBatch(const std::vector<std::vector<float>>& frames,
+	                                      size_t first, size_t count, size_t& frames_sent);
+	SocketReturnValue transmitPacketBatch(const std::vector<std::vector<float>>& frames,
+	                                      size_t first, size_t count, size_t& frames_sent);
 	// // log functions
 	// void log(const std::string& msg);
 	// void log_warning(const std::string& msg);
@@ -102,8 +314,82 @@ class BaseImpl {
    private:
 	int socketfd_ = -1;
 	std::string socketpath_;
+	// socket_mutex_: fd lifecycle and configuration
+	// send_mutex_ / receive_mutex_: serialise each direction, a blocking receive never holds
+	// up a send on the same connection
 	std::unique_ptr<std::mutex> socket_mutex_;
+	std::unique_ptr<std::mutex> send_mutex_;
+	std::unique_ptr<std::mutex> receive_mutex_;
 	std::unique_ptr<std::mutex> log_mutex_;
+	// guards credit_window_ and inflight_chunks_, touched by both directions
+	std::unique_ptr<std::mutex> credit_mutex_;
+	// eventfd every blocking wait polls next to the socket, written once by cancel() and
+	// drained by closeSocket()
+	int cancel_fd_ = -1;
+	std::atomic<bool> cancelled_{false};
+
+	// kunix uses socketpath_, ktcp the host/port pair; guarded by socket_mutex_
+	TransportFamily transport_ = TransportFamily::kunix;
+	std::string tcp_host_;
+	uint16_t tcp_port_ = 0;
+	TcpOptions tcp_options_;
+
+	SocketType socket_type_ = SocketType::kstream;
+	// listen() queue of startServer(), guarded by socket_mutex_
+	int listen_backlog_ = 1;
+	IoBackend io_backend_ = IoBackend::kposix;
+	std::unique_ptr<IoUring> tx_ring_;
+	std::unique_ptr<IoUring> rx_ring_;
+	bool tx_ring_refused_ = false;
+	bool rx_opening_frame_done_ = false;
+	bool rx_ring_refused_ = false;
+
+	// deadline of the rx/tx call in progress, guarded by the direction's lock
+	Deadline rx_deadline_ = kno_deadline;
+	Deadline tx_deadline_ = kno_deadline;
+	// bytes of the current frame already handed to the caller
+	size_t rx_frame_bytes_ = 0;
+	bool rx_out_of_sync_ = false;
+	bool tx_out_of_sync_ = false;
+
+	std::shared_ptr<AudioBufferPool> buffer_pool_;
+
+	// posix rx: one recvmsg() reads a header together with the queued payload behind it
+	static constexpr size_t krx_staging_size_ = 64 * 1024;
+	// packet mode: covers the largest message the default unix socket buffers allow
+	static constexpr size_t krx_packet_staging_size_ = 256 * 1024;
+	// batched rx reads ahead this far so one recvmsg() covers several frames
+	static constexpr size_t krx_batch_staging_size_ = 256 * 1024;
+	std::vector<char> rx_staging_;
+	// recvmmsg() overflow, one krx_packet_staging_size_ slot per batch frame, allocated on
+	// the first packet batch
+	std::unique_ptr<char[]> rx_batch_overflow_;
+	std::deque<std::vector<char>> queued_packets_;
+	size_t rx_staging_begin_ = 0;
+	size_t rx_staging_end_ = 0;
+	// fds received via SCM_RIGHTS, owned until receiveFDs_safe() hands them out
+	std::vector<int> passed_fds_;
+	// offer header waiting for acceptSampleEncoding_safe() (receive side), agreed encoding
+	uint32_t pending_encoding_offer_ = 0;
+	SampleEncoding sample_encoding_ = SampleEncoding::kfloat32;
+	// body words of a hello frame waiting for takeHello_safe(), guarded by receive_mutex_
+	std::vector<uint32_t> pending_hello_;
+	// retry hint of the last busy frame, guarded by receive_mutex_
+	uint32_t rx_retry_after_ms_ = 0;
+	// receiveFloatStreaming_safe(): one slice of the frame being received, never the frame
+	std::vector<float> rx_slice_;
+	// SO_TIMESTAMPNS is on; keeps the rx path on recvmsg(), the multishot ring drops cmsgs
+	bool rx_timestamps_ = false;
+	// ingress time of the latest recvmsg(), steady_clock ns
+	int64_t rx_kernel_ns_ = 0;
+	// timing of the last sample frame, guarded by receive_mutex_
+	FrameInfo rx_frame_info_;
+	// granted frame_metadata and the next sequence number, guarded by send_mutex_
+	bool tx_frame_metadata_ = false;
+	uint32_t tx_frame_sequence_ = 0;
+	// granted max_inflight_chunks (0: no flow control) and unanswered chunks per stream
+	uint32_t credit_window_ = 0;
+	std::unordered_map<StreamId, uint32_t> inflight_chunks_;
 };
 
 }  // namespace network_socket
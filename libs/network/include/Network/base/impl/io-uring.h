@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2025 PotterWhite
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// libs/network/include/Network/base/impl/io-uring.h
+#pragma once
+
+#include "Network/pch.h"
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+struct io_uring_buf_ring;
+
+namespace arcforge {
+namespace embedded {
+namespace network_socket {
+
+/*
+ * @brief Minimal io_uring ring driven through the raw syscalls (no liburing dependency).
+ *        One instance serves one direction of one connection:
+ *          - tx: every part of a frame becomes a linked SEND SQE; the whole chain is
+ *                submitted and reaped with a single io_uring_enter().
+ *          - rx: one multishot RECV keeps filling a ring of registered (provided) buffers;
+ *                receive() copies out of completed buffers and only enters the kernel
+ *                when nothing is buffered.
+ *        Every entry point reports failure instead of throwing, so callers can fall back
+ *        to plain send()/recv() on kernels (or seccomp profiles) without io_uring.
+ */
+class IoUring {
+   public:
+	IoUring();
+	~IoUring();
+
+	// forbid copy and assignment
+	IoUring(const IoUring&) = delete;
+	IoUring& operator=(const IoUring&) = delete;
+
+	// true when this build and the running kernel both provide io_uring (probed once)
+	static bool isSupported();
+
+	bool init(unsigned entries);
+	bool isReady() const;
+
+	// tx: returns the number of leading bytes that reached the socket, or -errno
+	// (-EAGAIN when the send buffer had no room at all)
+	ssize_t sendLinked(int fd, const struct iovec* parts, unsigned count);
+
+	// rx: must be called once before receive()
+	bool enableMultishotReceive(int fd, unsigned buffer_count, unsigned buffer_size);
+	bool isMultishotReceiveEnabled() const;
+	// copies at most max_len bytes; 0 means orderly EOF, <0 is -errno
+	// (-EOPNOTSUPP: kernel refused multishot before any byte was consumed, recv() is safe)
+	// waits at most timeout_ms (-1: forever) for data, -ETIMEDOUT when nothing arrived;
+	// -ECANCELED as soon as cancel_fd (an eventfd, -1 for none) turns readable
+	ssize_t receive(void* dst, size_t max_len, int timeout_ms = -1, int cancel_fd = -1);
+	// data, EOF or an error the multishot receive already took off the socket and receive()
+	// has not handed out yet; the socket no longer polls readable for it
+	bool hasBufferedData() const;
+	// polls readable while completions are waiting: the rx readiness once multishot is armed
+	int getFD() const;
+
+   private:
+	struct Segment {
+		uint16_t buffer_id;
+		size_t length;
+		size_t consumed;
+	};
+
+	struct io_uring_sqe* nextSqe();
+	void submitSqe();
+	int enter(unsigned to_submit, unsigned min_complete, unsigned flags);
+	bool popCqe(struct io_uring_cqe& out);
+	bool armMultishotReceive();
+	void drainReceiveCompletions();
+	void recycleBuffer(uint16_t buffer_id);
+	void release();
+
+   private:
+	static constexpr uint16_t kbuffer_group_id_ = 0x4146;  // "AF"
+
+	int ring_fd_ = -1;
+	void* sq_ring_ptr_ = nullptr;
+	size_t sq_ring_size_ = 0;
+	void* cq_ring_ptr_ = nullptr;
+	size_t cq_ring_size_ = 0;
+	struct io_uring_sqe* sqes_ = nullptr;
+	size_t sqes_size_ = 0;
+
+	unsigned* sq_head_ = nullptr;
+	unsigned* sq_tail_ = nullptr;
+	unsigned sq_mask_ = 0;
+	unsigned* sq_array_ = nullptr;
+	unsigned pending_submissions_ = 0;
+
+	unsigned* cq_head_ = nullptr;
+	unsigned* cq_tail_ = nullptr;
+	unsigned cq_mask_ = 0;
+	struct io_uring_cqe* cqes_ = nullptr;
+
+	// multishot receive state
+	int rx_fd_ = -1;
+	struct io_uring_buf_ring* buffer_ring_ = nullptr;
+	size_t buffer_ring_size_ = 0;
+	unsigned buffer_count_ = 0;
+	unsigned buffer_size_ = 0;
+	uint16_t buffer_ring_tail_ = 0;
+	std::unique_ptr<char[]> buffer_storage_;
+	std::deque<Segment> segments_;
+	bool rx_armed_ = false;
+	bool rx_eof_ = false;
+	bool rx_delivered_any_ = false;
+	int rx_error_ = 0;
+};
+
+}  // namespace network_socket
+}  // namespace embedded
+}  // namespace arcforge
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2025 PotterWhite
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// libs/network/include/Network/client/client-pool.h
+#pragma once
+
+#include "Network/client/client.h"
+#include "Network/common/common-types.h"
+#include "Network/pch.h"
+
+#include <condition_variable>
+
+namespace arcforge {
+namespace embedded {
+namespace network_socket {
+
+// where and how the pooled connections are opened
+struct ClientPoolConfig {
+	// Unix-domain endpoint, used unless tcp_port is set
+	std::string socket_path;
+	std::string tcp_host;
+	uint16_t tcp_port = 0;
+	TcpOptions tcp_options;
+	SocketType socket_type = SocketType::kstream;
+	// sent as the hello of every connection
+	StreamParams params;
+	// connections kept open, leased and idle together
+	size_t size = 2;
+	// attempts of one connect + handshake before acquire() gives up
+	uint32_t connect_attempts = 3;
+	std::chrono::milliseconds retry_backoff{50};
+};
+
+class ClientPool;
+
+// hands its connection back to the owning pool when it goes out of scope
+struct ClientRecycler {
+	std::shared_ptr<ClientPool> pool;
+	void operator()(ClientBase* client) const;
+};
+using PooledClient = std::unique_ptr<ClientBase, ClientRecycler>;
+
+/*
+ * @brief Connected, handshaken client connections kept warm for short requests.
+ *        A request leases one connection per utterance: it streams its chunks, sends the EOF
+ *        marker, drains its results and lets the lease go. The connection then waits for the
+ *        next request instead of paying socket(), connect() and the hello again.
+ *        A connection the server dropped while idle is replaced inside acquire(); one that
+ *        failed during a lease is replaced by reconnect(). A lease returned with the socket
+ *        closed, unread data or results still in flight is dropped, not reused.
+ */
+class ClientPool : public std::enable_shared_from_this<ClientPool> {
+   public:
+	static std::shared_ptr<ClientPool> create(const ClientPoolConfig& config);
+
+	// forbid copy and assignment
+	ClientPool(const ClientPool&) = delete;
+	ClientPool& operator=(const ClientPool&) = delete;
+
+	// opens connections until config.size are up, so the first requests find them warm
+	SocketReturnValue warmUp();
+	// an idle connection if there is one, a new one while the pool is below its size,
+	// otherwise waits for a lease to come back until deadline (kio_timeout)
+	SocketReturnValue acquire(PooledClient& client, Deadline deadline = kno_deadline);
+	// swaps a leased connection that failed (e.g. kpeer_abnormally_closed) for a fresh one;
+	// the utterance in progress is lost and has to be sent again
+	SocketReturnValue reconnect(PooledClient& client);
+	// grant of the most recent handshake
+	SessionGrant getGrant();
+	size_t idleCount();
+	size_t leasedCount();
+	// closes the idle connections, leases still out are closed when they come back and
+	// later acquire() calls fail with kpool_closed
+	void close();
+
+   private:
+	explicit ClientPool(const ClientPoolConfig& config);
+	void recycle(ClientBase* client);
+	friend struct ClientRecycler;
+
+	SocketReturnValue openConnection(std::unique_ptr<ClientBase>& client,
+	                                 uint32_t& full_credits);
+	bool isReusable(ClientBase& client, uint32_t full_credits);
+
+   private:
+	// an idle connection and its credits right after the handshake
+	struct IdleClient {
+		std::unique_ptr<ClientBase> client;
+		uint32_t full_credits = kunlimited_send_credits;
+	};
+
+	const ClientPoolConfig config_;
+	std::mutex mutex_;
+	std::condition_variable released_;
+	std::vector<IdleClient> idle_;
+	std::unordered_map<const ClientBase*, uint32_t> leased_;
+	// connections being opened outside the lock, counted against config_.size
+	size_t opening_ = 0;
+	bool closed_ = false;
+	SessionGrant grant_;
+};
+
+}  // namespace network_socket
+}  // namespace embedded
+}  // namespace arcforge
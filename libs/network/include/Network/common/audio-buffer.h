@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2025 PotterWhite
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// libs/network/include/Network/common/audio-buffer.h
+#pragma once
+
+#include "Network/pch.h"
+
+namespace arcforge {
+namespace embedded {
+namespace network_socket {
+
+/*
+ * @brief Reusable float storage for received audio frames.
+ *        Unlike std::vector<float>::resize() it never value-initialises: receive paths
+ *        overwrite every sample anyway, so growing only allocates and shrinking is free.
+ */
+class AudioBuffer {
+   public:
+	AudioBuffer() = default;
+	explicit AudioBuffer(size_t capacity);
+	~AudioBuffer() = default;
+
+	// forbid copy, permit move
+	AudioBuffer(const AudioBuffer&) = delete;
+	AudioBuffer& operator=(const AudioBuffer&) = delete;
+	AudioBuffer(AudioBuffer&&) noexcept = default;
+	AudioBuffer& operator=(AudioBuffer&&) noexcept = default;
+
+	// contents are unspecified after growing past capacity()
+	void resize(size_t count);
+	void reserve(size_t capacity);
+	void clear() { size_ = 0; }
+
+	float* data() { return storage_.get(); }
+	const float* data() const { return storage_.get(); }
+	size_t size() const { return size_; }
+	size_t capacity() const { return capacity_; }
+	bool empty() const { return size_ == 0; }
+
+   private:
+	std::unique_ptr<float[]> storage_;
+	size_t size_ = 0;
+	size_t capacity_ = 0;
+};
+
+class AudioBufferPool;
+
+// returns its buffer to the owning pool when it goes out of scope
+struct AudioBufferRecycler {
+	std::shared_ptr<AudioBufferPool> pool;
+	void operator()(AudioBuffer* buffer) const;
+};
+using PooledAudioBuffer = std::unique_ptr<AudioBuffer, AudioBufferRecycler>;
+
+/*
+ * @brief Thread-safe free list of AudioBuffers, one per connection.
+ *        Steady-state streaming acquires and recycles the same few buffers, so the
+ *        per-chunk hot path never reaches the allocator.
+ */
+class AudioBufferPool : public std::enable_shared_from_this<AudioBufferPool> {
+   public:
+	static std::shared_ptr<AudioBufferPool> create(size_t max_cached = 4);
+
+	// forbid copy and assignment
+	AudioBufferPool(const AudioBufferPool&) = delete;
+	AudioBufferPool& operator=(const AudioBufferPool&) = delete;
+
+	PooledAudioBuffer acquire(size_t min_capacity = 0);
+	size_t cachedCount();
+
+   private:
+	explicit AudioBufferPool(size_t max_cached);
+	void recycle(AudioBuffer* buffer);
+	friend struct AudioBufferRecycler;
+
+   private:
+	std::mutex mutex_;
+	std::vector<std::unique_ptr<AudioBuffer>> free_list_;
+	size_t max_cached_;
+};
+
+}  // namespace network_socket
+}  // namespace embedded
+}  // namespace arcforge
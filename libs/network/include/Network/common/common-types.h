@@ -33,6 +33,116 @@ extern const std::string_view kcurrent_lib_name;
 class Base;
 
 enum class SocketStatus { kvalid = 0x31, kinvalid = 0x32, kunknowerror = 0x3f };
+// transport used by the send/receive paths of one connection
+enum class IoBackend { kposix = 0x21, kio_uring = 0x22 };
+// kstream: length-prefixed frames over SOCK_STREAM
+// kseqpacket: SOCK_SEQPACKET, one frame is exactly one message (no reassembly)
+enum class SocketType { kstream = 0x11, kseqpacket = 0x12 };
+// how a connection reaches its peer: a Unix-domain socket path or TCP over IPv4/IPv6
+enum class TransportFamily { kunix = 0x51, ktcp = 0x52 };
+// applied to every TCP connection, accepted ones included; 0 keeps the kernel default
+struct TcpOptions {
+	// chunks and results are small and latency bound, Nagle only delays them
+	bool no_delay = true;
+	int send_buffer_bytes = 0;
+	int receive_buffer_bytes = 0;
+	// notice a vanished front-end device instead of holding its session forever
+	bool keepalive = true;
+	int keepalive_idle_s = 30;
+	int keepalive_interval_s = 10;
+	int keepalive_count = 3;
+};
+// sample format of audio frames on the wire, agreed per connection (see
+// Base::negotiateSampleEncoding). kmulaw is G.711 µ-law: a quarter of the bytes, lossy.
+enum class SampleEncoding { kfloat32 = 0x41, kpcm16 = 0x42, kmulaw = 0x43 };
+// revision of the framing, exchanged in the session handshake (see Base::handshake)
+// 1: hello/welcome  2: multiplexed streams
+inline constexpr uint32_t kprotocol_version = 2;
+// logical session on a multiplexed connection
+using StreamId = uint16_t;
+// stream parameters a client declares in its hello frame
+struct StreamParams {
+	uint32_t protocol_version = kprotocol_version;
+	uint32_t sample_rate = 16000;
+	SampleEncoding encoding = SampleEncoding::kfloat32;
+	uint32_t chunk_duration_ms = 100;
+	// results may lag behind the chunks instead of answering each one in turn
+	bool pipelined_results = false;
+	// logical sessions carried by the connection; above 1, frames go through the
+	// Base::sendStream*()/receiveStreamFrame() family
+	uint32_t max_streams = 1;
+	// audio and results decoupled: the server takes chunks as they come and pushes a
+	// ResultMessage whenever the decoder has something (see Base::receiveResult()).
+	// Single-stream connections only.
+	bool push_results = false;
+	// non-empty single-stream sample frames carry a sequence number and their send time,
+	// read back on the other side through Base::getLastFrameInfo()
+	bool frame_metadata = false;
+};
+// the server's answer: the parameters it accepted and the limits of this session
+struct SessionGrant {
+	StreamParams params;
+	uint32_t max_frame_samples = 0;
+	// credit window: sample frames a session may have sent without their result yet; every
+	// result returns one credit (see Base::getSendCredits)
+	uint32_t max_inflight_chunks = 1;
+	uint32_t idle_timeout_ms = 0;
+};
+// one frame of a multiplexed connection, see Base::receiveStreamFrame()
+enum class StreamFrameKind { ksamples = 0x01, ktext = 0x02 };
+struct StreamFrame {
+	StreamId stream = 0;
+	StreamFrameKind kind = StreamFrameKind::ksamples;
+	SampleEncoding encoding = SampleEncoding::kfloat32;
+	// samples (ksamples) or bytes (ktext) at the front of payload
+	size_t count = 0;
+	// reused across frames: grows to the largest frame seen and is never shrunk
+	std::vector<char> payload;
+};
+// timing of the last sample frame a single-frame receive returned (see
+// Base::getLastFrameInfo()). Times are steady_clock nanoseconds, i.e. CLOCK_MONOTONIC, which
+// the processes of one host share; 0 when unknown.
+struct FrameInfo {
+	// set by the sender when its session was granted frame_metadata
+	bool has_metadata = false;
+	uint32_t sequence = 0;
+	int64_t sent_ns = 0;
+	// kernel ingress time reported for the read that brought the frame header, see
+	// Base::setReceiveTimestamps()
+	int64_t kernel_rx_ns = 0;
+};
+// server-pushed recognition result: partials may be revised, a final closes a segment (e.g. at
+// an endpoint), kend_of_utterance is the final the server sends once it has processed the
+// client's end-of-utterance marker and is always the last result of the utterance
+enum class ResultKind { kpartial = 0x01, kfinal = 0x02, kend_of_utterance = 0x03 };
+struct ResultMessage {
+	ResultKind kind = ResultKind::kpartial;
+	// sample frames the decoder consumed since the previous result, each returns one credit
+	uint32_t acknowledged_chunks = 0;
+	std::string text;
+};
+// the process at the other end of a Unix-domain connection, as the kernel saw it at connect()
+struct PeerCredentials {
+	pid_t pid = 0;
+	uid_t uid = static_cast<uid_t>(-1);
+	gid_t gid = static_cast<gid_t>(-1);
+};
+// part of a float frame handed over by Base::receiveFloatStreaming() while the rest of the
+// frame is still arriving; samples point into the connection's slice buffer and are only
+// valid during the call
+struct SampleSlice {
+	const float* samples = nullptr;
+	size_t count = 0;
+	// position of the slice within its frame, and the frame's full length
+	size_t offset = 0;
+	uint32_t frame_count = 0;
+};
+using SampleSliceHandler = std::function<void(const SampleSlice& slice)>;
+// getSendCredits() of a connection without a credit window
+inline constexpr uint32_t kunlimited_send_credits = std::numeric_limits<uint32_t>::max();
+// absolute point in time a timed send/receive gives up at, see Base::receiveFloat()
+using Deadline = std::chrono::steady_clock::time_point;
+inline constexpr Deadline kno_deadline = Deadline::max();
 enum class SocketReturnValue {
 	ksuccess = 0x49,
 	// ***************************
@@ -40,16 +150,23 @@ enum class SocketReturnValue {
 	kreceived_null = 0x50,
 	kreceived_illegal = 0x51,
 	kreceivelength_failed = 0x52,
+	kreceived_fds = 0x53,
+	kreceived_encoding_offer = 0x54,
+	kreceived_hello = 0x55,
+	kserver_busy = 0x56,
 	// --- send opts errors ---
 	ksendcount_failed = 0x60,
 	ksenddata_failed = 0x61,
 	ksendlength_failed = 0x62,
+	kno_send_credit = 0x63,
 	// --- configuration errors ---
 	kcount_too_large = 0x70,
 	kempty_string = 0x71,
 	kfd_illegal = 0x72,
 	keof = 0x73,
 	ksocketpath_empty = 0x74,
+	kbuffer_too_small = 0x75,
+	ksample_encoding_mismatch = 0x76,
 	// --- posix api errors ---
 	kconnect_server_failed = 0x80,
 	klisten_error = 0x81,
@@ -57,8 +174,14 @@ enum class SocketReturnValue {
 	kpeer_abnormally_closed = 0x83,
 	kaccept_timeout = 0x84,
 	ksetsocketopt_error = 0x85,
+	kepoll_error = 0x86,
+	kio_timeout = 0x87,
+	kpool_closed = 0x88,
+	kcancelled = 0x89,
+	kpeer_credentials_unavailable = 0x8a,
 	// --- impl layer errors ---
 	kimpl_nullptr_error = 0x90,
+	kio_backend_unavailable = 0x91,
 	// ***************************
 	kinit_state = 0xff,
 	kunknownerror = 0x100
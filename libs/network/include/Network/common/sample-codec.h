@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2025 PotterWhite
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// libs/network/include/Network/common/sample-codec.h
+#pragma once
+
+#include "Network/pch.h"
+
+namespace arcforge {
+namespace embedded {
+namespace network_socket {
+
+/*
+ * @brief Conversions between the float samples the recognizer consumes and the compact wire
+ *        encodings (see SampleEncoding). Floats use the WavReader scale: int16 / 32768.
+ *        The int16 kernels use SSE2 / NEON when the target has them.
+ */
+// widening is exact
+void ConvertPcm16ToFloat(const int16_t* src, float* dst, size_t count);
+// rounds to nearest and saturates outside [-1, 1)
+void ConvertFloatToPcm16(const float* src, int16_t* dst, size_t count);
+// G.711 µ-law, decoded through a 256-entry table
+void ConvertMulawToFloat(const uint8_t* src, float* dst, size_t count);
+void ConvertFloatToMulaw(const float* src, uint8_t* dst, size_t count);
+
+}  // namespace network_socket
+}  // namespace embedded
+}  // namespace arcforge
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2025 PotterWhite
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "Network/common/common-types.h"
+#include "Network/pch.h"
+
+namespace arcforge {
+namespace embedded {
+namespace network_socket {
+
+// forward declaration of PIMPL implementation class
+class EventLoopImpl;
+
+// readiness flags handed to EventCallback (thin aliases of the epoll flags)
+inline constexpr uint32_t kevent_readable = EPOLLIN;
+inline constexpr uint32_t kevent_writable = EPOLLOUT;
+inline constexpr uint32_t kevent_hangup = EPOLLHUP | EPOLLRDHUP;
+inline constexpr uint32_t kevent_error = EPOLLERR;
+
+/*
+ * @brief Single-threaded epoll reactor.
+ *        Any number of fds (listening socket and client sockets alike) are multiplexed
+ *        on one thread, each with its own readiness callback. Callbacks run on the thread
+ *        that calls run()/runOnce(); they may add, modify or remove fds (including their own).
+ *        A client socket whose receives read ahead is registered with a pending check, see
+ *        the addFD() overload. stop() and wakeup() are thread-safe and async-signal-safe.
+ */
+class EventLoop {
+   public:
+	using EventCallback = std::function<void(uint32_t events)>;
+	// input the fd itself no longer shows, e.g. Base::hasBufferedData(); called on the loop
+	// thread while the fd is watched for kevent_readable, it must not call into the loop
+	using PendingCheck = std::function<bool()>;
+
+	EventLoop();
+	~EventLoop();
+
+	// copy constructor and operator
+	EventLoop(const EventLoop&) = delete;
+	EventLoop& operator=(const EventLoop&) = delete;
+
+	// std::move constructor and operator
+	EventLoop(EventLoop&&) noexcept;
+	EventLoop& operator=(EventLoop&&) noexcept;
+
+	// interest list management (level-triggered)
+	SocketReturnValue addFD(int fd, uint32_t events, EventCallback callback);
+	// while has_pending returns true the loop does not block and reports fd readable, so a
+	// connection whose next frames were already read ahead is not left waiting on epoll
+	SocketReturnValue addFD(int fd, uint32_t events, EventCallback callback,
+	                        PendingCheck has_pending);
+	SocketReturnValue modifyFD(int fd, uint32_t events);
+	SocketReturnValue removeFD(int fd);
+
+	// dispatch
+	// waits at most timeout_ms (-1 means forever) and dispatches every ready fd once
+	SocketReturnValue runOnce(int timeout_ms);
+	// dispatches until stop() is called; returns at once if stop() came before it
+	SocketReturnValue run();
+	void stop();
+	void wakeup();
+	bool isStopped() const;
+
+   private:
+	std::unique_ptr<EventLoopImpl> impl_;
+};
+
+}  // namespace network_socket
+}  // namespace embedded
+}  // namespace arcforge
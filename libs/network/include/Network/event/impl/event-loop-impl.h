@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2025 PotterWhite
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// libs/network/include/Network/event/impl/event-loop-impl.h
+#pragma once
+
+#include "Network/common/common-types.h"
+#include "Network/event/event-loop.h"
+#include "Network/pch.h"
+
+namespace arcforge {
+namespace embedded {
+namespace network_socket {
+
+class EventLoopImpl {
+   public:
+	EventLoopImpl();
+	~EventLoopImpl();
+
+	// forbid copy and assignment
+	EventLoopImpl(const EventLoopImpl&) = delete;
+	EventLoopImpl& operator=(const EventLoopImpl&) = delete;
+
+	SocketReturnValue addFD_safe(int fd, uint32_t events, EventLoop::EventCallback callback,
+	                             EventLoop::PendingCheck has_pending);
+	SocketReturnValue modifyFD_safe(int fd, uint32_t events);
+	SocketReturnValue removeFD_safe(int fd);
+
+	SocketReturnValue runOnce(int timeout_ms);
+	SocketReturnValue run();
+	void stop();
+	void wakeup();
+	bool isStopped() const;
+
+   private:
+	void drainWakeupFD();
+
+   private:
+	// shared_ptr so a callback stays alive while it is running even if it removes itself
+	using CallbackHolder = std::shared_ptr<EventLoop::EventCallback>;
+	struct Handler {
+		CallbackHolder callback;
+		EventLoop::PendingCheck has_pending;
+		// the interest set, has_pending is only asked while it includes kevent_readable
+		uint32_t events = 0;
+	};
+
+	static constexpr int kmax_events_per_wait_ = 64;
+
+	int epoll_fd_ = -1;
+	int wakeup_fd_ = -1;
+	std::atomic<bool> stop_flag_{false};
+	std::mutex handlers_mutex_;
+	std::unordered_map<int, Handler> handlers_;
+	std::vector<struct epoll_event> ready_events_;
+	// fds whose has_pending held before the wait, reused across runOnce() calls
+	std::vector<int> pending_fds_;
+};
+
+}  // namespace network_socket
+}  // namespace embedded
+}  // namespace arcforge
@@ -24,14 +24,33 @@
 
 // #include "common/common-types.h"  //public enum class definitions
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>  //steady_clock deadlines
+#include <climits>
+#include <cmath>
 #include <cstring>  //strerror
+#include <deque>
+#include <fcntl.h>     //fcntl() O_NONBLOCK
+#include <functional>  //std::function
 #include <iostream>
+#include <limits>
+#include <netdb.h>  //getaddrinfo()
+#include <netinet/in.h>
+#include <netinet/tcp.h>  //TCP_NODELAY TCP_KEEPIDLE
 #include <memory>     // For std::unique_ptr (though direct return is fine here)
+#include <poll.h>
 #include <sstream>    //std::ostringstream
 #include <stdexcept>  // For std::runtime_error
 #include <string>     
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>  //mmap() memfd_create()
 #include <sys/socket.h>
+#include <sys/uio.h>  //struct iovec
 #include <sys/un.h>
 #include <unistd.h>  //read() close()
+#include <unordered_map>
 #include <vector>    // Potentially useful if a config can have lists
 #include <mutex>
\ No newline at end of file
@@ -23,6 +23,7 @@
 #pragma once
 #include "Network/base/base.h"
 #include "Network/common/common-types.h"
+#include "Network/event/event-loop.h"
 #include "Network/pch.h"
 
 namespace arcforge {
@@ -31,8 +32,37 @@ namespace network_socket {
 
 class ServerBase : public Base {
    public:
+	using AcceptHandler = std::function<void(std::unique_ptr<Base>)>;
+
 	ServerBase();
 	~ServerBase();
+
+	/*------------------------------------------
+	 * event-driven mode
+	 *   The listening fd is switched to non-blocking and registered on getEventLoop().
+	 *   Every readiness notification drains all pending connections into on_accept,
+	 *   so startServer() needs no SO_RCVTIMEO in this mode.
+	 *   Client connections may be registered on the same loop to multiplex them on one
+	 *   thread: watch getReadinessFD() with hasBufferedData() as the pending check (see
+	 *   EventLoop::addFD()), a receive reads ahead past the frame it returns.
+	 ---------------------------------------------*/
+	SocketReturnValue enableEventMode(AcceptHandler on_accept);
+	void disableEventMode();
+	// back-pressure: stop watching the listening fd while no more clients can be served
+	SocketReturnValue setAccepting(bool accepting);
+	// enableEventMode() + getEventLoop().run(), returns after stop()
+	SocketReturnValue run(AcceptHandler on_accept);
+	void stop();
+	EventLoop& getEventLoop();
+
+   private:
+	void onListeningFDReady(uint32_t events);
+
+   private:
+	std::unique_ptr<EventLoop> event_loop_;
+	AcceptHandler on_accept_;
+	int watched_fd_ = -1;
+	bool accepting_ = false;
 };
 
 }  // namespace network_socket
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2025 PotterWhite
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// libs/network/include/Network/shm/impl/shm-channel-impl.h
+#pragma once
+
+#include "Network/common/common-types.h"
+#include "Network/pch.h"
+
+namespace arcforge {
+namespace embedded {
+namespace network_socket {
+
+// lives at offset 0 of the memfd, the sample records follow at kshm_data_offset
+struct ShmRingHeader {
+	uint32_t magic;
+	uint32_t version;
+	uint64_t capacity;
+	// producer cache line
+	alignas(64) std::atomic<uint64_t> write_pos;
+	std::atomic<uint32_t> reader_waiting;
+	// consumer cache line
+	alignas(64) std::atomic<uint64_t> read_pos;
+	std::atomic<uint32_t> writer_waiting;
+	alignas(64) std::atomic<uint32_t> closed;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "shm ring positions must be lock-free to be shared across processes");
+
+inline constexpr uint32_t kshm_magic = 0x41465352;  // "AFSR"
+inline constexpr uint32_t kshm_version = 1;
+inline constexpr size_t kshm_data_offset = (sizeof(ShmRingHeader) + 63) & ~size_t{63};
+// record header: [u32 count][u32 reserved], samples follow 8-byte aligned
+inline constexpr size_t kshm_record_header = 8;
+inline constexpr uint32_t kshm_wrap_marker = 0xFFFFFFFFu;
+
+class ShmChannelImpl {
+   public:
+	ShmChannelImpl(bool is_writer, int control_fd);
+	~ShmChannelImpl();
+
+	// forbid copy and assignment
+	ShmChannelImpl(const ShmChannelImpl&) = delete;
+	ShmChannelImpl& operator=(const ShmChannelImpl&) = delete;
+
+	SocketReturnValue create(size_t capacity_bytes);
+	SocketReturnValue attach(const std::vector<int>& fds);
+	std::vector<int> passableFDs() const;
+
+	SocketReturnValue sendFloat(const float* data, size_t count);
+	SocketReturnValue peekFloat(const float*& samples, size_t& count);
+	void releaseFloat();
+	int readinessFD() const;
+	bool armReadiness();
+	void close();
+
+   private:
+	bool waitFor(int event_fd, std::atomic<uint32_t>& waiting_flag,
+	             const std::function<bool()>& ready);
+	static void notify(int event_fd, std::atomic<uint32_t>& waiting_flag);
+	static size_t recordSize(size_t count);
+	char* data() const;
+	void release();
+
+   private:
+	bool is_writer_;
+	int control_fd_;
+	int memfd_ = -1;
+	int data_event_fd_ = -1;   // writer -> reader: samples available
+	int space_event_fd_ = -1;  // reader -> writer: space freed
+	void* mapping_ = nullptr;
+	size_t mapping_size_ = 0;
+	ShmRingHeader* header_ = nullptr;
+	uint64_t capacity_ = 0;
+	uint64_t pending_release_ = 0;
+	bool peer_gone_ = false;
+};
+
+}  // namespace network_socket
+}  // namespace embedded
+}  // namespace arcforge
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2025 PotterWhite
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// libs/network/include/Network/shm/shm-channel.h
+#pragma once
+
+#include "Network/base/base.h"
+#include "Network/common/audio-buffer.h"
+#include "Network/common/common-types.h"
+#include "Network/pch.h"
+
+namespace arcforge {
+namespace embedded {
+namespace network_socket {
+
+// forward declaration of PIMPL implementation class
+class ShmChannelImpl;
+
+inline constexpr size_t kshm_default_capacity = 256 * 1024;
+
+/*
+ * @brief One-way, same-host audio transport over a memfd-backed SPSC ring.
+ *        The writer creates the ring plus two eventfds and passes them over an already
+ *        connected Base (SCM_RIGHTS); after that, samples never go through the kernel.
+ *        eventfds are only written while the other side is actually asleep.
+ *        Frame semantics follow Base::sendFloat()/receiveFloat(): an empty frame is EOF.
+ *        Results, control traffic, etc. keep using the socket.
+ */
+class ShmChannel {
+   public:
+	// writer side: creates the ring and waits for the peer to map it
+	static SocketReturnValue offer(Base& control, std::unique_ptr<ShmChannel>& channel,
+	                               size_t capacity_bytes = kshm_default_capacity);
+	// reader side: maps the ring passed by offer(), e.g. after receiveFloat() saw kreceived_fds
+	static SocketReturnValue accept(Base& control, std::unique_ptr<ShmChannel>& channel);
+
+	~ShmChannel();
+
+	// copy constructor and operator
+	ShmChannel(const ShmChannel&) = delete;
+	ShmChannel& operator=(const ShmChannel&) = delete;
+
+	// std::move constructor and operator
+	ShmChannel(ShmChannel&&) noexcept;
+	ShmChannel& operator=(ShmChannel&&) noexcept;
+
+	// writer
+	SocketReturnValue sendFloat(const float* data, size_t count);
+	SocketReturnValue sendFloat(const std::vector<float>& data);
+
+	// reader, copying
+	SocketReturnValue receiveFloat(std::vector<float>& data);
+	SocketReturnValue receiveFloat(AudioBuffer& buffer);
+
+	// reader, zero-copy: samples point into the shared ring and stay valid until
+	// releaseFloat() (or the next peek, which releases implicitly)
+	SocketReturnValue peekFloat(const float*& samples, size_t& count);
+	void releaseFloat();
+	// reader driven by an event loop rather than blocking in peekFloat(): the fd the writer
+	// signals once armed. armReadiness() returns true when a frame (or the close) is already
+	// there, which is not signalled; read it instead of waiting.
+	int getReadinessFD() const;
+	bool armReadiness();
+
+	// wakes up both sides; the peer sees kpeer_abnormally_closed once the ring is drained
+	void close();
+
+   private:
+	explicit ShmChannel(std::unique_ptr<ShmChannelImpl>);
+	std::unique_ptr<ShmChannelImpl> impl_;
+};
+
+}  // namespace network_socket
+}  // namespace embedded
+}  // namespace arcforge
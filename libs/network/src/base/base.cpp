@@ -50,6 +50,19 @@ void Base::closeSocket() {
 	}
 }
 
+void Base::cancel() {
+	if (impl_ != nullptr) {
+		impl_->cancel();
+	}
+}
+
+bool Base::isCancelled() const {
+	if (impl_ != nullptr) {
+		return impl_->isCancelled();
+	}
+	return false;
+}
+
 int Base::getFD() const {
 	if (impl_ != nullptr) {
 		return impl_->getFD_safe();
@@ -78,6 +91,81 @@ void Base::setSocketPath(const std::string& path) {
 	}
 }
 
+SocketReturnValue Base::setIoBackend(IoBackend backend) {
+	if (impl_ != nullptr) {
+		return impl_->setIoBackend_safe(backend);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+IoBackend Base::getIoBackend() const {
+	if (impl_ != nullptr) {
+		return impl_->getIoBackend_safe();
+	}
+	return IoBackend::kposix;
+}
+
+SocketReturnValue Base::setSocketType(SocketType type) {
+	if (impl_ != nullptr) {
+		return impl_->setSocketType_safe(type);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketType Base::getSocketType() const {
+	if (impl_ != nullptr) {
+		return impl_->getSocketType_safe();
+	}
+	return SocketType::kstream;
+}
+
+void Base::setTcpEndpoint(const std::string& host, uint16_t port) {
+	if (impl_ != nullptr) {
+		impl_->setTcpEndpoint_safe(host, port);
+	}
+}
+
+void Base::setTcpOptions(const TcpOptions& options) {
+	if (impl_ != nullptr) {
+		impl_->setTcpOptions_safe(options);
+	}
+}
+
+TransportFamily Base::getTransportFamily() const {
+	if (impl_ != nullptr) {
+		return impl_->getTransportFamily_safe();
+	}
+	return TransportFamily::kunix;
+}
+
+uint16_t Base::getLocalPort() const {
+	if (impl_ != nullptr) {
+		return impl_->getLocalPort_safe();
+	}
+	return 0;
+}
+
+SocketReturnValue Base::getPeerCredentials(PeerCredentials& credentials) const {
+	if (impl_ != nullptr) {
+		return impl_->getPeerCredentials_safe(credentials);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::setReceiveTimestamps(bool enable) {
+	if (impl_ != nullptr) {
+		return impl_->setReceiveTimestamps_safe(enable);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+FrameInfo Base::getLastFrameInfo() const {
+	if (impl_ != nullptr) {
+		return impl_->getLastFrameInfo_safe();
+	}
+	return FrameInfo();
+}
+
 SocketReturnValue Base::sendFloat(const std::vector<float>& data) {
 	if (impl_) {  // Always check if impl_ is valid
 		return impl_->sendFloat_safe(data);
@@ -94,6 +182,38 @@ SocketReturnValue Base::receiveFloat(std::vector<float>& data) {
 	return SocketReturnValue::kimpl_nullptr_error;
 }
 
+SocketReturnValue Base::receiveFloat(AudioBuffer& buffer) {
+	if (impl_) {
+		return impl_->receiveFloat_safe(buffer);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::receiveFloat(float* dst, size_t capacity, size_t& count) {
+	if (impl_) {
+		return impl_->receiveFloat_safe(dst, capacity, count);
+	}
+	count = 0;
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::receiveFloat(PooledAudioBuffer& buffer) {
+	if (impl_ == nullptr) {
+		return SocketReturnValue::kimpl_nullptr_error;
+	}
+	if (buffer == nullptr) {
+		buffer = impl_->getBufferPool_safe()->acquire();
+	}
+	return impl_->receiveFloat_safe(*buffer);
+}
+
+std::shared_ptr<AudioBufferPool> Base::getBufferPool() {
+	if (impl_ != nullptr) {
+		return impl_->getBufferPool_safe();
+	}
+	return nullptr;
+}
+
 SocketReturnValue Base::sendString(const std::string& message) {
 	if (impl_) {
 		return impl_->sendString_safe(message);
@@ -108,6 +228,266 @@ SocketReturnValue Base::receiveString(std::string& message) {
 	return SocketReturnValue::kimpl_nullptr_error;
 }
 
+SocketReturnValue Base::sendFloat(const std::vector<float>& data, Deadline deadline) {
+	if (impl_) {
+		return impl_->sendFloat_safe(data, deadline);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::receiveFloat(std::vector<float>& data, Deadline deadline) {
+	if (impl_) {
+		return impl_->receiveFloat_safe(data, deadline);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::receiveFloat(AudioBuffer& buffer, Deadline deadline) {
+	if (impl_) {
+		return impl_->receiveFloat_safe(buffer, deadline);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::receiveFloatBatch(std::vector<AudioBuffer>& frames, size_t& frame_count) {
+	if (impl_) {
+		return impl_->receiveFloatBatch_safe(frames, frame_count);
+	}
+	frame_count = 0;
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::receiveFloatBatch(std::vector<AudioBuffer>& frames, size_t& frame_count,
+                                          Deadline deadline) {
+	if (impl_) {
+		return impl_->receiveFloatBatch_safe(frames, frame_count, deadline);
+	}
+	frame_count = 0;
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::sendFloatBatch(const std::vector<std::vector<float>>& frames,
+                                       size_t& frames_sent) {
+	if (impl_) {
+		return impl_->sendFloatBatch_safe(frames, frames_sent);
+	}
+	frames_sent = 0;
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::sendFloatBatch(const std::vector<std::vector<float>>& frames,
+                                       size_t& frames_sent, Deadline deadline) {
+	if (impl_) {
+		return impl_->sendFloatBatch_safe(frames, frames_sent, deadline);
+	}
+	frames_sent = 0;
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::receiveFloat(float* dst, size_t capacity, size_t& count,
+                                     Deadline deadline) {
+	if (impl_) {
+		return impl_->receiveFloat_safe(dst, capacity, count, deadline);
+	}
+	count = 0;
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::sendString(const std::string& message, Deadline deadline) {
+	if (impl_) {
+		return impl_->sendString_safe(message, deadline);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::receiveString(std::string& message, Deadline deadline) {
+	if (impl_) {
+		return impl_->receiveString_safe(message, deadline);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::sendPcm16(const std::vector<int16_t>& samples) {
+	if (impl_) {
+		return impl_->sendPcm16_safe(samples.data(), samples.size());
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::sendPcm16(const std::vector<int16_t>& samples, Deadline deadline) {
+	if (impl_) {
+		return impl_->sendPcm16_safe(samples.data(), samples.size(), deadline);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::receivePcm16(std::vector<int16_t>& samples) {
+	if (impl_) {
+		return impl_->receivePcm16_safe(samples);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::receivePcm16(std::vector<int16_t>& samples, Deadline deadline) {
+	if (impl_) {
+		return impl_->receivePcm16_safe(samples, deadline);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::sendMulaw(const std::vector<uint8_t>& samples) {
+	if (impl_) {
+		return impl_->sendMulaw_safe(samples.data(), samples.size());
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::receiveMulaw(std::vector<uint8_t>& samples) {
+	if (impl_) {
+		return impl_->receiveMulaw_safe(samples);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::receiveMulaw(std::vector<uint8_t>& samples, Deadline deadline) {
+	if (impl_) {
+		return impl_->receiveMulaw_safe(samples, deadline);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::negotiateSampleEncoding(SampleEncoding preferred,
+                                                SampleEncoding& agreed) {
+	if (impl_) {
+		return impl_->negotiateSampleEncoding_safe(preferred, agreed);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::acceptSampleEncoding(SampleEncoding& agreed) {
+	if (impl_) {
+		return impl_->acceptSampleEncoding_safe(agreed);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SampleEncoding Base::getSampleEncoding() const {
+	if (impl_) {
+		return impl_->getSampleEncoding_safe();
+	}
+	return SampleEncoding::kfloat32;
+}
+
+SocketReturnValue Base::handshake(const StreamParams& requested, SessionGrant& granted) {
+	if (impl_) {
+		return impl_->handshake_safe(requested, granted);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::takeHello(StreamParams& requested) {
+	if (impl_) {
+		return impl_->takeHello_safe(requested);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::answerHello(const SessionGrant& granted) {
+	if (impl_) {
+		return impl_->answerHello_safe(granted);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::sendBusy(std::chrono::milliseconds retry_after) {
+	if (impl_) {
+		const auto clamped = std::clamp<std::chrono::milliseconds::rep>(
+		    retry_after.count(), 0, std::numeric_limits<uint32_t>::max());
+		return impl_->sendBusy_safe(static_cast<uint32_t>(clamped));
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+std::chrono::milliseconds Base::getRetryAfter() const {
+	if (impl_) {
+		return std::chrono::milliseconds(impl_->getRetryAfter_safe());
+	}
+	return std::chrono::milliseconds(0);
+}
+
+bool Base::hasBufferedData() const {
+	if (impl_) {
+		return impl_->hasBufferedData_safe();
+	}
+	return false;
+}
+
+int Base::getReadinessFD() const {
+	if (impl_) {
+		return impl_->getReadinessFD_safe();
+	}
+	return -1;
+}
+
+SocketReturnValue Base::sendStreamFloat(StreamId stream, const std::vector<float>& data) {
+	if (impl_) {
+		return impl_->sendStreamSamples_safe(stream, SampleEncoding::kfloat32, data.data(),
+		                                     data.size());
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::sendStreamPcm16(StreamId stream, const std::vector<int16_t>& samples) {
+	if (impl_) {
+		return impl_->sendStreamSamples_safe(stream, SampleEncoding::kpcm16, samples.data(),
+		                                     samples.size());
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::sendStreamString(StreamId stream, const std::string& message) {
+	if (impl_) {
+		return impl_->sendStreamString_safe(stream, message);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::sendStreamString(StreamId stream, const std::string& message,
+                                         Deadline deadline) {
+	if (impl_) {
+		return impl_->sendStreamString_safe(stream, message, deadline);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::receiveStreamFrame(StreamFrame& frame) {
+	if (impl_) {
+		return impl_->receiveStreamFrame_safe(frame);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::receiveStreamFrame(StreamFrame& frame, Deadline deadline) {
+	if (impl_) {
+		return impl_->receiveStreamFrame_safe(frame, deadline);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::sendFDs(const std::vector<int>& fds) {
+	if (impl_) {
+		return impl_->sendFDs_safe(fds);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::receiveFDs(std::vector<int>& fds) {
+	if (impl_) {
+		return impl_->receiveFDs_safe(fds);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
 // void Base::log(const std::string& msg) {
 // 	if (impl_) {
 // 		impl_->log_alert_safe(msg);
@@ -132,6 +512,66 @@ SocketReturnValue Base::receiveString(std::string& message) {
 // 	}
 // }
 
+SocketReturnValue Base::receiveFloatStreaming(size_t slice_samples,
+                                              const SampleSliceHandler& on_slice,
+                                              uint32_t& frame_count) {
+	if (impl_) {
+		return impl_->receiveFloatStreaming_safe(slice_samples, on_slice, frame_count);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::receiveFloatStreaming(size_t slice_samples,
+                                              const SampleSliceHandler& on_slice,
+                                              uint32_t& frame_count, Deadline deadline) {
+	if (impl_) {
+		return impl_->receiveFloatStreaming_safe(slice_samples, on_slice, frame_count, deadline);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::sendResult(const ResultMessage& result) {
+	if (impl_) {
+		return impl_->sendResult_safe(result);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::sendResult(const ResultMessage& result, Deadline deadline) {
+	if (impl_) {
+		return impl_->sendResult_safe(result, deadline);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::receiveResult(ResultMessage& result) {
+	if (impl_) {
+		return impl_->receiveResult_safe(result);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue Base::receiveResult(ResultMessage& result, Deadline deadline) {
+	if (impl_) {
+		return impl_->receiveResult_safe(result, deadline);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+uint32_t Base::getSendCredits() const {
+	if (impl_) {
+		return impl_->getSendCredits_safe(kplain_session);
+	}
+	return 0;
+}
+
+uint32_t Base::getSendCredits(StreamId stream) const {
+	if (impl_) {
+		return impl_->getSendCredits_safe(stream);
+	}
+	return 0;
+}
+
 SocketReturnValue Base::connectToServer() {
 	if (impl_) {
 		return impl_->connectToServer();
@@ -139,6 +579,12 @@ SocketReturnValue Base::connectToServer() {
 	return SocketReturnValue::kimpl_nullptr_error;
 }
 
+void Base::setListenBacklog(int backlog) {
+	if (impl_) {
+		impl_->setListenBacklog_safe(backlog);
+	}
+}
+
 SocketReturnValue Base::startServer(const size_t& timeout) {
 	if (impl_) {
 		return impl_->startServer(timeout);
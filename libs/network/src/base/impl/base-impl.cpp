@@ -26,6 +26,107 @@ namespace arcforge {
 namespace embedded {
 namespace network_socket {
 
+namespace {
+
+// poll() timeout for the time left until deadline: -1 waits forever, 0 means it has passed
+int remainingMilliseconds(const Deadline& deadline) {
+	if (deadline == kno_deadline) {
+		return -1;
+	}
+	const auto remaining =
+	    std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+	if (remaining.count() <= 0) {
+		return 0;
+	}
+	return static_cast<int>(
+	    std::min<std::chrono::milliseconds::rep>(remaining.count(), INT_MAX));
+}
+
+size_t SampleBytes(SampleEncoding encoding) {
+	switch (encoding) {
+		case SampleEncoding::kpcm16:
+			return sizeof(int16_t);
+		case SampleEncoding::kmulaw:
+			return sizeof(uint8_t);
+		case SampleEncoding::kfloat32:
+		default:
+			return sizeof(float);
+	}
+}
+
+// low byte of a negotiation frame -> encoding; unknown values are refused
+bool DecodeSampleEncoding(uint32_t header, SampleEncoding& encoding) {
+	switch (header & 0xFFu) {
+		case static_cast<uint32_t>(SampleEncoding::kfloat32):
+			encoding = SampleEncoding::kfloat32;
+			return true;
+		case static_cast<uint32_t>(SampleEncoding::kpcm16):
+			encoding = SampleEncoding::kpcm16;
+			return true;
+		case static_cast<uint32_t>(SampleEncoding::kmulaw):
+			encoding = SampleEncoding::kmulaw;
+			return true;
+		default:
+			return false;
+	}
+}
+
+// handshake bodies, in wire order; words a peer does not know are ignored, missing ones
+// keep their defaults
+constexpr uint32_t kpipelined_results_flag = 0x1u;
+constexpr uint32_t kpush_results_flag = 0x2u;
+constexpr uint32_t kframe_metadata_flag = 0x4u;
+
+void EncodeStreamParams(const StreamParams& params, std::vector<uint32_t>& words) {
+	words.push_back(params.protocol_version);
+	words.push_back(params.sample_rate);
+	words.push_back(static_cast<uint32_t>(params.encoding));
+	words.push_back(params.chunk_duration_ms);
+	words.push_back((params.pipelined_results ? kpipelined_results_flag : 0u) |
+	                (params.push_results ? kpush_results_flag : 0u) |
+	                (params.frame_metadata ? kframe_metadata_flag : 0u));
+}
+
+size_t DecodeStreamParams(const std::vector<uint32_t>& words, StreamParams& params) {
+	const size_t n = words.size();
+	if (n > 0) {
+		params.protocol_version = words[0];
+	}
+	if (n > 1) {
+		params.sample_rate = words[1];
+	}
+	if (n > 2 && DecodeSampleEncoding(words[2], params.encoding) == false) {
+		params.encoding = SampleEncoding::kfloat32;
+	}
+	if (n > 3) {
+		params.chunk_duration_ms = words[3];
+	}
+	if (n > 4) {
+		params.pipelined_results = (words[4] & kpipelined_results_flag) != 0;
+		params.push_results = (words[4] & kpush_results_flag) != 0;
+		params.frame_metadata = (words[4] & kframe_metadata_flag) != 0;
+	}
+	return std::min<size_t>(n, 5);
+}
+
+// ancillary room of every receive: the passed fds and one SCM_TIMESTAMPNS
+constexpr size_t krx_control_bytes =
+    CMSG_SPACE(sizeof(int) * kmax_passed_fds) + CMSG_SPACE(sizeof(struct timespec));
+
+int64_t SteadyNanoseconds() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+	           std::chrono::steady_clock::now().time_since_epoch())
+	    .count();
+}
+
+std::string ToHex(uint32_t value) {
+	std::ostringstream oss;
+	oss << std::hex << value;
+	return oss.str();
+}
+
+}  // namespace
+
 // #define DEBUG
 /*===================================================
  * constructors and operators
@@ -33,7 +134,17 @@ namespace network_socket {
 BaseImpl::BaseImpl()
     : socketfd_(-1),
       socket_mutex_(std::make_unique<std::mutex>()),
-      log_mutex_(std::make_unique<std::mutex>()) {
+      send_mutex_(std::make_unique<std::mutex>()),
+      receive_mutex_(std::make_unique<std::mutex>()),
+      log_mutex_(std::make_unique<std::mutex>()),
+      credit_mutex_(std::make_unique<std::mutex>()) {
+	cancel_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (cancel_fd_ < 0) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "BaseImpl: eventfd() failed, blocking calls cannot be cancelled. errno: " +
+		        std::to_string(errno),
+		    kcurrent_lib_name);
+	}
 	arcforge::embedded::utils::Logger::GetInstance().Info("BaseImpl object constructed.",
 	                                                      kcurrent_lib_name);
 }
@@ -41,6 +152,10 @@ BaseImpl::BaseImpl()
 BaseImpl::~BaseImpl() {
 	// socketfd_ = -1;
 	closeSocket_safe();
+	if (cancel_fd_ >= 0) {
+		close(cancel_fd_);
+		cancel_fd_ = -1;
+	}
 	arcforge::embedded::utils::Logger::GetInstance().Info("BaseImpl cleaned up.",
 	                                                      kcurrent_lib_name);
 }
@@ -64,13 +179,91 @@ SocketStatus BaseImpl::isSocketFDValid() const {
 }
 
 void BaseImpl::closeSocket_safe() {
-	std::lock_guard<std::mutex> lock(*(socket_mutex_.get()));
+	ExclusiveAccess access = lockExclusive(true);
 
 	closeSocket();
 }
 
+/*----------------------------------
+ * unlike closeSocket_safe() this takes no lock and leaves the socket alone: the eventfd
+ * wakes whatever waits on the connection right now, the calls return kcancelled and so
+ * does every later one until the socket is closed
+ *--------------------------------- */
+void BaseImpl::cancel() {
+	cancelled_ = true;
+	if (cancel_fd_ < 0) {
+		return;
+	}
+
+	// only write(2) here, this must stay async-signal-safe
+	uint64_t one = 1;
+	ssize_t n = ::write(cancel_fd_, &one, sizeof(one));
+	(void)n;
+}
+
+bool BaseImpl::isCancelled() const {
+	return cancelled_;
+}
+
+void BaseImpl::drainCancelFD() {
+	uint64_t counter = 0;
+	while (cancel_fd_ >= 0 && ::read(cancel_fd_, &counter, sizeof(counter)) > 0) {
+	}
+}
+
+/*----------------------------------
+ * a receive blocked in the kernel would keep its lock forever, so when a direction is busy
+ * the socket is shut down first: the pending call returns (EOF / EPIPE) and lets go
+ *--------------------------------- */
+BaseImpl::ExclusiveAccess BaseImpl::lockExclusive(bool interrupt_pending_io) {
+	ExclusiveAccess access{std::unique_lock<std::mutex>(*send_mutex_, std::defer_lock),
+	                       std::unique_lock<std::mutex>(*receive_mutex_, std::defer_lock),
+	                       std::unique_lock<std::mutex>(*socket_mutex_, std::defer_lock)};
+
+	if (interrupt_pending_io == false) {
+		std::lock(access.send_lock, access.receive_lock);
+	} else if (std::try_lock(access.send_lock, access.receive_lock) != -1) {
+		{
+			std::lock_guard<std::mutex> lock(*socket_mutex_);
+			if (socketfd_ >= 0) {
+				::shutdown(socketfd_, SHUT_RDWR);
+			}
+		}
+		std::lock(access.send_lock, access.receive_lock);
+	}
+	access.socket_lock.lock();
+	return access;
+}
+
 void BaseImpl::closeSocket() {
+	// a closed connection starts over uncancelled, e.g. for the next connectToServer()
+	if (cancelled_ == true) {
+		drainCancelFD();
+		cancelled_ = false;
+	}
 	if (isSocketFDValid() == SocketStatus::kvalid) {
+		detachIoUring();
+		tx_ring_refused_ = false;
+		closePassedFDs();
+		rx_staging_begin_ = 0;
+		rx_staging_end_ = 0;
+		queued_packets_.clear();
+		rx_opening_frame_done_ = false;
+		rx_out_of_sync_ = false;
+		tx_out_of_sync_ = false;
+		pending_encoding_offer_ = 0;
+		sample_encoding_ = SampleEncoding::kfloat32;
+		pending_hello_.clear();
+		rx_timestamps_ = false;
+		rx_kernel_ns_ = 0;
+		rx_frame_info_ = FrameInfo();
+		tx_frame_metadata_ = false;
+		tx_frame_sequence_ = 0;
+		{
+			std::lock_guard<std::mutex> credit_lock(*(credit_mutex_.get()));
+			credit_window_ = 0;
+			inflight_chunks_.clear();
+		}
 		close(socketfd_);
 		socketfd_ = killegal_fd_value;
 	} else {
@@ -91,7 +284,7 @@ int BaseImpl::getFD() const {
 }
 
 void BaseImpl::setFD_safe(int fd) {
-	std::lock_guard<std::mutex> lock(*(socket_mutex_.get()));
+	ExclusiveAccess access = lockExclusive(true);
 
 	setFD(fd);
 }
@@ -147,159 +340,2437 @@ void BaseImpl::setSocketPath(const std::string& path) {
 	socketpath_ = path;
 }
 
-// --- sendFloat_safe ---
-SocketReturnValue BaseImpl::sendFloat_safe(const std::vector<float>& data) {
+SocketReturnValue BaseImpl::setIoBackend_safe(IoBackend backend) {
+	ExclusiveAccess access = lockExclusive(false);
+
+	if (backend == IoBackend::kio_uring && IoUring::isSupported() == false) {
+		arcforge::embedded::utils::Logger::GetInstance().Warning(
+		    "io_uring is not available on this build/kernel, keep using posix send()/recv()",
+		    kcurrent_lib_name);
+		io_backend_ = IoBackend::kposix;
+		return SocketReturnValue::kio_backend_unavailable;
+	}
+
+	if (backend != io_backend_) {
+		detachIoUring();
+		tx_ring_refused_ = false;
+		io_backend_ = backend;
+	}
+	return SocketReturnValue::ksuccess;
+}
+
+IoBackend BaseImpl::getIoBackend_safe() {
+	std::lock_guard<std::mutex> lock(*(socket_mutex_.get()));
+
+	return io_backend_;
+}
+
+SocketReturnValue BaseImpl::setSocketType_safe(SocketType type) {
+	ExclusiveAccess access = lockExclusive(false);
+
+	socket_type_ = type;
+	return SocketReturnValue::ksuccess;
+}
+
+SocketType BaseImpl::getSocketType_safe() {
+	std::lock_guard<std::mutex> lock(*(socket_mutex_.get()));
+
+	return socket_type_;
+}
+
+void BaseImpl::setListenBacklog_safe(int backlog) {
+	std::lock_guard<std::mutex> lock(*(socket_mutex_.get()));
+
+	listen_backlog_ = std::max(backlog, 1);
+}
+
+uint32_t BaseImpl::getRetryAfter_safe() {
+	std::lock_guard<std::mutex> lock(*(receive_mutex_.get()));
+
+	return rx_retry_after_ms_;
+}
+
+bool BaseImpl::hasBufferedData_safe() {
+	std::lock_guard<std::mutex> lock(*(receive_mutex_.get()));
+
+	// read-ahead of the posix path, recvmmsg() batches and the multishot ring all hold bytes
+	// that epoll on the socket no longer reports
+	if (rx_staging_end_ > rx_staging_begin_ || queued_packets_.empty() == false) {
+		return true;
+	}
+	return rx_ring_ != nullptr && rx_ring_->hasBufferedData();
+}
+
+int BaseImpl::getReadinessFD_safe() {
+	std::lock_guard<std::mutex> lock(*(receive_mutex_.get()));
+
+	// once the multishot receive is armed the kernel drains the socket into the ring, so
+	// arriving data shows up on the ring fd instead
+	if (rx_ring_ != nullptr && rx_ring_->isMultishotReceiveEnabled()) {
+		return rx_ring_->getFD();
+	}
+	return socketfd_;
+}
+
+void BaseImpl::setTcpEndpoint_safe(const std::string& host, uint16_t port) {
+	std::lock_guard<std::mutex> lock(*(socket_mutex_.get()));
+
+	transport_ = TransportFamily::ktcp;
+	tcp_host_ = host;
+	tcp_port_ = port;
+}
+
+void BaseImpl::setTcpOptions_safe(const TcpOptions& options) {
+	std::lock_guard<std::mutex> lock(*(socket_mutex_.get()));
+
+	tcp_options_ = options;
+}
+
+TransportFamily BaseImpl::getTransportFamily_safe() {
 	std::lock_guard<std::mutex> lock(*(socket_mutex_.get()));
 
+	return transport_;
+}
+
+uint16_t BaseImpl::getLocalPort_safe() {
+	std::lock_guard<std::mutex> lock(*(socket_mutex_.get()));
+
+	if (transport_ != TransportFamily::ktcp || socketfd_ < 0) {
+		return 0;
+	}
+
+	struct sockaddr_storage addr;
+	socklen_t addr_len = sizeof(addr);
+	if (::getsockname(socketfd_, reinterpret_cast<struct sockaddr*>(&addr), &addr_len) < 0) {
+		return 0;
+	}
+	if (addr.ss_family == AF_INET6) {
+		return ntohs(reinterpret_cast<struct sockaddr_in6*>(&addr)->sin6_port);
+	}
+	return ntohs(reinterpret_cast<struct sockaddr_in*>(&addr)->sin_port);
+}
+
+SocketReturnValue BaseImpl::getPeerCredentials_safe(PeerCredentials& credentials) {
+	std::lock_guard<std::mutex> lock(*(socket_mutex_.get()));
+
+	if (socketfd_ < 0) {
+		return SocketReturnValue::kfd_illegal;
+	}
+	if (transport_ == TransportFamily::ktcp) {
+		return SocketReturnValue::kpeer_credentials_unavailable;
+	}
+
+	struct ucred peer;
+	socklen_t peer_len = sizeof(peer);
+	if (::getsockopt(socketfd_, SOL_SOCKET, SO_PEERCRED, &peer, &peer_len) < 0) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "getPeerCredentials_safe: getsockopt(SO_PEERCRED) failed: " +
+		        std::string(strerror(errno)),
+		    kcurrent_lib_name);
+		return SocketReturnValue::kpeer_credentials_unavailable;
+	}
+	// sockets without a connected Unix-domain peer report no one
+	if (peer.pid == 0 && peer.uid == static_cast<uid_t>(-1)) {
+		return SocketReturnValue::kpeer_credentials_unavailable;
+	}
+	credentials.pid = peer.pid;
+	credentials.uid = peer.uid;
+	credentials.gid = peer.gid;
+	return SocketReturnValue::ksuccess;
+}
+
+SocketReturnValue BaseImpl::setReceiveTimestamps_safe(bool enable) {
+	ExclusiveAccess access = lockExclusive(false);
+
 	if (socketfd_ < 0) {
 		return SocketReturnValue::kfd_illegal;
 	}
+	const int on = enable ? 1 : 0;
+	if (::setsockopt(socketfd_, SOL_SOCKET, SO_TIMESTAMPNS, &on, sizeof(on)) < 0) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "setReceiveTimestamps_safe: setsockopt(SO_TIMESTAMPNS) failed: " +
+		        std::string(strerror(errno)),
+		    kcurrent_lib_name);
+		return SocketReturnValue::ksetsocketopt_error;
+	}
+	// the kernel stamps TCP segments and Unix packets but no Unix stream data, such a
+	// connection keeps its ring
+	const bool stamped = transport_ == TransportFamily::ktcp || isPacketMode();
+	if (enable && stamped && rx_ring_ != nullptr) {
+		// the ring may already hold data, it stays and those reads carry no timestamp
+		arcforge::embedded::utils::Logger::GetInstance().Warning(
+		    "setReceiveTimestamps_safe: rx ring already attached, frames arrive unstamped",
+		    kcurrent_lib_name);
+	}
+	rx_timestamps_ = enable && stamped;
+	rx_kernel_ns_ = 0;
+	return SocketReturnValue::ksuccess;
+}
+
+FrameInfo BaseImpl::getLastFrameInfo_safe() {
+	std::lock_guard<std::mutex> lock(*(receive_mutex_.get()));
+
+	return rx_frame_info_;
+}
+
+bool BaseImpl::isPacketMode() const {
+	return socket_type_ == SocketType::kseqpacket;
+}
+
+int BaseImpl::nativeSocketType() const {
+	return isPacketMode() ? SOCK_SEQPACKET : SOCK_STREAM;
+}
+
+std::shared_ptr<AudioBufferPool> BaseImpl::getBufferPool_safe() {
+	std::lock_guard<std::mutex> lock(*(socket_mutex_.get()));
+
+	if (buffer_pool_ == nullptr) {
+		buffer_pool_ = AudioBufferPool::create();
+	}
+	return buffer_pool_;
+}
+
+/*----------------------------------
+ * rings are attached lazily on the first rx/tx call, so listening sockets never get one,
+ * and dropped before the fd is closed, so no request outlives the socket it points at.
+ * each direction owns its ring and attaches it under its own lock
+ *--------------------------------- */
+void BaseImpl::attachTxRing() {
+	constexpr unsigned kring_entries = 8;
+
+	// a packet is already a single sendmsg()/recvmsg(), and multishot RECV would truncate
+	// packets larger than one provided buffer
+	if (io_backend_ != IoBackend::kio_uring || isPacketMode() || tx_ring_ != nullptr ||
+	    tx_ring_refused_ == true) {
+		return;
+	}
+
+	auto tx_ring = std::make_unique<IoUring>();
+	if (tx_ring->init(kring_entries) == false) {
+		arcforge::embedded::utils::Logger::GetInstance().Warning(
+		    "attachTxRing: io_uring_setup failed, tx path stays on sendmsg()", kcurrent_lib_name);
+		tx_ring_refused_ = true;
+		return;
+	}
+	tx_ring_ = std::move(tx_ring);
+}
+
+void BaseImpl::attachRxRing() {
+	constexpr unsigned kring_entries = 8;
+	constexpr unsigned krx_buffer_count = 8;
+	constexpr unsigned krx_buffer_size = 32 * 1024;
+
+	if (io_backend_ != IoBackend::kio_uring || isPacketMode()) {
+		return;
+	}
+
+	// the opening frame is always read with recvmsg(): it may carry SCM_RIGHTS (see sendFDs),
+	// which a plain io_uring RECV would silently drop, and so are all frames once receive
+	// timestamps are on
+	if (rx_ring_ != nullptr || rx_opening_frame_done_ == false || rx_ring_refused_ == true ||
+	    rx_timestamps_ == true) {
+		return;
+	}
+
+	// multishot receive needs provided buffer rings (5.19+) and RECV_MULTISHOT (6.0+)
+	auto rx_ring = std::make_unique<IoUring>();
+	if (rx_ring->init(kring_entries) &&
+	    rx_ring->enableMultishotReceive(socketfd_, krx_buffer_count, krx_buffer_size)) {
+		rx_ring_ = std::move(rx_ring);
+	} else {
+		arcforge::embedded::utils::Logger::GetInstance().Warning(
+		    "attachRxRing: multishot receive unsupported, rx path stays on recv()",
+		    kcurrent_lib_name);
+		rx_ring_refused_ = true;
+	}
+}
+
+void BaseImpl::detachIoUring() {
+	tx_ring_.reset();
+	rx_ring_.reset();
+	rx_ring_refused_ = false;
+}
+
+/*----------------------------------
+ * every call uses MSG_DONTWAIT and parks in poll() only when the socket has nothing for it,
+ * next to the cancel eventfd; the fd itself stays blocking for raw users of getFD()
+ *--------------------------------- */
+SocketReturnValue BaseImpl::beginReceive(const Deadline& deadline, const std::string& caller) {
+	if (cancelled_ == true) {
+		return SocketReturnValue::kcancelled;
+	}
+	if (rx_out_of_sync_ == true) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    caller + ": a previous timeout cut a frame in half, the connection must be closed",
+		    kcurrent_lib_name);
+		return SocketReturnValue::kreceived_illegal;
+	}
+	rx_deadline_ = deadline;
+	rx_frame_bytes_ = 0;
+	return SocketReturnValue::ksuccess;
+}
+
+SocketReturnValue BaseImpl::beginSend(const Deadline& deadline, const std::string& caller) {
+	if (cancelled_ == true) {
+		return SocketReturnValue::kcancelled;
+	}
+	if (tx_out_of_sync_ == true) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    caller + ": a previous timeout cut a frame in half, the connection must be closed",
+		    kcurrent_lib_name);
+		return SocketReturnValue::ksenddata_failed;
+	}
+	tx_deadline_ = deadline;
+	return SocketReturnValue::ksuccess;
+}
+
+SocketReturnValue BaseImpl::waitForSocket(short events, const Deadline& deadline,
+                                          SocketReturnValue failure, const std::string& caller) {
+	for (;;) {
+		const int timeout_ms = remainingMilliseconds(deadline);
+		if (timeout_ms == 0) {
+			return SocketReturnValue::kio_timeout;
+		}
+
+		struct pollfd waits[2];
+		waits[0].fd = socketfd_;
+		waits[0].events = events;
+		waits[0].revents = 0;
+		waits[1].fd = cancel_fd_;
+		waits[1].events = POLLIN;
+		waits[1].revents = 0;
+		const int ready = ::poll(waits, cancel_fd_ >= 0 ? 2U : 1U, timeout_ms);
+		if (ready > 0 && (waits[1].revents & POLLIN) != 0) {
+			arcforge::embedded::utils::Logger::GetInstance().Debug(caller + ": cancelled",
+			                                                       kcurrent_lib_name);
+			return SocketReturnValue::kcancelled;
+		}
+		if (ready > 0) {
+			// readiness as well as POLLHUP/POLLERR: the retried call reports the outcome
+			return SocketReturnValue::ksuccess;
+		}
+		if (ready < 0 && errno != EINTR) {
+			arcforge::embedded::utils::Logger::GetInstance().Error(
+			    caller + ": poll() error. errno: " + std::to_string(errno), kcurrent_lib_name);
+			return failure;
+		}
+	}
+}
+
+SocketReturnValue BaseImpl::abandonReceive(size_t bytes_in_frame, const std::string& caller) {
+	if (rx_frame_bytes_ + bytes_in_frame > 0) {
+		// the consumed part of the frame is gone, the next header would be read from its middle
+		rx_out_of_sync_ = true;
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    caller + ": deadline expired in the middle of a frame", kcurrent_lib_name);
+	}
+	return SocketReturnValue::kio_timeout;
+}
+
+// --- transmitFrame ---
+SocketReturnValue BaseImpl::transmitFrame(const void* header, size_t header_len, const void* body,
+                                          size_t body_len, SocketReturnValue header_failure,
+                                          const std::string& caller, const void* trailer,
+                                          size_t trailer_len) {
+	struct iovec parts[3];
+	unsigned part_count = 0;
+	parts[part_count].iov_base = const_cast<void*>(header);
+	parts[part_count++].iov_len = header_len;
+	if (body_len > 0) {
+		parts[part_count].iov_base = const_cast<void*>(body);
+		parts[part_count++].iov_len = body_len;
+	}
+	if (trailer_len > 0) {
+		parts[part_count].iov_base = const_cast<void*>(trailer);
+		parts[part_count++].iov_len = trailer_len;
+	}
+	const size_t bytes_to_send = header_len + body_len + trailer_len;
+	size_t bytes_has_sent = 0;
+
+	attachTxRing();
+	// the linked io_uring chain takes what the send buffer has room for, sendmsg() below
+	// waits for the rest
+	if (tx_ring_ != nullptr) {
+		// header and body leave as one linked chain with a single syscall
+		ssize_t n_sent = tx_ring_->sendLinked(socketfd_, parts, part_count);
+		if (n_sent > 0) {
+			bytes_has_sent = static_cast<size_t>(n_sent);
+		} else {
+			arcforge::embedded::utils::Logger::GetInstance().Debug(
+			    caller + ": io_uring send failed (" + strerror(static_cast<int>(-n_sent)) +
+			        "), retry with send()",
+			    kcurrent_lib_name);
+		}
+	}
+
+	// posix path: header and whatever is left of the body go out in one sendmsg(), so the
+	// peer is not woken by a header-only segment; it also finishes a short io_uring chain
+	while (bytes_has_sent < bytes_to_send) {
+		const bool in_header = bytes_has_sent < header_len;
+		struct iovec pending[3];
+		size_t pending_count = 0;
+		size_t skip = bytes_has_sent;
+		for (unsigned i = 0; i < part_count; ++i) {
+			if (skip >= parts[i].iov_len) {
+				skip -= parts[i].iov_len;
+				continue;
+			}
+			pending[pending_count].iov_base = static_cast<char*>(parts[i].iov_base) + skip;
+			pending[pending_count].iov_len = parts[i].iov_len - skip;
+			++pending_count;
+			skip = 0;
+		}
+
+		struct msghdr msg;
+		memset(&msg, 0, sizeof(msg));
+		msg.msg_iov = pending;
+		msg.msg_iovlen = pending_count;
+
+		ssize_t n_sent = ::sendmsg(socketfd_, &msg, MSG_NOSIGNAL | MSG_DONTWAIT);
+		if (n_sent < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			if (errno == EAGAIN || errno == EWOULDBLOCK) {
+				SocketReturnValue retval = waitForSocket(
+				    POLLOUT, tx_deadline_, SocketReturnValue::ksenddata_failed, caller);
+				if (retval == SocketReturnValue::ksuccess) {
+					continue;
+				}
+				if (retval == SocketReturnValue::kio_timeout && bytes_has_sent > 0) {
+					// the peer already holds the beginning of this frame
+					tx_out_of_sync_ = true;
+					arcforge::embedded::utils::Logger::GetInstance().Error(
+					    caller + ": deadline expired in the middle of a frame", kcurrent_lib_name);
+				}
+				return retval;
+			}
+			if (errno == EMSGSIZE) {
+				arcforge::embedded::utils::Logger::GetInstance().Error(
+				    caller + ": frame exceeds the socket send buffer, raise SO_SNDBUF",
+				    kcurrent_lib_name);
+			}
+			arcforge::embedded::utils::Logger::GetInstance().Error(
+			    caller + ": sendmsg() error while sending " + (in_header ? "header" : "data") +
+			        ". errno: " + std::to_string(errno),
+			    kcurrent_lib_name);
+			return in_header ? header_failure : SocketReturnValue::ksenddata_failed;
+		}
+		bytes_has_sent += static_cast<size_t>(n_sent);
+		if (isPacketMode() && bytes_has_sent != bytes_to_send) {
+			// a second sendmsg() would become a second packet
+			return SocketReturnValue::ksenddata_failed;
+		}
+	}
+
+	return SocketReturnValue::ksuccess;
+}
+
+// --- receiveExact ---
+SocketReturnValue BaseImpl::receiveExact(void* dst, size_t len, const std::string& caller) {
+	char* buffer_start = static_cast<char*>(dst);
+	size_t bytes_has_received = 0;
+
+	attachRxRing();
+
+	// bytes a previous recvmsg() already pulled past the end of its frame part
+	if (rx_staging_end_ > rx_staging_begin_) {
+		const size_t take = std::min(len, rx_staging_end_ - rx_staging_begin_);
+		memcpy(buffer_start, rx_staging_.data() + rx_staging_begin_, take);
+		rx_staging_begin_ += take;
+		if (rx_staging_begin_ == rx_staging_end_) {
+			rx_staging_begin_ = 0;
+			rx_staging_end_ = 0;
+		}
+		bytes_has_received = take;
+	}
+
+	while (bytes_has_received < len) {
+		ssize_t n_recv = 0;
+		if (rx_ring_ != nullptr) {
+			n_recv = rx_ring_->receive(buffer_start + bytes_has_received, len - bytes_has_received,
+			                           remainingMilliseconds(rx_deadline_), cancel_fd_);
+			if (n_recv == -ETIMEDOUT) {
+				return abandonReceive(bytes_has_received, caller);
+			}
+			if (n_recv == -ECANCELED) {
+				return SocketReturnValue::kcancelled;
+			}
+			if (n_recv == -EOPNOTSUPP) {
+				// kernel rejected the multishot request before delivering anything
+				arcforge::embedded::utils::Logger::GetInstance().Warning(
+				    caller + ": multishot receive rejected by kernel, rx path falls back to recv()",
+				    kcurrent_lib_name);
+				rx_ring_.reset();
+				rx_ring_refused_ = true;
+				continue;
+			}
+			if (n_recv < 0) {
+				errno = static_cast<int>(-n_recv);
+				n_recv = -1;
+			}
+		} else {
+			// scatter into the caller's buffer first and let the staging buffer catch what
+			// is already queued behind it, e.g. the payload right after a length header
+			if (rx_staging_.empty()) {
+				rx_staging_.resize(krx_staging_size_);
+			}
+			struct iovec parts[2];
+			parts[0].iov_base = buffer_start + bytes_has_received;
+			parts[0].iov_len = len - bytes_has_received;
+			parts[1].iov_base = rx_staging_.data();
+			parts[1].iov_len = rx_staging_.size();
+
+			alignas(struct cmsghdr) char control[krx_control_bytes];
+			struct msghdr msg;
+			memset(&msg, 0, sizeof(msg));
+			msg.msg_iov = parts;
+			msg.msg_iovlen = 2;
+			msg.msg_control = control;
+			msg.msg_controllen = sizeof(control);
+			n_recv = ::recvmsg(socketfd_, &msg, MSG_CMSG_CLOEXEC | MSG_DONTWAIT);
+			if (n_recv > 0) {
+				collectAncillaryData(msg);
+			}
+			if (n_recv > 0 && static_cast<size_t>(n_recv) > parts[0].iov_len) {
+				rx_staging_begin_ = 0;
+				rx_staging_end_ = static_cast<size_t>(n_recv) - parts[0].iov_len;
+				n_recv = static_cast<ssize_t>(parts[0].iov_len);
+			}
+		}
+
+		if (n_recv == 0) {
+			arcforge::embedded::utils::Logger::GetInstance().Info(
+			    caller + ": Peer closed connection. Expected " + std::to_string(len) +
+			        " bytes, but got only " + std::to_string(bytes_has_received),
+			    kcurrent_lib_name);
+			return SocketReturnValue::kpeer_abnormally_closed;
+		}
+		if (n_recv < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			if (errno == EAGAIN || errno == EWOULDBLOCK) {
+				SocketReturnValue retval = waitForSocket(
+				    POLLIN, rx_deadline_, SocketReturnValue::kreceived_illegal, caller);
+				if (retval == SocketReturnValue::kio_timeout) {
+					return abandonReceive(bytes_has_received, caller);
+				}
+				if (retval != SocketReturnValue::ksuccess) {
+					return retval;
+				}
+				continue;
+			}
+			arcforge::embedded::utils::Logger::GetInstance().Error(
+			    caller + ": recv() error. errno: " + std::to_string(errno) + " (" +
+			        strerror(errno) + ")",
+			    kcurrent_lib_name);
+			return SocketReturnValue::kreceived_illegal;
+		}
+		bytes_has_received += static_cast<size_t>(n_recv);
+	}
+
+	rx_frame_bytes_ += len;
+	rx_opening_frame_done_ = true;
+	return SocketReturnValue::ksuccess;
+}
+
+// --- receivePacket ---
+SocketReturnValue BaseImpl::receivePacket(void* header, size_t header_len, void* body,
+                                          size_t body_capacity, size_t& body_len,
+                                          const std::string& caller) {
+	// [header | caller storage | staging]: one recvmsg() per frame, the part that does not
+	// fit the caller's storage waits in the staging buffer for takePacketOverflow()
+	if (rx_staging_.size() < krx_packet_staging_size_) {
+		rx_staging_.resize(krx_packet_staging_size_);
+	}
+	if (queued_packets_.empty() == false) {
+		return takeQueuedPacket(header, header_len, body, body_capacity, body_len);
+	}
+	struct iovec parts[3];
+	parts[0].iov_base = header;
+	parts[0].iov_len = header_len;
+	parts[1].iov_base = body;
+	parts[1].iov_len = body != nullptr ? body_capacity : 0;
+	parts[2].iov_base = rx_staging_.data();
+	parts[2].iov_len = rx_staging_.size();
+
+	alignas(struct cmsghdr) char control[krx_control_bytes];
+	struct msghdr msg;
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = parts;
+	msg.msg_iovlen = 3;
+	msg.msg_control = control;
+	msg.msg_controllen = sizeof(control);
+
+	// a packet is taken whole or not at all, so a timeout never leaves half a frame behind
+	ssize_t n_recv = 0;
+	for (;;) {
+		n_recv = ::recvmsg(socketfd_, &msg, MSG_CMSG_CLOEXEC | MSG_DONTWAIT);
+		if (n_recv >= 0) {
+			break;
+		}
+		if (errno == EINTR) {
+			continue;
+		}
+		if (errno != EAGAIN && errno != EWOULDBLOCK) {
+			break;
+		}
+		SocketReturnValue retval =
+		    waitForSocket(POLLIN, rx_deadline_, SocketReturnValue::kreceived_illegal, caller);
+		if (retval != SocketReturnValue::ksuccess) {
+			return retval;
+		}
+	}
+
+	if (n_recv == 0) {
+		arcforge::embedded::utils::Logger::GetInstance().Info(
+		    caller + ": Peer closed connection.", kcurrent_lib_name);
+		return SocketReturnValue::kpeer_abnormally_closed;
+	}
+	if (n_recv < 0) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    caller + ": recvmsg() error. errno: " + std::to_string(errno) + " (" +
+		        strerror(errno) + ")",
+		    kcurrent_lib_name);
+		return SocketReturnValue::kreceived_illegal;
+	}
+	collectAncillaryData(msg);
+
+	if ((msg.msg_flags & MSG_TRUNC) != 0) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    caller + ": packet larger than the receive staging buffer, dropped.",
+		    kcurrent_lib_name);
+		return SocketReturnValue::kcount_too_large;
+	}
+	if (static_cast<size_t>(n_recv) < header_len) {
+		return SocketReturnValue::kreceivelength_failed;
+	}
+
+	body_len = static_cast<size_t>(n_recv) - header_len;
+	rx_opening_frame_done_ = true;
+	return SocketReturnValue::ksuccess;
+}
+
+SocketReturnValue BaseImpl::takeQueuedPacket(void* header, size_t header_len, void* body,
+                                             size_t body_capacity, size_t& body_len) {
+	// same split as a fresh recvmsg(): caller storage first, the rest in the staging buffer
+	std::vector<char> packet = std::move(queued_packets_.front());
+	queued_packets_.pop_front();
+	if (packet.size() < header_len) {
+		return SocketReturnValue::kreceivelength_failed;
+	}
+	memcpy(header, packet.data(), header_len);
+	body_len = packet.size() - header_len;
+	const size_t head = body != nullptr ? std::min(body_len, body_capacity) : 0;
+	if (head > 0) {
+		memcpy(body, packet.data() + header_len, head);
+	}
+	if (body_len > head) {
+		memcpy(rx_staging_.data(), packet.data() + header_len + head, body_len - head);
+	}
+	rx_opening_frame_done_ = true;
+	return SocketReturnValue::ksuccess;
+}
+
+void BaseImpl::takePacketOverflow(void* dst, size_t len, size_t offset) {
+	memcpy(dst, rx_staging_.data() + offset, len);
+}
+
+// --- collectAncillaryData ---
+void BaseImpl::collectAncillaryData(const struct msghdr& msg) {
+	if ((msg.msg_flags & MSG_CTRUNC) != 0) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "collectAncillaryData: ancillary data truncated, some passed fds were dropped",
+		    kcurrent_lib_name);
+	}
+
+	for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr;
+	     cmsg = CMSG_NXTHDR(const_cast<struct msghdr*>(&msg), cmsg)) {
+		if (cmsg->cmsg_level != SOL_SOCKET) {
+			continue;
+		}
+		if (cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+			// CLOCK_REALTIME from the kernel, moved onto the steady clock of FrameInfo
+			struct timespec ingress;
+			memcpy(&ingress, CMSG_DATA(cmsg), sizeof(ingress));
+			struct timespec now;
+			clock_gettime(CLOCK_REALTIME, &now);
+			const int64_t age_ns = (static_cast<int64_t>(now.tv_sec) - ingress.tv_sec) *
+			                           1000000000LL +
+			                       (now.tv_nsec - ingress.tv_nsec);
+			rx_kernel_ns_ = SteadyNanoseconds() - std::max<int64_t>(age_ns, 0);
+			continue;
+		}
+		if (cmsg->cmsg_type != SCM_RIGHTS) {
+			continue;
+		}
+		const size_t fd_count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+		for (size_t i = 0; i < fd_count; ++i) {
+			int fd = -1;
+			memcpy(&fd, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int));
+			passed_fds_.push_back(fd);
+		}
+	}
+}
+
+void BaseImpl::closePassedFDs() {
+	for (int fd : passed_fds_) {
+		close(fd);
+	}
+	passed_fds_.clear();
+}
+
+// --- sendFDs_safe ---
+SocketReturnValue BaseImpl::sendFDs_safe(const std::vector<int>& fds) {
+	std::lock_guard<std::mutex> lock(*(send_mutex_.get()));
+
+	if (socketfd_ < 0) {
+		return SocketReturnValue::kfd_illegal;
+	}
+	SocketReturnValue ready = beginSend(kno_deadline, "sendFDs_safe");
+	if (ready != SocketReturnValue::ksuccess) {
+		return ready;
+	}
+	if (fds.empty() || fds.size() > kmax_passed_fds) {
+		return SocketReturnValue::kcount_too_large;
+	}
+
+	// the fds ride on the 4-byte frame header; its tag can never be a valid float count
+	uint32_t header = kfd_frame_tag | static_cast<uint32_t>(fds.size());
+	struct iovec part;
+	part.iov_base = &header;
+	part.iov_len = sizeof(header);
+
+	alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int) * kmax_passed_fds)];
+	memset(control, 0, sizeof(control));
+	struct msghdr msg;
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = &part;
+	msg.msg_iovlen = 1;
+	msg.msg_control = control;
+	msg.msg_controllen = CMSG_SPACE(sizeof(int) * fds.size());
+
+	struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+	cmsg->cmsg_level = SOL_SOCKET;
+	cmsg->cmsg_type = SCM_RIGHTS;
+	cmsg->cmsg_len = CMSG_LEN(sizeof(int) * fds.size());
+	memcpy(CMSG_DATA(cmsg), fds.data(), sizeof(int) * fds.size());
+
+	ssize_t n_sent = 0;
+	do {
+		n_sent = ::sendmsg(socketfd_, &msg, MSG_NOSIGNAL);
+	} while (n_sent < 0 && errno == EINTR);
+	if (n_sent != static_cast<ssize_t>(sizeof(header))) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "sendFDs_safe: sendmsg() failed. errno: " + std::to_string(errno),
+		    kcurrent_lib_name);
+		return SocketReturnValue::ksendcount_failed;
+	}
+
+	arcforge::embedded::utils::Logger::GetInstance().Info(
+	    "sendFDs_safe: Passed " + std::to_string(fds.size()) + " fds.", kcurrent_lib_name);
+	return SocketReturnValue::ksuccess;
+}
+
+// --- receiveFDs_safe ---
+SocketReturnValue BaseImpl::receiveFDs_safe(std::vector<int>& fds) {
+	std::lock_guard<std::mutex> lock(*(receive_mutex_.get()));
+
+	fds.clear();
+	if (socketfd_ < 0) {
+		return SocketReturnValue::kfd_illegal;
+	}
+	SocketReturnValue ready = beginReceive(kno_deadline, "receiveFDs_safe");
+	if (ready != SocketReturnValue::ksuccess) {
+		return ready;
+	}
+
+	// a previous receiveFloat_safe() may already have read the fd frame
+	if (passed_fds_.empty()) {
+		if (rx_ring_ != nullptr) {
+			arcforge::embedded::utils::Logger::GetInstance().Error(
+			    "receiveFDs_safe: io_uring rx is active, fds can only open a connection",
+			    kcurrent_lib_name);
+			return SocketReturnValue::kio_backend_unavailable;
+		}
+
+		uint32_t header = 0;
+		size_t body_len = 0;
+		SocketReturnValue retval =
+		    isPacketMode()
+		        ? receivePacket(&header, sizeof(header), nullptr, 0, body_len, "receiveFDs_safe")
+		        : receiveExact(&header, sizeof(header), "receiveFDs_safe");
+		if (retval != SocketReturnValue::ksuccess) {
+			return retval;
+		}
+		if ((header & kfd_frame_tag_mask) != kfd_frame_tag) {
+			arcforge::embedded::utils::Logger::GetInstance().Error(
+			    "receiveFDs_safe: next frame does not carry fds", kcurrent_lib_name);
+			return SocketReturnValue::kreceived_illegal;
+		}
+	}
+
+	if (passed_fds_.empty()) {
+		return SocketReturnValue::kreceived_null;
+	}
+	fds.swap(passed_fds_);
+	return SocketReturnValue::ksuccess;
+}
+
+// --- sendFloat_safe ---
+SocketReturnValue BaseImpl::sendFloat_safe(const std::vector<float>& data,
+                                           const Deadline& deadline) {
+	std::lock_guard<std::mutex> lock(*(send_mutex_.get()));
+
+	if (socketfd_ < 0) {
+		return SocketReturnValue::kfd_illegal;
+	}
+	SocketReturnValue ready = beginSend(deadline, "sendFloat_safe");
+	if (ready != SocketReturnValue::ksuccess) {
+		return ready;
+	}
+
+	uint32_t count = static_cast<uint32_t>(data.size());
+	const uint32_t credits = count > 0 ? 1 : 0;
+	if (takeSendCredits(kplain_session, credits) < credits) {
+		return refuseWithoutCredit(kplain_session, "sendFloat_safe");
+	}
+
+	// transmit the length header and the data body
+	SocketReturnValue retval =
+	    transmitSampleFrame(count, data.data(), count * sizeof(float), "sendFloat_safe");
+	if (retval != SocketReturnValue::ksuccess) {
+		returnSendCredits(kplain_session, credits);
+		return retval;
+	}
+	// arcforge::embedded::utils::Logger::GetInstance().Info("sendFloat_safe: Sent " + std::to_string(count) + " floats.");
+	arcforge::embedded::utils::Logger::GetInstance().Info(
+	    "sendFloat_safe: Sent " + std::to_string(count) + " floats.", kcurrent_lib_name);
+	return SocketReturnValue::ksuccess;
+}
+
+// --- receiveFloat_safe  ---
+SocketReturnValue BaseImpl::receiveFloat_safe(std::vector<float>& data,
+                                              const Deadline& deadline) {
+	std::lock_guard<std::mutex> lock(*(receive_mutex_.get()));
+
+	// 1. fd validation verification
+	if (socketfd_ < 0) {
+		return SocketReturnValue::kfd_illegal;
+	}
+	SocketReturnValue ready = beginReceive(deadline, "receiveFloat_safe");
+	if (ready != SocketReturnValue::ksuccess) {
+		return ready;
+	}
+
+	if (isPacketMode()) {
+		// whatever the vector already holds is valid storage for the in-place part
+		const size_t in_place_capacity = data.size() * sizeof(float);
+		uint32_t count = 0;
+		size_t body_len = 0;
+		SocketReturnValue retval = receivePacket(&count, sizeof(count), data.data(),
+		                                         in_place_capacity, body_len, "receiveFloat_safe");
+		if (retval == SocketReturnValue::ksuccess) {
+			retval = validateSamplePacket(count, SampleEncoding::kfloat32, count, data.data(),
+			                              in_place_capacity, body_len, "receiveFloat_safe");
+		}
+		if (retval != SocketReturnValue::ksuccess) {
+			data.clear();
+			return retval;
+		}
+		data.resize(count);
+		if (body_len > in_place_capacity) {
+			takePacketOverflow(reinterpret_cast<char*>(data.data()) + in_place_capacity,
+			                   body_len - in_place_capacity);
+		}
+		return retval;
+	}
+
+	// 2. receive and validate the length header
+	uint32_t count = 0;
+	SocketReturnValue retval = receiveFloatCount(count);
+	if (retval != SocketReturnValue::ksuccess) {
+		data.clear();
+		return retval;
+	}
+
+	// 3. receive data; resize() without a prior clear() only zero-fills growth, so a vector
+	//    reused across frames of the same size is not touched before recv overwrites it
+	data.resize(count);
+	retval = receiveFloatBody(data.data(), count);
+	if (retval != SocketReturnValue::ksuccess) {
+		data.clear();
+	}
+	return retval;
+}
+
+SocketReturnValue BaseImpl::receiveFloat_safe(AudioBuffer& buffer,
+                                              const Deadline& deadline) {
+	std::lock_guard<std::mutex> lock(*(receive_mutex_.get()));
+
+	if (socketfd_ < 0) {
+		return SocketReturnValue::kfd_illegal;
+	}
+	SocketReturnValue ready = beginReceive(deadline, "receiveFloat_safe");
+	if (ready != SocketReturnValue::ksuccess) {
+		return ready;
+	}
+
+	return receiveFloatFrame(buffer, "receiveFloat_safe");
+}
+
+SocketReturnValue BaseImpl::receiveFloatFrame(AudioBuffer& buffer, const std::string& caller) {
+	if (isPacketMode()) {
+		const size_t in_place_count = buffer.capacity();
+		uint32_t count = 0;
+		size_t body_len = 0;
+		SocketReturnValue retval =
+		    receivePacket(&count, sizeof(count), buffer.data(), in_place_count * sizeof(float),
+		                  body_len, caller);
+		if (retval == SocketReturnValue::ksuccess) {
+			retval = validateSamplePacket(count, SampleEncoding::kfloat32, count, buffer.data(),
+			                              in_place_count * sizeof(float), body_len, caller);
+		}
+		if (retval != SocketReturnValue::ksuccess) {
+			buffer.clear();
+			return retval;
+		}
+		if (count <= in_place_count) {
+			buffer.resize(count);
+		} else {
+			// grow while keeping the samples that already landed in place
+			buffer.resize(in_place_count);
+			buffer.reserve(count);
+			buffer.resize(count);
+			takePacketOverflow(buffer.data() + in_place_count,
+			                   (count - in_place_count) * sizeof(float));
+		}
+		return retval;
+	}
+
+	uint32_t count = 0;
+	SocketReturnValue retval = receiveFloatCount(count);
+	if (retval != SocketReturnValue::ksuccess) {
+		buffer.clear();
+		return retval;
+	}
+
+	buffer.resize(count);
+	retval = receiveFloatBody(buffer.data(), count);
+	if (retval != SocketReturnValue::ksuccess) {
+		buffer.clear();
+	}
+	return retval;
+}
+
+SocketReturnValue BaseImpl::receiveFloat_safe(float* dst, size_t capacity, size_t& count,
+                                              const Deadline& deadline) {
+	std::lock_guard<std::mutex> lock(*(receive_mutex_.get()));
+
+	count = 0;
+	if (socketfd_ < 0) {
+		return SocketReturnValue::kfd_illegal;
+	}
+	SocketReturnValue ready = beginReceive(deadline, "receiveFloat_safe");
+	if (ready != SocketReturnValue::ksuccess) {
+		return ready;
+	}
+
+	if (isPacketMode()) {
+		uint32_t frame_count = 0;
+		size_t body_len = 0;
+		SocketReturnValue retval =
+		    receivePacket(&frame_count, sizeof(frame_count), dst, capacity * sizeof(float),
+		                  body_len, "receiveFloat_safe");
+		if (retval == SocketReturnValue::ksuccess) {
+			retval = validateSamplePacket(frame_count, SampleEncoding::kfloat32, frame_count, dst,
+			                              capacity * sizeof(float), body_len,
+			                              "receiveFloat_safe");
+		}
+		if (retval != SocketReturnValue::ksuccess) {
+			return retval;
+		}
+		// the packet is consumed either way, no need to drain anything
+		if (frame_count > capacity || dst == nullptr) {
+			return SocketReturnValue::kbuffer_too_small;
+		}
+		count = frame_count;
+		return retval;
+	}
+
+	uint32_t frame_count = 0;
+	SocketReturnValue retval = receiveFloatCount(frame_count);
+	if (retval != SocketReturnValue::ksuccess) {
+		return retval;
+	}
+
+	if (frame_count > capacity || dst == nullptr) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "receiveFloat_safe: frame of " + std::to_string(frame_count) +
+		        " floats does not fit caller buffer of " + std::to_string(capacity) +
+		        ", frame dropped.",
+		    kcurrent_lib_name);
+		// keep the stream in sync for the next frame
+		retval = discardExact(frame_count * sizeof(float), "receiveFloat_safe");
+		return retval == SocketReturnValue::ksuccess ? SocketReturnValue::kbuffer_too_small
+		                                             : retval;
+	}
+
+	retval = receiveFloatBody(dst, frame_count);
+	if (retval == SocketReturnValue::ksuccess) {
+		count = frame_count;
+	}
+	return retval;
+}
+
+// --- receiveFloatStreaming_safe ---
+SocketReturnValue BaseImpl::receiveFloatStreaming_safe(size_t slice_samples,
+                                                       const SampleSliceHandler& on_slice,
+                                                       uint32_t& frame_count,
+                                                       const Deadline& deadline) {
+	std::lock_guard<std::mutex> lock(*(receive_mutex_.get()));
+
+	frame_count = 0;
+	if (socketfd_ < 0) {
+		return SocketReturnValue::kfd_illegal;
+	}
+	SocketReturnValue ready = beginReceive(deadline, "receiveFloatStreaming_safe");
+	if (ready != SocketReturnValue::ksuccess) {
+		return ready;
+	}
+	slice_samples = std::max<size_t>(slice_samples, 1);
+	if (rx_slice_.size() < slice_samples) {
+		rx_slice_.resize(slice_samples);
+	}
+
+	uint32_t count = 0;
+	SocketReturnValue retval = SocketReturnValue::kinit_state;
+	if (isPacketMode()) {
+		// the whole body lands in the staging buffer, slices are copied out of it
+		size_t body_len = 0;
+		retval = receivePacket(&count, sizeof(count), nullptr, 0, body_len,
+		                       "receiveFloatStreaming_safe");
+		if (retval == SocketReturnValue::ksuccess) {
+			retval = validateSamplePacket(count, SampleEncoding::kfloat32, count, nullptr, 0,
+			                              body_len, "receiveFloatStreaming_safe");
+		}
+	} else {
+		retval = receiveSampleHeader(SampleEncoding::kfloat32, count, "receiveFloatStreaming_safe");
+	}
+	if (retval != SocketReturnValue::ksuccess) {
+		return retval;
+	}
+	frame_count = count;
+
+	SampleSlice slice;
+	slice.samples = rx_slice_.data();
+	slice.frame_count = count;
+	for (size_t offset = 0; offset < count; offset += slice.count) {
+		slice.offset = offset;
+		slice.count = std::min(slice_samples, static_cast<size_t>(count) - offset);
+		if (isPacketMode()) {
+			takePacketOverflow(rx_slice_.data(), slice.count * sizeof(float),
+			                   offset * sizeof(float));
+		} else {
+			retval = receiveExact(rx_slice_.data(), slice.count * sizeof(float),
+			                      "receiveFloatStreaming_safe");
+			if (retval != SocketReturnValue::ksuccess) {
+				return retval;
+			}
+		}
+		on_slice(slice);
+	}
+
+	arcforge::embedded::utils::Logger::GetInstance().Info(
+	    "receiveFloatStreaming_safe: Received " + std::to_string(count) + " floats.",
+	    kcurrent_lib_name);
+	return SocketReturnValue::ksuccess;
+}
+
+/*===================================================
+ * batched rx & tx
+ *===================================================*/
+// --- receiveFloatBatch_safe ---
+SocketReturnValue BaseImpl::receiveFloatBatch_safe(std::vector<AudioBuffer>& frames,
+                                                   size_t& frame_count, const Deadline& deadline) {
+	std::lock_guard<std::mutex> lock(*(receive_mutex_.get()));
+
+	frame_count = 0;
+	if (socketfd_ < 0) {
+		return SocketReturnValue::kfd_illegal;
+	}
+	if (frames.empty()) {
+		return SocketReturnValue::kbuffer_too_small;
+	}
+	SocketReturnValue ready = beginReceive(deadline, "receiveFloatBatch_safe");
+	if (ready != SocketReturnValue::ksuccess) {
+		return ready;
+	}
+
+	// the first frame waits like receiveFloat() and reports whatever is not a sample frame
+	SocketReturnValue retval = receiveFloatFrame(frames[0], "receiveFloatBatch_safe");
+	if (retval != SocketReturnValue::ksuccess) {
+		return retval;
+	}
+	frame_count = 1;
+
+	// the rest only takes what is already queued, so the batch never waits for more
+	const size_t limit = std::min(frames.size(), kmax_batch_frames);
+	if (isPacketMode()) {
+		frame_count += receivePacketBatch(frames, 1, limit);
+	} else {
+		while (frame_count < limit && takeStagedFloatFrame(frames[frame_count])) {
+			++frame_count;
+		}
+	}
+
+	arcforge::embedded::utils::Logger::GetInstance().Info(
+	    "receiveFloatBatch_safe: Received " + std::to_string(frame_count) + " frames.",
+	    kcurrent_lib_name);
+	return SocketReturnValue::ksuccess;
+}
+
+// --- stageAhead ---
+size_t BaseImpl::stageAhead(size_t want) {
+	size_t staged = rx_staging_end_ - rx_staging_begin_;
+	if (staged >= want || want > krx_batch_staging_size_) {
+		return staged;
+	}
+
+	// keep the staged bytes at the front so one read can fill the whole tail
+	if (rx_staging_.size() < krx_batch_staging_size_) {
+		rx_staging_.resize(krx_batch_staging_size_);
+	}
+	if (rx_staging_begin_ > 0) {
+		memmove(rx_staging_.data(), rx_staging_.data() + rx_staging_begin_, staged);
+		rx_staging_begin_ = 0;
+		rx_staging_end_ = staged;
+	}
+
+	while (rx_staging_end_ - rx_staging_begin_ < want) {
+		char* tail = rx_staging_.data() + rx_staging_end_;
+		const size_t room = rx_staging_.size() - rx_staging_end_;
+		ssize_t n_recv = 0;
+		if (rx_ring_ != nullptr) {
+			// zero timeout: only the completions that are already posted
+			n_recv = rx_ring_->receive(tail, room, 0);
+		} else {
+			struct iovec part;
+			part.iov_base = tail;
+			part.iov_len = room;
+			alignas(struct cmsghdr) char control[krx_control_bytes];
+			struct msghdr msg;
+			memset(&msg, 0, sizeof(msg));
+			msg.msg_iov = &part;
+			msg.msg_iovlen = 1;
+			msg.msg_control = control;
+			msg.msg_controllen = sizeof(control);
+			do {
+				n_recv = ::recvmsg(socketfd_, &msg, MSG_CMSG_CLOEXEC | MSG_DONTWAIT);
+			} while (n_recv < 0 && errno == EINTR);
+			if (n_recv > 0) {
+				collectAncillaryData(msg);
+			}
+		}
+		// nothing queued, EOF or an error: the next blocking receive reports it
+		if (n_recv <= 0) {
+			break;
+		}
+		rx_staging_end_ += static_cast<size_t>(n_recv);
+	}
+	return rx_staging_end_ - rx_staging_begin_;
+}
+
+// --- takeStagedFloatFrame ---
+bool BaseImpl::takeStagedFloatFrame(AudioBuffer& buffer) {
+	uint32_t count = 0;
+	if (stageAhead(sizeof(count)) < sizeof(count)) {
+		return false;
+	}
+	memcpy(&count, rx_staging_.data() + rx_staging_begin_, sizeof(count));
+	// EOF markers, tagged frames and oversized counts are left for the next receive call
+	if (count == 0 || count > kmax_frame_samples) {
+		return false;
+	}
+	const size_t frame_len = sizeof(count) + count * sizeof(float);
+	if (stageAhead(frame_len) < frame_len) {
+		return false;
+	}
+
+	// parsed in place: the samples go straight from the staging buffer to the caller
+	buffer.resize(count);
+	memcpy(buffer.data(), rx_staging_.data() + rx_staging_begin_ + sizeof(count),
+	       count * sizeof(float));
+	rx_staging_begin_ += frame_len;
+	if (rx_staging_begin_ == rx_staging_end_) {
+		rx_staging_begin_ = 0;
+		rx_staging_end_ = 0;
+	}
+	return true;
+}
+
+// --- receivePacketBatch ---
+size_t BaseImpl::receivePacketBatch(std::vector<AudioBuffer>& frames, size_t first,
+                                    size_t limit) {
+	const size_t slots = limit - first;
+	if (slots == 0 || queued_packets_.empty() == false) {
+		return 0;
+	}
+
+	// every packet lands in its frame's storage first, the part beyond it in the slot's own
+	// overflow area; untouched overflow pages are never faulted in
+	const size_t overflow_size = krx_packet_staging_size_;
+	if (rx_batch_overflow_ == nullptr) {
+		rx_batch_overflow_.reset(new char[kmax_batch_frames * overflow_size]);
+	}
+	constexpr size_t kcontrol_size = krx_control_bytes;
+	std::vector<uint32_t> headers(slots, 0);
+	std::vector<struct iovec> parts(slots * 3);
+	std::vector<struct mmsghdr> messages(slots);
+	std::vector<struct cmsghdr> control((slots * kcontrol_size + sizeof(struct cmsghdr) - 1) /
+	                                    sizeof(struct cmsghdr));
+	for (size_t i = 0; i < slots; ++i) {
+		AudioBuffer& buffer = frames[first + i];
+		struct iovec* slot = &parts[i * 3];
+		slot[0].iov_base = &headers[i];
+		slot[0].iov_len = sizeof(uint32_t);
+		slot[1].iov_base = buffer.data();
+		slot[1].iov_len = buffer.capacity() * sizeof(float);
+		slot[2].iov_base = rx_batch_overflow_.get() + i * overflow_size;
+		slot[2].iov_len = overflow_size;
+		memset(&messages[i], 0, sizeof(messages[i]));
+		messages[i].msg_hdr.msg_iov = slot;
+		messages[i].msg_hdr.msg_iovlen = 3;
+		messages[i].msg_hdr.msg_control =
+		    reinterpret_cast<char*>(control.data()) + i * kcontrol_size;
+		messages[i].msg_hdr.msg_controllen = kcontrol_size;
+	}
+
+	int received = 0;
+	do {
+		received = ::recvmmsg(socketfd_, messages.data(), static_cast<unsigned>(slots),
+		                      MSG_DONTWAIT | MSG_CMSG_CLOEXEC, nullptr);
+	} while (received < 0 && errno == EINTR);
+	if (received <= 0) {
+		return 0;
+	}
+
+	size_t taken = 0;
+	for (size_t i = 0; i < static_cast<size_t>(received); ++i) {
+		char* overflow = rx_batch_overflow_.get() + i * overflow_size;
+		collectAncillaryData(messages[i].msg_hdr);
+		if (queued_packets_.empty() == false) {
+			// behind a frame the caller has not seen yet, keep the order
+			queuePacket(messages[i], headers[i], frames[first + i], overflow);
+			continue;
+		}
+		AudioBuffer& buffer = frames[first + i];
+		const size_t bytes = messages[i].msg_len;
+		const uint32_t count = headers[i];
+		const size_t in_place = buffer.capacity() * sizeof(float);
+		const bool plain = (messages[i].msg_hdr.msg_flags & MSG_TRUNC) == 0 && count > 0 &&
+		                   count <= kmax_frame_samples &&
+		                   bytes == sizeof(uint32_t) + count * sizeof(float);
+		if (plain == false) {
+			// EOF marker, fd frame, ...: the next receive call reports it
+			queuePacket(messages[i], headers[i], buffer, overflow);
+			continue;
+		}
+		const size_t body_len = bytes - sizeof(uint32_t);
+		if (body_len <= in_place) {
+			buffer.resize(count);
+		} else {
+			buffer.resize(in_place / sizeof(float));
+			buffer.reserve(count);
+			buffer.resize(count);
+			memcpy(reinterpret_cast<char*>(buffer.data()) + in_place, overflow,
+			       body_len - in_place);
+		}
+		++taken;
+	}
+	return taken;
+}
+
+void BaseImpl::queuePacket(const struct mmsghdr& message, uint32_t header,
+                           const AudioBuffer& in_place, const char* overflow) {
+	if ((message.msg_hdr.msg_flags & MSG_TRUNC) != 0) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "receiveFloatBatch_safe: packet larger than the receive staging buffer, dropped.",
+		    kcurrent_lib_name);
+		return;
+	}
+	// reassemble [header | in-place part | overflow part] as one packet
+	const size_t bytes = message.msg_len;
+	const size_t in_place_len = in_place.capacity() * sizeof(float);
+	std::vector<char> packet(bytes);
+	const size_t header_len = std::min(bytes, sizeof(header));
+	memcpy(packet.data(), &header, header_len);
+	const size_t body_len = bytes - header_len;
+	const size_t head = std::min(body_len, in_place_len);
+	if (head > 0) {
+		memcpy(packet.data() + header_len, in_place.data(), head);
+	}
+	if (body_len > head) {
+		memcpy(packet.data() + header_len + head, overflow, body_len - head);
+	}
+	queued_packets_.push_back(std::move(packet));
+}
+
+// --- sendFloatBatch_safe ---
+SocketReturnValue BaseImpl::sendFloatBatch_safe(const std::vector<std::vector<float>>& frames,
+                                                size_t& frames_sent, const Deadline& deadline) {
+	std::lock_guard<std::mutex> lock(*(send_mutex_.get()));
+
+	frames_sent = 0;
+	if (socketfd_ < 0) {
+		return SocketReturnValue::kfd_illegal;
+	}
+	SocketReturnValue ready = beginSend(deadline, "sendFloatBatch_safe");
+	if (ready != SocketReturnValue::ksuccess) {
+		return ready;
+	}
+
+	// the batch is cut where the credit window runs out; EOF markers need no credit
+	size_t sample_frames = 0;
+	for (const auto& frame : frames) {
+		sample_frames += frame.empty() ? 0U : 1U;
+	}
+	uint32_t credits = takeSendCredits(kplain_session, static_cast<uint32_t>(sample_frames));
+	size_t limit = 0;
+	for (uint32_t left = credits; limit < frames.size(); ++limit) {
+		if (frames[limit].empty() == false) {
+			if (left == 0) {
+				break;
+			}
+			--left;
+		}
+	}
+
+	while (frames_sent < limit) {
+		const size_t chunk = std::min(limit - frames_sent, kmax_batch_frames);
+		const size_t before = frames_sent;
+		SocketReturnValue retval = SocketReturnValue::ksuccess;
+		if (tx_frame_metadata_) {
+			// the batch writers lay out bare headers, stamped frames go out one by one
+			const std::vector<float>& frame = frames[frames_sent];
+			retval = transmitSampleFrame(static_cast<uint32_t>(frame.size()), frame.data(),
+			                             frame.size() * sizeof(float), "sendFloatBatch_safe");
+			frames_sent += retval == SocketReturnValue::ksuccess ? 1U : 0U;
+		} else if (isPacketMode()) {
+			retval = transmitPacketBatch(frames, frames_sent, chunk, frames_sent);
+		} else {
+			retval = transmitStreamBatch(frames, frames_sent, chunk, frames_sent);
+		}
+		for (size_t i = before; i < frames_sent; ++i) {
+			credits -= frames[i].empty() ? 0U : 1U;
+		}
+		if (retval != SocketReturnValue::ksuccess) {
+			returnSendCredits(kplain_session, credits);
+			return retval;
+		}
+	}
+	if (limit < frames.size()) {
+		return refuseWithoutCredit(kplain_session, "sendFloatBatch_safe");
+	}
+
+	arcforge::embedded::utils::Logger::GetInstance().Info(
+	    "sendFloatBatch_safe: Sent " + std::to_string(frames_sent) + " frames.",
+	    kcurrent_lib_name);
+	return SocketReturnValue::ksuccess;
+}
+
+/*===================================================
+ * credit-based flow control
+ *===================================================*/
+uint32_t BaseImpl::takeSendCredits(StreamId stream, uint32_t wanted) {
+	std::lock_guard<std::mutex> lock(*(credit_mutex_.get()));
+
+	if (credit_window_ == 0) {
+		// no window agreed (no handshake, or a peer without one): nothing to count
+		return wanted;
+	}
+	uint32_t& inflight = inflight_chunks_[stream];
+	const uint32_t available = credit_window_ - std::min(inflight, credit_window_);
+	const uint32_t taken = std::min(wanted, available);
+	inflight += taken;
+	return taken;
+}
+
+void BaseImpl::returnSendCredits(StreamId stream, uint32_t count) {
+	std::lock_guard<std::mutex> lock(*(credit_mutex_.get()));
+
+	auto it = inflight_chunks_.find(stream);
+	if (credit_window_ == 0 || it == inflight_chunks_.end()) {
+		return;
+	}
+	it->second -= std::min(count, it->second);
+}
+
+SocketReturnValue BaseImpl::refuseWithoutCredit(StreamId stream, const std::string& caller) {
+	arcforge::embedded::utils::Logger::GetInstance().Warning(
+	    caller + ": stream " + std::to_string(stream) +
+	        " has no send credit left, receive a result first",
+	    kcurrent_lib_name);
+	return SocketReturnValue::kno_send_credit;
+}
+
+uint32_t BaseImpl::getSendCredits_safe(StreamId stream) {
+	std::lock_guard<std::mutex> lock(*(credit_mutex_.get()));
+
+	if (credit_window_ == 0) {
+		return kunlimited_send_credits;
+	}
+	auto it = inflight_chunks_.find(stream);
+	const uint32_t inflight = it == inflight_chunks_.end() ? 0 : it->second;
+	return credit_window_ - std::min(inflight, credit_window_);
+}
+
+// --- transmitStreamBatch ---
+SocketReturnValue BaseImpl::transmitStreamBatch(const std::vector<std::vector<float>>& frames,
+                                                size_t first, size_t count, size_t& frames_sent) {
+	// [count0 | samples0 | count1 | samples1 ...] leave in one sendmsg()
+	std::vector<uint32_t> headers(count);
+	std::vector<struct iovec> parts;
+	parts.reserve(count * 2);
+	std::vector<size_t> frame_end(count);
+	size_t bytes_to_send = 0;
+	for (size_t i = 0; i < count; ++i) {
+		const std::vector<float>& frame = frames[first + i];
+		headers[i] = static_cast<uint32_t>(frame.size());
+		parts.push_back({&headers[i], sizeof(uint32_t)});
+		if (frame.empty() == false) {
+			parts.push_back(
+			    {const_cast<float*>(frame.data()), frame.size() * sizeof(float)});
+		}
+		bytes_to_send += sizeof(uint32_t) + frame.size() * sizeof(float);
+		frame_end[i] = bytes_to_send;
+	}
+
+	size_t bytes_has_sent = 0;
+	size_t part_index = 0;
+	size_t frames_done = 0;
+	while (bytes_has_sent < bytes_to_send) {
+		struct msghdr msg;
+		memset(&msg, 0, sizeof(msg));
+		msg.msg_iov = &parts[part_index];
+		msg.msg_iovlen = parts.size() - part_index;
+
+		ssize_t n_sent = ::sendmsg(socketfd_, &msg, MSG_NOSIGNAL | MSG_DONTWAIT);
+		if (n_sent < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			if (errno == EAGAIN || errno == EWOULDBLOCK) {
+				SocketReturnValue retval = waitForSocket(
+				    POLLOUT, tx_deadline_, SocketReturnValue::ksenddata_failed,
+				    "sendFloatBatch_safe");
+				if (retval == SocketReturnValue::ksuccess) {
+					continue;
+				}
+				if (retval == SocketReturnValue::kio_timeout &&
+				    (frames_done == 0 ? bytes_has_sent > 0
+				                      : bytes_has_sent != frame_end[frames_done - 1])) {
+					tx_out_of_sync_ = true;
+					arcforge::embedded::utils::Logger::GetInstance().Error(
+					    "sendFloatBatch_safe: deadline expired in the middle of a frame",
+					    kcurrent_lib_name);
+				}
+				return retval;
+			}
+			arcforge::embedded::utils::Logger::GetInstance().Error(
+			    "sendFloatBatch_safe: sendmsg() error. errno: " + std::to_string(errno),
+			    kcurrent_lib_name);
+			return SocketReturnValue::ksenddata_failed;
+		}
+
+		bytes_has_sent += static_cast<size_t>(n_sent);
+		while (frames_done < count && frame_end[frames_done] <= bytes_has_sent) {
+			++frames_done;
+			++frames_sent;
+		}
+		// skip the parts that are out, trim the one that left only partly
+		size_t advance = static_cast<size_t>(n_sent);
+		while (advance > 0 && part_index < parts.size()) {
+			if (advance >= parts[part_index].iov_len) {
+				advance -= parts[part_index].iov_len;
+				++part_index;
+			} else {
+				parts[part_index].iov_base =
+				    static_cast<char*>(parts[part_index].iov_base) + advance;
+				parts[part_index].iov_len -= advance;
+				advance = 0;
+			}
+		}
+	}
+	return SocketReturnValue::ksuccess;
+}
+
+// --- transmitPacketBatch ---
+SocketReturnValue BaseImpl::transmitPacketBatch(const std::vector<std::vector<float>>& frames,
+                                                size_t first, size_t count, size_t& frames_sent) {
+	// one packet per frame, handed to the kernel with a single sendmmsg()
+	std::vector<uint32_t> headers(count);
+	std::vector<struct iovec> parts(count * 2);
+	std::vector<struct mmsghdr> messages(count);
+	for (size_t i = 0; i < count; ++i) {
+		const std::vector<float>& frame = frames[first + i];
+		headers[i] = static_cast<uint32_t>(frame.size());
+		parts[i * 2] = {&headers[i], sizeof(uint32_t)};
+		parts[i * 2 + 1] = {const_cast<float*>(frame.data()), frame.size() * sizeof(float)};
+		memset(&messages[i], 0, sizeof(messages[i]));
+		messages[i].msg_hdr.msg_iov = &parts[i * 2];
+		messages[i].msg_hdr.msg_iovlen = frame.empty() ? 1 : 2;
+	}
+
+	size_t done = 0;
+	while (done < count) {
+		int n_sent = ::sendmmsg(socketfd_, &messages[done], static_cast<unsigned>(count - done),
+		                        MSG_NOSIGNAL | MSG_DONTWAIT);
+		if (n_sent < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			if (errno == EAGAIN || errno == EWOULDBLOCK) {
+				// packets are never split, a timeout here leaves the framing intact
+				SocketReturnValue retval = waitForSocket(
+				    POLLOUT, tx_deadline_, SocketReturnValue::ksenddata_failed,
+				    "sendFloatBatch_safe");
+				if (retval == SocketReturnValue::ksuccess) {
+					continue;
+				}
+				return retval;
+			}
+			if (errno == EMSGSIZE) {
+				arcforge::embedded::utils::Logger::GetInstance().Error(
+				    "sendFloatBatch_safe: frame exceeds the socket send buffer, raise SO_SNDBUF",
+				    kcurrent_lib_name);
+			}
+			arcforge::embedded::utils::Logger::GetInstance().Error(
+			    "sendFloatBatch_safe: sendmmsg() error. errno: " + std::to_string(errno),
+			    kcurrent_lib_name);
+			return SocketReturnValue::ksenddata_failed;
+		}
+		done += static_cast<size_t>(n_sent);
+		frames_sent += static_cast<size_t>(n_sent);
+	}
+	return SocketReturnValue::ksuccess;
+}
+
+SocketReturnValue BaseImpl::receiveFloatCount(uint32_t& count) {
+	// arcforge::embedded::utils::Logger::GetInstance().Info("receiveFloat_safe(): before ::recv line 113");
+	arcforge::embedded::utils::Logger::GetInstance().Debug(
+	    "receiveFloat_safe(): before ::recv line 113", kcurrent_lib_name);
+	// receive length that we need to read the data
+	SocketReturnValue retval =
+	    receiveSampleHeader(SampleEncoding::kfloat32, count, "receiveFloat_safe");
+	// arcforge::embedded::utils::Logger::GetInstance().Info("receiveFloat_safe(): after ::recv line 117");
+	arcforge::embedded::utils::Logger::GetInstance().Debug(
+	    "receiveFloat_safe(): after ::recv line 117", kcurrent_lib_name);
+	return retval;
+}
+
+// --- receiveSampleHeader ---
+SocketReturnValue BaseImpl::receiveSampleHeader(SampleEncoding expected, uint32_t& count,
+                                                const std::string& caller) {
+	uint32_t header = 0;
+	SocketReturnValue retval = receiveExact(&header, sizeof(header), caller);
+	if (retval != SocketReturnValue::ksuccess) {
+		count = 0;
+		return retval;
+	}
+
+	SampleEncoding frame_encoding = expected;
+	retval = validateSampleHeader(header, expected, count, frame_encoding, caller);
+	if (retval == SocketReturnValue::kreceived_hello) {
+		// keep the body for takeHello_safe(). The hello does not count as the opening frame,
+		// an fd offer may still follow it, so the rx ring stays detached.
+		pending_hello_.assign((count + sizeof(uint32_t) - 1) / sizeof(uint32_t), 0);
+		rx_opening_frame_done_ = false;
+		SocketReturnValue body = receiveExact(pending_hello_.data(), count, caller);
+		rx_opening_frame_done_ = false;
+		count = 0;
+		return body == SocketReturnValue::ksuccess ? retval : body;
+	}
+	if ((retval == SocketReturnValue::ksuccess ||
+	     retval == SocketReturnValue::ksample_encoding_mismatch) &&
+	    rx_frame_info_.has_metadata) {
+		uint32_t words[kframe_metadata_words] = {};
+		SocketReturnValue metadata = receiveExact(words, sizeof(words), caller);
+		if (metadata != SocketReturnValue::ksuccess) {
+			count = 0;
+			return metadata;
+		}
+		takeFrameMetadata(words);
+	}
+	if (retval == SocketReturnValue::ksample_encoding_mismatch) {
+		// drop the whole frame so the next header is read from the right place
+		SocketReturnValue drained =
+		    discardExact(static_cast<size_t>(count) * SampleBytes(frame_encoding), caller);
+		count = 0;
+		return drained == SocketReturnValue::ksuccess ? retval : drained;
+	}
+	return retval;
+}
+
+SocketReturnValue BaseImpl::validateSamplePacket(uint32_t header, SampleEncoding expected,
+                                                 uint32_t& count, const void* body_in_place,
+                                                 size_t in_place_capacity, size_t& body_len,
+                                                 const std::string& caller) {
+	// the packet is gone whatever the outcome, nothing to drain
+	SampleEncoding frame_encoding = expected;
+	SocketReturnValue retval =
+	    validateSampleHeader(header, expected, count, frame_encoding, caller);
+	if (retval == SocketReturnValue::kreceived_hello) {
+		if (body_len != count) {
+			return SocketReturnValue::kreceivelength_failed;
+		}
+		const size_t in_place = body_in_place != nullptr ? std::min(body_len, in_place_capacity)
+		                                                 : 0;
+		pending_hello_.assign((body_len + sizeof(uint32_t) - 1) / sizeof(uint32_t), 0);
+		char* words = reinterpret_cast<char*>(pending_hello_.data());
+		if (in_place > 0) {
+			memcpy(words, body_in_place, in_place);
+		}
+		takePacketOverflow(words + in_place, body_len - in_place);
+		count = 0;
+		return retval;
+	}
+	if (retval != SocketReturnValue::ksuccess) {
+		return retval;
+	}
+	const size_t sample_bytes = static_cast<size_t>(count) * SampleBytes(expected);
+	uint32_t words[kframe_metadata_words] = {};
+	if (rx_frame_info_.has_metadata && body_len == sample_bytes + sizeof(words)) {
+		// the trailer may straddle the caller's storage and the staging buffer
+		char* trailer = reinterpret_cast<char*>(words);
+		const size_t in_place = body_in_place != nullptr ? std::min(body_len, in_place_capacity)
+		                                                 : 0;
+		const size_t head =
+		    sample_bytes < in_place ? std::min(in_place - sample_bytes, sizeof(words)) : 0;
+		if (head > 0) {
+			memcpy(trailer, static_cast<const char*>(body_in_place) + sample_bytes, head);
+		}
+		if (head < sizeof(words)) {
+			takePacketOverflow(trailer + head, sizeof(words) - head,
+			                   sample_bytes + head - in_place);
+		}
+		takeFrameMetadata(words);
+		body_len = sample_bytes;
+	}
+	if (body_len != sample_bytes) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    caller + ": packet holds " + std::to_string(body_len) + " bytes for " +
+		        std::to_string(count) + " samples",
+		    kcurrent_lib_name);
+		return SocketReturnValue::kreceivelength_failed;
+	}
+
+	arcforge::embedded::utils::Logger::GetInstance().Info(
+	    caller + ": Received " + std::to_string(count) + " samples.", kcurrent_lib_name);
+	return SocketReturnValue::ksuccess;
+}
+
+void BaseImpl::takeFrameMetadata(const uint32_t (&words)[kframe_metadata_words]) {
+	rx_frame_info_.sequence = words[0];
+	const uint64_t sent_ns =
+	    static_cast<uint64_t>(words[1]) | static_cast<uint64_t>(words[2]) << 32;
+	rx_frame_info_.sent_ns = static_cast<int64_t>(sent_ns);
+}
+
+SocketReturnValue BaseImpl::validateSampleHeader(uint32_t header, SampleEncoding expected,
+                                                 uint32_t& count, SampleEncoding& frame_encoding,
+                                                 const std::string& caller) {
+	count = 0;
+	if ((header & kfd_frame_tag_mask) == kfd_frame_tag) {
+		// the peer passed fds instead of samples, they wait in passed_fds_ for receiveFDs
+		arcforge::embedded::utils::Logger::GetInstance().Info(
+		    caller + ": Received " + std::to_string(passed_fds_.size()) + " passed fds.",
+		    kcurrent_lib_name);
+		return SocketReturnValue::kreceived_fds;
+	}
+	if ((header & ksample_frame_tag_mask) == kencoding_offer_tag) {
+		// answered by acceptSampleEncoding_safe()
+		pending_encoding_offer_ = header;
+		arcforge::embedded::utils::Logger::GetInstance().Info(
+		    caller + ": Received a sample encoding offer.", kcurrent_lib_name);
+		return SocketReturnValue::kreceived_encoding_offer;
+	}
+	if ((header & ksample_frame_tag_mask) == khello_tag) {
+		// count is the body length in bytes here, the caller stores the body
+		count = header & ksample_frame_count_mask;
+		if (count > kmax_hello_bytes) {
+			arcforge::embedded::utils::Logger::GetInstance().Error(
+			    caller + ": hello frame of " + std::to_string(count) + " bytes refused",
+			    kcurrent_lib_name);
+			count = 0;
+			return SocketReturnValue::kcount_too_large;
+		}
+		arcforge::embedded::utils::Logger::GetInstance().Info(
+		    caller + ": Received a session hello.", kcurrent_lib_name);
+		return SocketReturnValue::kreceived_hello;
+	}
+
+	// a sample frame from here on: its timing replaces the previous frame's
+	rx_frame_info_ = FrameInfo();
+	rx_frame_info_.has_metadata = (header & kframe_metadata_bit) != 0;
+	rx_frame_info_.kernel_rx_ns = rx_kernel_ns_;
+	header &= ~kframe_metadata_bit;
+
+	switch (header & ksample_frame_tag_mask) {
+		case kpcm16_frame_tag:
+			frame_encoding = SampleEncoding::kpcm16;
+			count = header & ksample_frame_count_mask;
+			break;
+		case kmulaw_frame_tag:
+			frame_encoding = SampleEncoding::kmulaw;
+			count = header & ksample_frame_count_mask;
+			break;
+		default:
+			frame_encoding = SampleEncoding::kfloat32;
+			count = header;
+			break;
+	}
+
+	std::ostringstream temp_str;
+	temp_str << caller << ": count=" << count;
+	// arcforge::embedded::utils::Logger::GetInstance().Info(temp_str.str());
+	arcforge::embedded::utils::Logger::GetInstance().Info(temp_str.str(), kcurrent_lib_name);
+
+	// optional: sanity check on count
+	if (count > kmax_frame_samples) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    caller + ": Received count (" + std::to_string(count) + ") exceeds " +
+		        std::to_string(kmax_frame_samples) + " samples. Aborting.",
+		    kcurrent_lib_name);
+		count = 0;
+		return SocketReturnValue::kcount_too_large;
+	}
+	if (count == 0) {
+		// end of file, empty block (in any encoding)
+		// arcforge::embedded::utils::Logger::GetInstance().Info("receiveFloat_safe: Received EOF marker (empty chunk)");
+		arcforge::embedded::utils::Logger::GetInstance().Warning(
+		    caller + ": Received EOF marker (empty chunk)", kcurrent_lib_name);
+		return SocketReturnValue::keof;
+	}
+	if (frame_encoding != expected) {
+		// count stays set, the stream receive needs it to drop the body
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    caller + ": frame of " + std::to_string(count) + " samples in encoding 0x" +
+		        ToHex(static_cast<uint32_t>(frame_encoding)) + " dropped, expected 0x" +
+		        ToHex(static_cast<uint32_t>(expected)),
+		    kcurrent_lib_name);
+		return SocketReturnValue::ksample_encoding_mismatch;
+	}
+
+	return SocketReturnValue::ksuccess;
+}
+
+SocketReturnValue BaseImpl::receiveFloatBody(float* dst, uint32_t count) {
+	SocketReturnValue retval = receiveExact(dst, count * sizeof(float), "receiveFloat_safe");
+	if (retval != SocketReturnValue::ksuccess) {
+		return retval;
+	}
+
+	arcforge::embedded::utils::Logger::GetInstance().Info(
+	    "receiveFloat_safe: Received " + std::to_string(count) + " floats.", kcurrent_lib_name);
+	return SocketReturnValue::ksuccess;
+}
+
+/*===================================================
+ * compact sample frames & encoding negotiation
+ *===================================================*/
+// --- receiveSamples ---
+template <typename Sample>
+SocketReturnValue BaseImpl::receiveSamples(std::vector<Sample>& samples, SampleEncoding encoding,
+                                           const std::string& caller) {
+	if (isPacketMode()) {
+		const size_t in_place_capacity = samples.size() * sizeof(Sample);
+		uint32_t header = 0;
+		uint32_t count = 0;
+		size_t body_len = 0;
+		SocketReturnValue retval = receivePacket(&header, sizeof(header), samples.data(),
+		                                         in_place_capacity, body_len, caller);
+		if (retval == SocketReturnValue::ksuccess) {
+			retval = validateSamplePacket(header, encoding, count, samples.data(),
+			                              in_place_capacity, body_len, caller);
+		}
+		if (retval != SocketReturnValue::ksuccess) {
+			samples.clear();
+			return retval;
+		}
+		samples.resize(count);
+		if (body_len > in_place_capacity) {
+			takePacketOverflow(reinterpret_cast<char*>(samples.data()) + in_place_capacity,
+			                   body_len - in_place_capacity);
+		}
+		return retval;
+	}
+
+	uint32_t count = 0;
+	SocketReturnValue retval = receiveSampleHeader(encoding, count, caller);
+	if (retval != SocketReturnValue::ksuccess) {
+		samples.clear();
+		return retval;
+	}
+
+	samples.resize(count);
+	retval = receiveExact(samples.data(), count * sizeof(Sample), caller);
+	if (retval != SocketReturnValue::ksuccess) {
+		samples.clear();
+		return retval;
+	}
+	arcforge::embedded::utils::Logger::GetInstance().Info(
+	    caller + ": Received " + std::to_string(count) + " samples.", kcurrent_lib_name);
+	return retval;
+}
+
+// --- transmitSamples ---
+SocketReturnValue BaseImpl::transmitSamples(uint32_t tag, const void* samples, size_t count,
+                                            size_t sample_bytes, const std::string& caller) {
+	if (count > kmax_frame_samples) {
+		return SocketReturnValue::kcount_too_large;
+	}
+
+	const uint32_t credits = count > 0 ? 1 : 0;
+	if (takeSendCredits(kplain_session, credits) < credits) {
+		return refuseWithoutCredit(kplain_session, caller);
+	}
+
+	uint32_t header = tag | static_cast<uint32_t>(count);
+	SocketReturnValue retval = transmitSampleFrame(header, samples, count * sample_bytes, caller);
+	if (retval != SocketReturnValue::ksuccess) {
+		returnSendCredits(kplain_session, credits);
+		return retval;
+	}
+	arcforge::embedded::utils::Logger::GetInstance().Info(
+	    caller + ": Sent " + std::to_string(count) + " samples.", kcurrent_lib_name);
+	return SocketReturnValue::ksuccess;
+}
+
+// --- transmitSampleFrame ---
+SocketReturnValue BaseImpl::transmitSampleFrame(uint32_t header, const void* body,
+                                                size_t body_len, const std::string& caller) {
+	// an empty frame (EOF) never carries metadata
+	if (tx_frame_metadata_ == false || body_len == 0) {
+		return transmitFrame(&header, sizeof(header), body, body_len,
+		                     SocketReturnValue::ksendcount_failed, caller);
+	}
+
+	const uint64_t sent_ns = static_cast<uint64_t>(
+	    std::chrono::duration_cast<std::chrono::nanoseconds>(
+	        std::chrono::steady_clock::now().time_since_epoch())
+	        .count());
+	// [header | metadata] in front of the body on a stream, metadata behind it in a packet
+	uint32_t words[1 + kframe_metadata_words] = {
+	    header | kframe_metadata_bit, tx_frame_sequence_, static_cast<uint32_t>(sent_ns),
+	    static_cast<uint32_t>(sent_ns >> 32)};
+	SocketReturnValue retval = SocketReturnValue::ksuccess;
+	if (isPacketMode()) {
+		retval = transmitFrame(words, sizeof(uint32_t), body, body_len,
+		                       SocketReturnValue::ksendcount_failed, caller, words + 1,
+		                       kframe_metadata_words * sizeof(uint32_t));
+	} else {
+		retval = transmitFrame(words, sizeof(words), body, body_len,
+		                       SocketReturnValue::ksendcount_failed, caller);
+	}
+	if (retval == SocketReturnValue::ksuccess) {
+		++tx_frame_sequence_;
+	}
+	return retval;
+}
+
+SocketReturnValue BaseImpl::sendPcm16_safe(const int16_t* samples, size_t count,
+                                           const Deadline& deadline) {
+	std::lock_guard<std::mutex> lock(*(send_mutex_.get()));
+
+	if (socketfd_ < 0) {
+		return SocketReturnValue::kfd_illegal;
+	}
+	SocketReturnValue ready = beginSend(deadline, "sendPcm16_safe");
+	if (ready != SocketReturnValue::ksuccess) {
+		return ready;
+	}
+
+	return transmitSamples(kpcm16_frame_tag, samples, count, sizeof(int16_t), "sendPcm16_safe");
+}
+
+SocketReturnValue BaseImpl::receivePcm16_safe(std::vector<int16_t>& samples,
+                                              const Deadline& deadline) {
+	std::lock_guard<std::mutex> lock(*(receive_mutex_.get()));
+
+	if (socketfd_ < 0) {
+		return SocketReturnValue::kfd_illegal;
+	}
+	SocketReturnValue ready = beginReceive(deadline, "receivePcm16_safe");
+	if (ready != SocketReturnValue::ksuccess) {
+		return ready;
+	}
+
+	return receiveSamples(samples, SampleEncoding::kpcm16, "receivePcm16_safe");
+}
+
+SocketReturnValue BaseImpl::sendMulaw_safe(const uint8_t* samples, size_t count,
+                                           const Deadline& deadline) {
+	std::lock_guard<std::mutex> lock(*(send_mutex_.get()));
+
+	if (socketfd_ < 0) {
+		return SocketReturnValue::kfd_illegal;
+	}
+	SocketReturnValue ready = beginSend(deadline, "sendMulaw_safe");
+	if (ready != SocketReturnValue::ksuccess) {
+		return ready;
+	}
+
+	return transmitSamples(kmulaw_frame_tag, samples, count, sizeof(uint8_t), "sendMulaw_safe");
+}
+
+SocketReturnValue BaseImpl::receiveMulaw_safe(std::vector<uint8_t>& samples,
+                                              const Deadline& deadline) {
+	std::lock_guard<std::mutex> lock(*(receive_mutex_.get()));
+
+	if (socketfd_ < 0) {
+		return SocketReturnValue::kfd_illegal;
+	}
+	SocketReturnValue ready = beginReceive(deadline, "receiveMulaw_safe");
+	if (ready != SocketReturnValue::ksuccess) {
+		return ready;
+	}
+
+	return receiveSamples(samples, SampleEncoding::kmulaw, "receiveMulaw_safe");
+}
+
+/*----------------------------------
+ * negotiation: the client sends an offer frame carrying its preferred encoding, the
+ * server's next sample receive reports it (kreceived_encoding_offer) and
+ * acceptSampleEncoding_safe() answers with the encoding both sides will use. Anything the
+ * server does not know falls back to float32, which every peer speaks.
+ *--------------------------------- */
+SocketReturnValue BaseImpl::negotiateSampleEncoding_safe(SampleEncoding preferred,
+                                                         SampleEncoding& agreed) {
+	agreed = SampleEncoding::kfloat32;
+	{
+		std::lock_guard<std::mutex> lock(*(send_mutex_.get()));
+		if (socketfd_ < 0) {
+			return SocketReturnValue::kfd_illegal;
+		}
+		SocketReturnValue ready = beginSend(kno_deadline, "negotiateSampleEncoding_safe");
+		if (ready != SocketReturnValue::ksuccess) {
+			return ready;
+		}
+		uint32_t offer = kencoding_offer_tag | static_cast<uint32_t>(preferred);
+		SocketReturnValue retval =
+		    transmitFrame(&offer, sizeof(offer), nullptr, 0, SocketReturnValue::ksendcount_failed,
+		                  "negotiateSampleEncoding_safe");
+		if (retval != SocketReturnValue::ksuccess) {
+			return retval;
+		}
+	}
+
+	uint32_t answer = 0;
+	{
+		std::lock_guard<std::mutex> lock(*(receive_mutex_.get()));
+		if (socketfd_ < 0) {
+			return SocketReturnValue::kfd_illegal;
+		}
+		SocketReturnValue retval = beginReceive(kno_deadline, "negotiateSampleEncoding_safe");
+		if (retval != SocketReturnValue::ksuccess) {
+			return retval;
+		}
+		size_t body_len = 0;
+		retval = isPacketMode() ? receivePacket(&answer, sizeof(answer), nullptr, 0, body_len,
+		                                        "negotiateSampleEncoding_safe")
+		                        : receiveExact(&answer, sizeof(answer),
+		                                       "negotiateSampleEncoding_safe");
+		if (retval != SocketReturnValue::ksuccess) {
+			return retval;
+		}
+	}
+
+	SampleEncoding chosen = SampleEncoding::kfloat32;
+	if ((answer & ksample_frame_tag_mask) != kencoding_answer_tag ||
+	    DecodeSampleEncoding(answer, chosen) == false) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "negotiateSampleEncoding_safe: peer did not answer the encoding offer",
+		    kcurrent_lib_name);
+		return SocketReturnValue::kreceived_illegal;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(*(socket_mutex_.get()));
+		sample_encoding_ = chosen;
+	}
+	agreed = chosen;
+	arcforge::embedded::utils::Logger::GetInstance().Info(
+	    "negotiateSampleEncoding_safe: agreed on encoding 0x" +
+	        ToHex(static_cast<uint32_t>(chosen)),
+	    kcurrent_lib_name);
+	return SocketReturnValue::ksuccess;
+}
+
+SocketReturnValue BaseImpl::acceptSampleEncoding_safe(SampleEncoding& agreed) {
+	agreed = SampleEncoding::kfloat32;
+	uint32_t offer = 0;
+	{
+		std::lock_guard<std::mutex> lock(*(receive_mutex_.get()));
+		offer = pending_encoding_offer_;
+		pending_encoding_offer_ = 0;
+	}
+	if (offer == 0) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "acceptSampleEncoding_safe: no encoding offer pending", kcurrent_lib_name);
+		return SocketReturnValue::kreceived_null;
+	}
+
+	SampleEncoding chosen = SampleEncoding::kfloat32;
+	if (DecodeSampleEncoding(offer, chosen) == false) {
+		chosen = SampleEncoding::kfloat32;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(*(send_mutex_.get()));
+		if (socketfd_ < 0) {
+			return SocketReturnValue::kfd_illegal;
+		}
+		SocketReturnValue ready = beginSend(kno_deadline, "acceptSampleEncoding_safe");
+		if (ready != SocketReturnValue::ksuccess) {
+			return ready;
+		}
+		uint32_t answer = kencoding_answer_tag | static_cast<uint32_t>(chosen);
+		SocketReturnValue retval =
+		    transmitFrame(&answer, sizeof(answer), nullptr, 0, SocketReturnValue::ksendcount_failed,
+		                  "acceptSampleEncoding_safe");
+		if (retval != SocketReturnValue::ksuccess) {
+			return retval;
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(*(socket_mutex_.get()));
+		sample_encoding_ = chosen;
+	}
+	agreed = chosen;
+	arcforge::embedded::utils::Logger::GetInstance().Info(
+	    "acceptSampleEncoding_safe: agreed on encoding 0x" +
+	        ToHex(static_cast<uint32_t>(chosen)),
+	    kcurrent_lib_name);
+	return SocketReturnValue::ksuccess;
+}
+
+SampleEncoding BaseImpl::getSampleEncoding_safe() {
+	std::lock_guard<std::mutex> lock(*(socket_mutex_.get()));
+
+	return sample_encoding_;
+}
+
+/*----------------------------------
+ * multiplexed streams: [prefix][sample header or text length][body]. The inner header is
+ * the one plain frames use, so an empty sample frame still means EOF, of that stream only.
+ *--------------------------------- */
+SocketReturnValue BaseImpl::sendStreamSamples_safe(StreamId stream, SampleEncoding encoding,
+                                                   const void* samples, size_t count,
+                                                   const Deadline& deadline) {
+	std::lock_guard<std::mutex> lock(*(send_mutex_.get()));
+
+	if (socketfd_ < 0) {
+		return SocketReturnValue::kfd_illegal;
+	}
+	SocketReturnValue ready = beginSend(deadline, "sendStreamSamples_safe");
+	if (ready != SocketReturnValue::ksuccess) {
+		return ready;
+	}
+	if (count > kmax_frame_samples) {
+		return SocketReturnValue::kcount_too_large;
+	}
+
+	uint32_t words[2];
+	words[0] = kmux_frame_tag |
+	           (static_cast<uint32_t>(StreamFrameKind::ksamples) << kmux_kind_shift) | stream;
+	switch (encoding) {
+		case SampleEncoding::kpcm16:
+			words[1] = kpcm16_frame_tag | static_cast<uint32_t>(count);
+			break;
+		case SampleEncoding::kmulaw:
+			words[1] = kmulaw_frame_tag | static_cast<uint32_t>(count);
+			break;
+		case SampleEncoding::kfloat32:
+		default:
+			words[1] = static_cast<uint32_t>(count);
+			break;
+	}
+	const uint32_t credits = count > 0 ? 1 : 0;
+	if (takeSendCredits(stream, credits) < credits) {
+		return refuseWithoutCredit(stream, "sendStreamSamples_safe");
+	}
+	SocketReturnValue retval =
+	    transmitFrame(words, sizeof(words), samples, count * SampleBytes(encoding),
+	                  SocketReturnValue::ksendcount_failed, "sendStreamSamples_safe");
+	if (retval != SocketReturnValue::ksuccess) {
+		returnSendCredits(stream, credits);
+	}
+	return retval;
+}
+
+SocketReturnValue BaseImpl::sendStreamString_safe(StreamId stream, const std::string& message,
+                                                  const Deadline& deadline) {
+	std::lock_guard<std::mutex> lock(*(send_mutex_.get()));
+
+	if (socketfd_ < 0) {
+		return SocketReturnValue::kfd_illegal;
+	}
+	SocketReturnValue ready = beginSend(deadline, "sendStreamString_safe");
+	if (ready != SocketReturnValue::ksuccess) {
+		return ready;
+	}
+	if (message.size() > kmax_text_bytes) {
+		return SocketReturnValue::kcount_too_large;
+	}
+
+	// an empty text is a valid (empty) result here, not a marker
+	uint32_t words[2];
+	words[0] = kmux_frame_tag |
+	           (static_cast<uint32_t>(StreamFrameKind::ktext) << kmux_kind_shift) | stream;
+	words[1] = static_cast<uint32_t>(message.size());
+	return transmitFrame(words, sizeof(words), message.data(), message.size(),
+	                     SocketReturnValue::ksendlength_failed, "sendStreamString_safe");
+}
+
+SocketReturnValue BaseImpl::receiveStreamFrame_safe(StreamFrame& frame,
+                                                    const Deadline& deadline) {
+	std::lock_guard<std::mutex> lock(*(receive_mutex_.get()));
+
+	frame.count = 0;
+	if (socketfd_ < 0) {
+		return SocketReturnValue::kfd_illegal;
+	}
+	SocketReturnValue ready = beginReceive(deadline, "receiveStreamFrame_safe");
+	if (ready != SocketReturnValue::ksuccess) {
+		return ready;
+	}
+
+	uint32_t words[2] = {0, 0};
+	size_t body_len = 0;
+	if (isPacketMode()) {
+		const size_t in_place_capacity = frame.payload.size();
+		size_t packet_body_len = 0;
+		SocketReturnValue retval =
+		    receivePacket(words, sizeof(words), frame.payload.data(), in_place_capacity,
+		                  packet_body_len, "receiveStreamFrame_safe");
+		if (retval == SocketReturnValue::ksuccess) {
+			retval = validateStreamHeader(words, frame, body_len, "receiveStreamFrame_safe");
+		}
+		if (retval != SocketReturnValue::ksuccess) {
+			return retval;
+		}
+		if (packet_body_len != body_len) {
+			frame.count = 0;
+			return SocketReturnValue::kreceivelength_failed;
+		}
+		if (body_len > in_place_capacity) {
+			frame.payload.resize(body_len);
+			takePacketOverflow(frame.payload.data() + in_place_capacity,
+			                   body_len - in_place_capacity);
+		}
+		if (frame.kind == StreamFrameKind::ktext) {
+			returnSendCredits(frame.stream, 1);
+		}
+		return retval;
+	}
+
+	SocketReturnValue retval = receiveExact(words, sizeof(words), "receiveStreamFrame_safe");
+	if (retval == SocketReturnValue::ksuccess) {
+		retval = validateStreamHeader(words, frame, body_len, "receiveStreamFrame_safe");
+	}
+	if (retval != SocketReturnValue::ksuccess) {
+		return retval;
+	}
+	if (frame.payload.size() < body_len) {
+		frame.payload.resize(body_len);
+	}
+	retval = receiveExact(frame.payload.data(), body_len, "receiveStreamFrame_safe");
+	if (retval != SocketReturnValue::ksuccess) {
+		frame.count = 0;
+	} else if (frame.kind == StreamFrameKind::ktext) {
+		// a result answers the oldest chunk of its stream
+		returnSendCredits(frame.stream, 1);
+	}
+	return retval;
+}
+
+SocketReturnValue BaseImpl::validateStreamHeader(const uint32_t (&words)[2], StreamFrame& frame,
+                                                 size_t& body_len, const std::string& caller) {
+	body_len = 0;
+	if ((words[0] & ksample_frame_tag_mask) != kmux_frame_tag) {
+		// a plain frame on a multiplexed connection: its length is unknown from here
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    caller + ": frame without a stream prefix (0x" + ToHex(words[0]) + ")",
+		    kcurrent_lib_name);
+		rx_out_of_sync_ = !isPacketMode();
+		return SocketReturnValue::kreceived_illegal;
+	}
+	frame.stream = static_cast<StreamId>(words[0] & kmux_stream_mask);
+
+	const uint32_t kind = (words[0] & kmux_kind_mask) >> kmux_kind_shift;
+	if (kind == static_cast<uint32_t>(StreamFrameKind::ktext)) {
+		frame.kind = StreamFrameKind::ktext;
+		frame.count = words[1];
+		if (frame.count > kmax_text_bytes) {
+			frame.count = 0;
+			return SocketReturnValue::kcount_too_large;
+		}
+		body_len = frame.count;
+		return SocketReturnValue::ksuccess;
+	}
+
+	frame.kind = StreamFrameKind::ksamples;
+	switch (words[1] & ksample_frame_tag_mask) {
+		case kpcm16_frame_tag:
+			frame.encoding = SampleEncoding::kpcm16;
+			frame.count = words[1] & ksample_frame_count_mask;
+			break;
+		case kmulaw_frame_tag:
+			frame.encoding = SampleEncoding::kmulaw;
+			frame.count = words[1] & ksample_frame_count_mask;
+			break;
+		default:
+			frame.encoding = SampleEncoding::kfloat32;
+			frame.count = words[1];
+			break;
+	}
+	if (frame.count > kmax_frame_samples) {
+		frame.count = 0;
+		return SocketReturnValue::kcount_too_large;
+	}
+	if (frame.count == 0) {
+		// only this stream has ended
+		return SocketReturnValue::keof;
+	}
+	body_len = frame.count * SampleBytes(frame.encoding);
+	return SocketReturnValue::ksuccess;
+}
+
+/*----------------------------------
+ * session handshake: hello (client) -> welcome (server). Like the encoding offer, the hello
+ * surfaces on the server's sample receive as kreceived_hello, so servers keep serving
+ * clients that start streaming right away.
+ *--------------------------------- */
+SocketReturnValue BaseImpl::handshake_safe(const StreamParams& requested, SessionGrant& granted) {
+	granted = SessionGrant();
+	{
+		std::lock_guard<std::mutex> lock(*(send_mutex_.get()));
+		if (socketfd_ < 0) {
+			return SocketReturnValue::kfd_illegal;
+		}
+		SocketReturnValue ready = beginSend(kno_deadline, "handshake_safe");
+		if (ready != SocketReturnValue::ksuccess) {
+			return ready;
+		}
+		std::vector<uint32_t> words;
+		EncodeStreamParams(requested, words);
+		// protocol 2
+		words.push_back(requested.max_streams);
+		const size_t body_bytes = words.size() * sizeof(uint32_t);
+		uint32_t header = khello_tag | static_cast<uint32_t>(body_bytes);
+		SocketReturnValue retval =
+		    transmitFrame(&header, sizeof(header), words.data(), body_bytes,
+		                  SocketReturnValue::ksendcount_failed, "handshake_safe");
+		if (retval != SocketReturnValue::ksuccess) {
+			return retval;
+		}
+	}
 
-	uint32_t count = static_cast<uint32_t>(data.size());
-
-	// transmit the length header
-	if (::send(socketfd_, &count, sizeof(count), 0) != sizeof(count)) {
-		// arcforge::embedded::utils::Logger::GetInstance().Info("sendFloat_safe: Failed to send count. errno: " + std::to_string(errno));
+	uint32_t tag = 0;
+	std::vector<uint32_t> words;
+	{
+		std::lock_guard<std::mutex> lock(*(receive_mutex_.get()));
+		if (socketfd_ < 0) {
+			return SocketReturnValue::kfd_illegal;
+		}
+		SocketReturnValue retval = beginReceive(kno_deadline, "handshake_safe");
+		if (retval != SocketReturnValue::ksuccess) {
+			return retval;
+		}
+		retval = receiveHandshakeFrame(tag, words, "handshake_safe");
+		if (retval != SocketReturnValue::ksuccess) {
+			return retval;
+		}
+		if (tag == kbusy_tag) {
+			// not admitted: nothing of the hello applies, the caller reconnects later
+			rx_retry_after_ms_ = words.empty() ? 0 : words[0];
+			return SocketReturnValue::kserver_busy;
+		}
+	}
+	if (tag != kwelcome_tag || words.empty() || words[0] == 0) {
 		arcforge::embedded::utils::Logger::GetInstance().Error(
-		    "sendFloat_safe: Failed to send count. errno: " + std::to_string(errno),
-		    kcurrent_lib_name);
-		return SocketReturnValue::ksendcount_failed;
+		    "handshake_safe: peer did not answer the hello", kcurrent_lib_name);
+		return SocketReturnValue::kreceived_illegal;
 	}
 
-	// transmit the data body (using a loop)
-	if (count > 0) {
-		size_t bytes_to_send = count * sizeof(float);
-		size_t bytes_has_sent = 0;
-		const char* data_ptr = reinterpret_cast<const char*>(data.data());
-
-		while (bytes_has_sent < bytes_to_send) {
-			ssize_t n_sent =
-			    ::send(socketfd_, data_ptr + bytes_has_sent, bytes_to_send - bytes_has_sent, 0);
-			if (n_sent < 0) {
-				// arcforge::embedded::utils::Logger::GetInstance().Info("sendFloat_safe: send() error while sending data. errno: " +
-				//     std::to_string(errno));
-				arcforge::embedded::utils::Logger::GetInstance().Info(
-				    "sendFloat_safe: send() error while sending data. errno: " +
-				        std::to_string(errno),
-				    kcurrent_lib_name);
-				return SocketReturnValue::ksenddata_failed;
-			}
-			bytes_has_sent += static_cast<size_t>(n_sent);
-		}
+	const size_t used = DecodeStreamParams(words, granted.params);
+	if (words.size() > used) {
+		granted.max_frame_samples = words[used];
+	}
+	if (words.size() > used + 1) {
+		granted.max_inflight_chunks = words[used + 1];
+	}
+	if (words.size() > used + 2) {
+		granted.idle_timeout_ms = words[used + 2];
+	}
+	if (words.size() > used + 3) {
+		granted.params.max_streams = words[used + 3];
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(*(socket_mutex_.get()));
+		sample_encoding_ = granted.params.encoding;
+	}
+	{
+		// only a peer that knows the flag can grant it
+		std::lock_guard<std::mutex> lock(*(send_mutex_.get()));
+		tx_frame_metadata_ = requested.frame_metadata && granted.params.frame_metadata;
+		tx_frame_sequence_ = 0;
+	}
+	{
+		std::lock_guard<std::mutex> lock(*(credit_mutex_.get()));
+		credit_window_ = granted.max_inflight_chunks;
+		inflight_chunks_.clear();
 	}
-	// arcforge::embedded::utils::Logger::GetInstance().Info("sendFloat_safe: Sent " + std::to_string(count) + " floats.");
 	arcforge::embedded::utils::Logger::GetInstance().Info(
-	    "sendFloat_safe: Sent " + std::to_string(count) + " floats.", kcurrent_lib_name);
+	    "handshake_safe: session v" + std::to_string(granted.params.protocol_version) + ", " +
+	        std::to_string(granted.params.sample_rate) + " Hz, encoding 0x" +
+	        ToHex(static_cast<uint32_t>(granted.params.encoding)),
+	    kcurrent_lib_name);
 	return SocketReturnValue::ksuccess;
 }
 
-// --- receiveFloat_safe  ---
-SocketReturnValue BaseImpl::receiveFloat_safe(std::vector<float>& data) {
-	std::lock_guard<std::mutex> lock(*(socket_mutex_.get()));
-
-	// 1. fd validation verification
-	if (socketfd_ < 0) {
-		return SocketReturnValue::kfd_illegal;
+SocketReturnValue BaseImpl::receiveHandshakeFrame(uint32_t& tag, std::vector<uint32_t>& words,
+                                                  const std::string& caller) {
+	uint32_t header = 0;
+	size_t body_len = 0;
+	SocketReturnValue retval = SocketReturnValue::kinit_state;
+	if (isPacketMode()) {
+		words.assign(kmax_hello_bytes / sizeof(uint32_t), 0);
+		retval = receivePacket(&header, sizeof(header), words.data(), kmax_hello_bytes, body_len,
+		                       caller);
+		if (retval != SocketReturnValue::ksuccess) {
+			return retval;
+		}
+		if (body_len > kmax_hello_bytes) {
+			return SocketReturnValue::kcount_too_large;
+		}
+	} else {
+		retval = receiveExact(&header, sizeof(header), caller);
+		if (retval != SocketReturnValue::ksuccess) {
+			return retval;
+		}
+		body_len = header & ksample_frame_count_mask;
+		if (body_len > kmax_hello_bytes) {
+			// not a handshake frame, the stream cannot be trusted any more
+			return SocketReturnValue::kcount_too_large;
+		}
+		words.assign((body_len + sizeof(uint32_t) - 1) / sizeof(uint32_t), 0);
+		retval = receiveExact(words.data(), body_len, caller);
+		if (retval != SocketReturnValue::ksuccess) {
+			return retval;
+		}
 	}
 
-	// 2. clean all output container
-	data.clear();
+	tag = header & ksample_frame_tag_mask;
+	words.resize(body_len / sizeof(uint32_t));
+	return SocketReturnValue::ksuccess;
+}
 
-	// arcforge::embedded::utils::Logger::GetInstance().Info("receiveFloat_safe(): before ::recv line 113");
-	arcforge::embedded::utils::Logger::GetInstance().Debug(
-	    "receiveFloat_safe(): before ::recv line 113", kcurrent_lib_name);
-	// 3. receive length that we need to read the data
-	uint32_t count;
-	ssize_t first_recv = ::recv(socketfd_, &count, sizeof(count), 0);
-	// arcforge::embedded::utils::Logger::GetInstance().Info("receiveFloat_safe(): after ::recv line 117");
-	arcforge::embedded::utils::Logger::GetInstance().Debug(
-	    "receiveFloat_safe(): after ::recv line 117", kcurrent_lib_name);
-	if (first_recv == 0) {
-		// means received nothing
-		// arcforge::embedded::utils::Logger::GetInstance().Info("receiveFloat_safe: Peer closed connection while trying to receive count.");
-		arcforge::embedded::utils::Logger::GetInstance().Error(
-		    "receiveFloat_safe: Peer closed connection while trying to receive count.",
-		    kcurrent_lib_name);
+SocketReturnValue BaseImpl::takeHello_safe(StreamParams& requested) {
+	std::lock_guard<std::mutex> lock(*(receive_mutex_.get()));
 
-		return SocketReturnValue::kpeer_abnormally_closed;
-	}
-	if (first_recv < 0) {
-		// means something wrong when sending data
-		// arcforge::embedded::utils::Logger::GetInstance().Info("receiveFloat_safe: recv() error while receiving count. errno: " +
-		//     std::to_string(errno) + " (" + strerror(errno) + ")");
+	if (pending_hello_.empty()) {
 		arcforge::embedded::utils::Logger::GetInstance().Error(
-		    "receiveFloat_safe: recv() error while receiving count. errno: " +
-		        std::to_string(errno) + " (" + strerror(errno) + ")",
-		    kcurrent_lib_name);
-		return SocketReturnValue::kreceived_illegal;
+		    "takeHello_safe: no session hello pending", kcurrent_lib_name);
+		return SocketReturnValue::kreceived_null;
 	}
-	if (first_recv != sizeof(count)) {
-		// read wrong length of uint32_t, so error occurs
-		// arcforge::embedded::utils::Logger::GetInstance().Info("receiveFloat_safe: Failed to receive count ");
-		arcforge::embedded::utils::Logger::GetInstance().Error(
-		    "receiveFloat_safe: Failed to receive count ", kcurrent_lib_name);
-		return SocketReturnValue::kreceivelength_failed;
+	requested = StreamParams();
+	const size_t used = DecodeStreamParams(pending_hello_, requested);
+	if (pending_hello_.size() > used) {
+		requested.max_streams = pending_hello_[used];
 	}
+	pending_hello_.clear();
+	return SocketReturnValue::ksuccess;
+}
 
-	std::ostringstream temp_str;
-	temp_str << "receiveFloat_safe: count=" << count;
-	// arcforge::embedded::utils::Logger::GetInstance().Info(temp_str.str());
-	arcforge::embedded::utils::Logger::GetInstance().Info(temp_str.str(), kcurrent_lib_name);
+SocketReturnValue BaseImpl::answerHello_safe(const SessionGrant& granted) {
+	{
+		std::lock_guard<std::mutex> lock(*(send_mutex_.get()));
+		if (socketfd_ < 0) {
+			return SocketReturnValue::kfd_illegal;
+		}
+		SocketReturnValue ready = beginSend(kno_deadline, "answerHello_safe");
+		if (ready != SocketReturnValue::ksuccess) {
+			return ready;
+		}
+		std::vector<uint32_t> words;
+		EncodeStreamParams(granted.params, words);
+		words.push_back(granted.max_frame_samples);
+		words.push_back(granted.max_inflight_chunks);
+		words.push_back(granted.idle_timeout_ms);
+		// protocol 2
+		words.push_back(granted.params.max_streams);
+		const size_t body_bytes = words.size() * sizeof(uint32_t);
+		uint32_t header = kwelcome_tag | static_cast<uint32_t>(body_bytes);
+		SocketReturnValue retval =
+		    transmitFrame(&header, sizeof(header), words.data(), body_bytes,
+		                  SocketReturnValue::ksendcount_failed, "answerHello_safe");
+		if (retval != SocketReturnValue::ksuccess) {
+			return retval;
+		}
+	}
 
-	// 4. optional: sanity check on count
-	const uint32_t MAX_ALLOWED_FLOATS = 1024 * 1024;
-	if (count > MAX_ALLOWED_FLOATS) {
-		// arcforge::embedded::utils::Logger::GetInstance().Info("receiveFloat_safe: Received count (" + std::to_string(count) +
-		//     ") exceeds MAX_ALLOWED_FLOATS (" + std::to_string(MAX_ALLOWED_FLOATS) + "). Aborting.");
-		arcforge::embedded::utils::Logger::GetInstance().Error(
-		    "receiveFloat_safe: Received count (" + std::to_string(count) +
-		        ") exceeds MAX_ALLOWED_FLOATS (" + std::to_string(MAX_ALLOWED_FLOATS) +
-		        "). Aborting.",
-		    kcurrent_lib_name);
+	std::lock_guard<std::mutex> lock(*(socket_mutex_.get()));
+	sample_encoding_ = granted.params.encoding;
+	return SocketReturnValue::ksuccess;
+}
 
-		return SocketReturnValue::kcount_too_large;
+SocketReturnValue BaseImpl::sendBusy_safe(uint32_t retry_after_ms) {
+	std::lock_guard<std::mutex> lock(*(send_mutex_.get()));
+	if (socketfd_ < 0) {
+		return SocketReturnValue::kfd_illegal;
 	}
-	if (count == 0) {
-		// end of file, empty block
-		// arcforge::embedded::utils::Logger::GetInstance().Info("receiveFloat_safe: Received EOF marker (empty chunk)");
-		arcforge::embedded::utils::Logger::GetInstance().Warning(
-		    "receiveFloat_safe: Received EOF marker (empty chunk)", kcurrent_lib_name);
-		return SocketReturnValue::keof;
+	SocketReturnValue ready = beginSend(kno_deadline, "sendBusy_safe");
+	if (ready != SocketReturnValue::ksuccess) {
+		return ready;
 	}
+	uint32_t header = kbusy_tag | static_cast<uint32_t>(sizeof(retry_after_ms));
+	return transmitFrame(&header, sizeof(header), &retry_after_ms, sizeof(retry_after_ms),
+	                     SocketReturnValue::ksendcount_failed, "sendBusy_safe");
+}
 
-	// 5. receive data
-	if (count > 0) {
-		data.resize(count);
-		size_t bytes_to_receive = count * sizeof(float);
-		size_t bytes_has_received = 0;
-		char* vector_start = reinterpret_cast<char*>(data.data());
-
-		while (bytes_has_received < bytes_to_receive) {
-			ssize_t n_recv = ::recv(socketfd_, vector_start + bytes_has_received,
-			                        bytes_to_receive - bytes_has_received, 0);
-			if (n_recv == 0) {
-				// means received nothing
-				arcforge::embedded::utils::Logger::GetInstance().Info(
-				    "receiveFloat_safe: Peer closed connection while trying to receive count.",
-				    kcurrent_lib_name);
-
-				return SocketReturnValue::kpeer_abnormally_closed;
-			}
-			if (n_recv < 0) {
-				// means something wrong when sending data
-
-				arcforge::embedded::utils::Logger::GetInstance().Info(
-				    "receiveFloat_safe: recv() error while receiving count. errno: " +
-				        std::to_string(errno) + " (" + strerror(errno) + ")",
-				    kcurrent_lib_name);
-				return SocketReturnValue::kreceived_illegal;
-			}
+SocketReturnValue BaseImpl::takeBusyFrame(size_t body_len, const std::string& caller) {
+	uint32_t retry_after_ms = 0;
+	if (body_len != sizeof(retry_after_ms)) {
+		return SocketReturnValue::kreceivelength_failed;
+	}
+	if (isPacketMode()) {
+		takePacketOverflow(&retry_after_ms, sizeof(retry_after_ms));
+	} else {
+		SocketReturnValue retval = receiveExact(&retry_after_ms, sizeof(retry_after_ms), caller);
+		if (retval != SocketReturnValue::ksuccess) {
+			return retval;
+		}
+	}
+	rx_retry_after_ms_ = retry_after_ms;
+	return SocketReturnValue::kserver_busy;
+}
 
-			bytes_has_received += static_cast<size_t>(n_recv);
+// --- discardExact ---
+SocketReturnValue BaseImpl::discardExact(size_t len, const std::string& caller) {
+	char scratch[4096];
+	while (len > 0) {
+		const size_t step = std::min(len, sizeof(scratch));
+		SocketReturnValue retval = receiveExact(scratch, step, caller);
+		if (retval != SocketReturnValue::ksuccess) {
+			return retval;
 		}
+		len -= step;
 	}
-	arcforge::embedded::utils::Logger::GetInstance().Info(
-	    "receiveFloat_safe: Received " + std::to_string(count) + " floats.", kcurrent_lib_name);
 	return SocketReturnValue::ksuccess;
 }
 
@@ -331,39 +2802,25 @@ SocketReturnValue BaseImpl::receiveFloat_safe(std::vector<float>& data) {
 // 	return SocketReturnValue::ksuccess;
 // }
 // --- sendString_safe  ---
-SocketReturnValue BaseImpl::sendString_safe(const std::string& message) {
-	std::lock_guard<std::mutex> lock(*(socket_mutex_.get()));
+SocketReturnValue BaseImpl::sendString_safe(const std::string& message,
+                                            const Deadline& deadline) {
+	std::lock_guard<std::mutex> lock(*(send_mutex_.get()));
 
 	if (socketfd_ < 0) {
 		return SocketReturnValue::kfd_illegal;
 	}
+	SocketReturnValue ready = beginSend(deadline, "sendString_safe");
+	if (ready != SocketReturnValue::ksuccess) {
+		return ready;
+	}
 
 	uint32_t len = static_cast<uint32_t>(message.length());
 
-	if (::send(socketfd_, &len, sizeof(len), 0) != sizeof(len)) {
-		arcforge::embedded::utils::Logger::GetInstance().Info(
-		    "sendString_safe: Failed to send length. errno: " + std::to_string(errno),
-		    kcurrent_lib_name);
-		return SocketReturnValue::ksendlength_failed;
-	}
-
-	if (len > 0) {
-		size_t bytes_to_send = len;
-		size_t bytes_has_sent = 0;
-		const char* data_ptr = message.c_str();
-
-		while (bytes_has_sent < bytes_to_send) {
-			ssize_t n_sent =
-			    ::send(socketfd_, data_ptr + bytes_has_sent, bytes_to_send - bytes_has_sent, 0);
-			if (n_sent < 0) {
-				arcforge::embedded::utils::Logger::GetInstance().Info(
-				    "sendString_safe: send() error while sending data. errno: " +
-				        std::to_string(errno),
-				    kcurrent_lib_name);
-				return SocketReturnValue::ksenddata_failed;
-			}
-			bytes_has_sent += static_cast<size_t>(n_sent);
-		}
+	SocketReturnValue retval = transmitFrame(&len, sizeof(len), message.data(), len,
+	                                         SocketReturnValue::ksendlength_failed,
+	                                         "sendString_safe");
+	if (retval != SocketReturnValue::ksuccess) {
+		return retval;
 	}
 	arcforge::embedded::utils::Logger::GetInstance().Info(
 	    "sendString_safe: Sent string of length " + std::to_string(len) + ".", kcurrent_lib_name);
@@ -371,38 +2828,36 @@ SocketReturnValue BaseImpl::sendString_safe(const std::string& message) {
 }
 
 // --- receiveString_safe  ---
-SocketReturnValue BaseImpl::receiveString_safe(std::string& message) {
-	std::lock_guard<std::mutex> lock(*(socket_mutex_.get()));
+SocketReturnValue BaseImpl::receiveString_safe(std::string& message,
+                                               const Deadline& deadline) {
+	std::lock_guard<std::mutex> lock(*(receive_mutex_.get()));
 
 	// 1. fd validation verification
 	if (socketfd_ < 0) {
 		return SocketReturnValue::kfd_illegal;
 	}
+	SocketReturnValue ready = beginReceive(deadline, "receiveString_safe");
+	if (ready != SocketReturnValue::ksuccess) {
+		return ready;
+	}
 	// 2. clean the final result container
 	message.clear();
 
 	// 3. receive length of message
 	uint32_t len;
-	ssize_t len_recv_bytes = ::recv(socketfd_, &len, sizeof(len), 0);
-
-	if (len_recv_bytes == 0) {
-		arcforge::embedded::utils::Logger::GetInstance().Info(
-		    "receiveString_safe: Peer closed connection while trying to receive length.",
-		    kcurrent_lib_name);
-		return SocketReturnValue::kpeer_abnormally_closed;
+	size_t body_len = 0;
+	SocketReturnValue retval =
+	    isPacketMode()
+	        ? receivePacket(&len, sizeof(len), nullptr, 0, body_len, "receiveString_safe")
+	        : receiveExact(&len, sizeof(len), "receiveString_safe");
+	if (retval != SocketReturnValue::ksuccess) {
+		return retval;
 	}
-	if (len_recv_bytes < 0) {
-		arcforge::embedded::utils::Logger::GetInstance().Info(
-		    "receiveString_safe: recv() error while receiving length. errno: " +
-		        std::to_string(errno) + " (" + strerror(errno) + ")",
-		    kcurrent_lib_name);
-		return SocketReturnValue::kreceived_illegal;
+	if ((len & ksample_frame_tag_mask) == kbusy_tag) {
+		return takeBusyFrame(isPacketMode() ? body_len : (len & ksample_frame_count_mask),
+		                     "receiveString_safe");
 	}
-	if (len_recv_bytes != sizeof(len)) {
-		arcforge::embedded::utils::Logger::GetInstance().Info(
-		    "receiveString_safe: Failed to receive full length header. Expected " +
-		        std::to_string(sizeof(len)) + ", got " + std::to_string(len_recv_bytes),
-		    kcurrent_lib_name);
+	if (isPacketMode() && body_len != len) {
 		return SocketReturnValue::kreceivelength_failed;
 	}
 	//---------------------------------
@@ -418,6 +2873,8 @@ SocketReturnValue BaseImpl::receiveString_safe(std::string& message) {
 	if (len == 0) {
 		arcforge::embedded::utils::Logger::GetInstance().Info(
 		    "receiveString_safe: This is empty string, return now.", kcurrent_lib_name);
+		// still a result: it answers the oldest chunk in flight
+		returnSendCredits(kplain_session, 1);
 		return SocketReturnValue::kempty_string;
 	}
 
@@ -433,30 +2890,15 @@ SocketReturnValue BaseImpl::receiveString_safe(std::string& message) {
 		}
 
 		message.resize(len);
-		size_t bytes_has_received = 0;
-		char* buffer_start = &message[0];
-
-		while (bytes_has_received < len) {
-			ssize_t n_recv =
-			    ::recv(socketfd_, buffer_start + bytes_has_received, len - bytes_has_received, 0);
-			if (n_recv == 0) {
-				arcforge::embedded::utils::Logger::GetInstance().Info(
-				    "receiveString_safe: Peer closed connection mid-stream. Expected " +
-				        std::to_string(len) + " bytes, but got only " +
-				        std::to_string(bytes_has_received),
-				    kcurrent_lib_name);
-				message.clear();
-				return SocketReturnValue::kpeer_abnormally_closed;
-			}
-			if (n_recv < 0) {
-				arcforge::embedded::utils::Logger::GetInstance().Info(
-				    "receiveString_safe: recv() error mid-stream. errno: " + std::to_string(errno) +
-				        " (" + strerror(errno) + ")",
-				    kcurrent_lib_name);
-				message.clear();
-				return SocketReturnValue::kreceived_illegal;
-			}
-			bytes_has_received += static_cast<size_t>(n_recv);
+		if (isPacketMode()) {
+			takePacketOverflow(&message[0], len);
+			retval = SocketReturnValue::ksuccess;
+		} else {
+			retval = receiveExact(&message[0], len, "receiveString_safe");
+		}
+		if (retval != SocketReturnValue::ksuccess) {
+			message.clear();
+			return retval;
 		}
 	}
 	//-----------------------------------------
@@ -473,18 +2915,131 @@ SocketReturnValue BaseImpl::receiveString_safe(std::string& message) {
 	// 	}
 	// }
 
+	returnSendCredits(kplain_session, 1);
 	arcforge::embedded::utils::Logger::GetInstance().Info(
 	    "receiveString_safe: Received string of length " + std::to_string(len) + ".",
 	    kcurrent_lib_name);
 	return SocketReturnValue::ksuccess;
 }
+
+// --- sendResult_safe ---
+SocketReturnValue BaseImpl::sendResult_safe(const ResultMessage& result,
+                                            const Deadline& deadline) {
+	std::lock_guard<std::mutex> lock(*(send_mutex_.get()));
+
+	if (socketfd_ < 0) {
+		return SocketReturnValue::kfd_illegal;
+	}
+	SocketReturnValue ready = beginSend(deadline, "sendResult_safe");
+	if (ready != SocketReturnValue::ksuccess) {
+		return ready;
+	}
+	if (result.text.size() > kmax_text_bytes) {
+		return SocketReturnValue::kcount_too_large;
+	}
+
+	uint32_t words[3];
+	words[0] = kresult_frame_tag | static_cast<uint32_t>(result.kind);
+	words[1] = result.acknowledged_chunks;
+	words[2] = static_cast<uint32_t>(result.text.size());
+	return transmitFrame(words, sizeof(words), result.text.data(), result.text.size(),
+	                     SocketReturnValue::ksendlength_failed, "sendResult_safe");
+}
+
+// --- receiveResult_safe ---
+SocketReturnValue BaseImpl::receiveResult_safe(ResultMessage& result, const Deadline& deadline) {
+	std::lock_guard<std::mutex> lock(*(receive_mutex_.get()));
+
+	if (socketfd_ < 0) {
+		return SocketReturnValue::kfd_illegal;
+	}
+	SocketReturnValue ready = beginReceive(deadline, "receiveResult_safe");
+	if (ready != SocketReturnValue::ksuccess) {
+		return ready;
+	}
+	result.text.clear();
+
+	uint32_t header = 0;
+	size_t body_len = 0;
+	SocketReturnValue retval =
+	    isPacketMode()
+	        ? receivePacket(&header, sizeof(header), nullptr, 0, body_len, "receiveResult_safe")
+	        : receiveExact(&header, sizeof(header), "receiveResult_safe");
+	if (retval != SocketReturnValue::ksuccess) {
+		return retval;
+	}
+
+	if ((header & ksample_frame_tag_mask) == kbusy_tag) {
+		return takeBusyFrame(isPacketMode() ? body_len : (header & ksample_frame_count_mask),
+		                     "receiveResult_safe");
+	}
+
+	// a server without pushed results answers every chunk with a plain string
+	uint32_t fields[2] = {1, header};
+	size_t fields_len = 0;
+	if ((header & ksample_frame_tag_mask) == kresult_frame_tag) {
+		fields_len = sizeof(fields);
+		if (isPacketMode()) {
+			if (body_len < fields_len) {
+				return SocketReturnValue::kreceivelength_failed;
+			}
+			takePacketOverflow(fields, fields_len);
+		} else {
+			retval = receiveExact(fields, fields_len, "receiveResult_safe");
+			if (retval != SocketReturnValue::ksuccess) {
+				return retval;
+			}
+		}
+		switch (header & kresult_kind_mask) {
+			case static_cast<uint32_t>(ResultKind::kfinal):
+				result.kind = ResultKind::kfinal;
+				break;
+			case static_cast<uint32_t>(ResultKind::kend_of_utterance):
+				result.kind = ResultKind::kend_of_utterance;
+				break;
+			default:
+				result.kind = ResultKind::kpartial;
+				break;
+		}
+	} else {
+		result.kind = ResultKind::kpartial;
+	}
+	result.acknowledged_chunks = fields[0];
+	const uint32_t len = fields[1];
+	if (len > kmax_text_bytes) {
+		return SocketReturnValue::kcount_too_large;
+	}
+	if (isPacketMode() && body_len != fields_len + len) {
+		return SocketReturnValue::kreceivelength_failed;
+	}
+
+	if (len > 0) {
+		result.text.resize(len);
+		if (isPacketMode()) {
+			takePacketOverflow(&result.text[0], len, fields_len);
+		} else {
+			retval = receiveExact(&result.text[0], len, "receiveResult_safe");
+			if (retval != SocketReturnValue::ksuccess) {
+				result.text.clear();
+				return retval;
+			}
+		}
+	}
+
+	returnSendCredits(kplain_session, result.acknowledged_chunks);
+	return SocketReturnValue::ksuccess;
+}
 /*===================================================
  * client-only public interface
  *===================================================*/
 SocketReturnValue BaseImpl::connectToServer() {
 
+	if (getTransportFamily_safe() == TransportFamily::ktcp) {
+		return connectTcp();
+	}
+
 	// create Unix domain socket
-	int sock_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	int sock_fd = socket(AF_UNIX, nativeSocketType(), 0);
 	if (sock_fd < 0) {
 		return SocketReturnValue::kfd_illegal;
 	}
@@ -521,7 +3076,11 @@ SocketReturnValue BaseImpl::connectToServer() {
  *===================================================*/
 SocketReturnValue BaseImpl::startServer(const size_t& timeout) {
 
-	int sock_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (getTransportFamily_safe() == TransportFamily::ktcp) {
+		return startTcpServer(timeout);
+	}
+
+	int sock_fd = socket(AF_UNIX, nativeSocketType(), 0);
 	if (sock_fd < 0) {
 		return SocketReturnValue::kfd_illegal;
 	}
@@ -547,18 +3106,30 @@ SocketReturnValue BaseImpl::startServer(const size_t& timeout) {
 		return SocketReturnValue::kbind_error;
 	}
 
+	SocketReturnValue retval = listenOn(sock_fd, timeout);
+	if (retval != SocketReturnValue::ksuccess) {
+		close(sock_fd);
+		return retval;
+	}
+
+	this->setFD_safe(sock_fd);
+
+	return SocketReturnValue::ksuccess;
+}
+
+SocketReturnValue BaseImpl::listenOn(int sock_fd, const size_t& timeout) {
+
 /*----------------------------------
 	 * start listening
-     * SOMAXCONN means more request in queued that the performance under network
-	 * poor connection and etc scenes may be enhanced
+     * a longer queue (setListenBacklog()) lets a burst of connects wait for accept()
+	 * instead of failing, the kernel caps it at SOMAXCONN
 	 *--------------------------------- */
-#if 1
 	int queue_size = 1;
-#else
-	int queue_size = SOMAXCONN;
-#endif
+	{
+		std::lock_guard<std::mutex> lock(*(socket_mutex_.get()));
+		queue_size = listen_backlog_;
+	}
 	if (listen(sock_fd, queue_size) < 0) {
-		close(sock_fd);
 		return SocketReturnValue::klisten_error;
 	}
 	// arcforge::embedded::utils::Logger::GetInstance().Warning("size of the listen() queue is " + std::to_string(queue_size));
@@ -578,7 +3149,6 @@ SocketReturnValue BaseImpl::startServer(const size_t& timeout) {
 			// perror("setsockopt failed");
 			arcforge::embedded::utils::Logger::GetInstance().Error("setsockopt failed",
 			                                                       kcurrent_lib_name);
-			close(sock_fd);
 			return SocketReturnValue::ksetsocketopt_error;
 		}
 
@@ -587,6 +3157,199 @@ SocketReturnValue BaseImpl::startServer(const size_t& timeout) {
 		arcforge::embedded::utils::Logger::GetInstance().Info(ss.str(), kcurrent_lib_name);
 	}
 
+	return SocketReturnValue::ksuccess;
+}
+
+/*===================================================
+ * TCP transport
+ *===================================================*/
+namespace {
+// getaddrinfo() for the configured endpoint; an empty host means every local address
+// when passive, the loopback otherwise
+struct AddrInfoList {
+	struct addrinfo* head = nullptr;
+	~AddrInfoList() {
+		if (head != nullptr) {
+			::freeaddrinfo(head);
+		}
+	}
+};
+
+int ResolveTcpEndpoint(const std::string& host, uint16_t port, bool passive, AddrInfoList& out) {
+	struct addrinfo hints;
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	hints.ai_flags = AI_NUMERICSERV | (passive ? AI_PASSIVE : 0);
+
+	const std::string service = std::to_string(port);
+	return ::getaddrinfo(host.empty() ? nullptr : host.c_str(), service.c_str(), &hints,
+	                     &out.head);
+}
+}  // namespace
+
+SocketReturnValue BaseImpl::applyTcpOptions(int fd, const TcpOptions& options) {
+	int on = options.no_delay ? 1 : 0;
+	if (::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on)) < 0) {
+		return SocketReturnValue::ksetsocketopt_error;
+	}
+	if (options.send_buffer_bytes > 0 &&
+	    ::setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &options.send_buffer_bytes,
+	                 sizeof(options.send_buffer_bytes)) < 0) {
+		return SocketReturnValue::ksetsocketopt_error;
+	}
+	if (options.receive_buffer_bytes > 0 &&
+	    ::setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &options.receive_buffer_bytes,
+	                 sizeof(options.receive_buffer_bytes)) < 0) {
+		return SocketReturnValue::ksetsocketopt_error;
+	}
+
+	int keepalive = options.keepalive ? 1 : 0;
+	if (::setsockopt(fd, SOL_SOCKET, SO_KEEPALIVE, &keepalive, sizeof(keepalive)) < 0) {
+		return SocketReturnValue::ksetsocketopt_error;
+	}
+	if (options.keepalive == true) {
+		if ((options.keepalive_idle_s > 0 &&
+		     ::setsockopt(fd, IPPROTO_TCP, TCP_KEEPIDLE, &options.keepalive_idle_s,
+		                  sizeof(options.keepalive_idle_s)) < 0) ||
+		    (options.keepalive_interval_s > 0 &&
+		     ::setsockopt(fd, IPPROTO_TCP, TCP_KEEPINTVL, &options.keepalive_interval_s,
+		                  sizeof(options.keepalive_interval_s)) < 0) ||
+		    (options.keepalive_count > 0 &&
+		     ::setsockopt(fd, IPPROTO_TCP, TCP_KEEPCNT, &options.keepalive_count,
+		                  sizeof(options.keepalive_count)) < 0)) {
+			return SocketReturnValue::ksetsocketopt_error;
+		}
+	}
+	return SocketReturnValue::ksuccess;
+}
+
+SocketReturnValue BaseImpl::connectTcp() {
+	std::string host;
+	uint16_t port = 0;
+	TcpOptions options;
+	{
+		std::lock_guard<std::mutex> lock(*(socket_mutex_.get()));
+		host = tcp_host_;
+		port = tcp_port_;
+		options = tcp_options_;
+	}
+
+	// TCP is a byte stream: there is no message boundary to carry one frame per packet
+	if (getSocketType_safe() == SocketType::kseqpacket) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "SOCK_SEQPACKET framing is not available over TCP, use SocketType::kstream",
+		    kcurrent_lib_name);
+		return SocketReturnValue::kconnect_server_failed;
+	}
+
+	AddrInfoList addresses;
+	int gai_ret = ResolveTcpEndpoint(host, port, false, addresses);
+	if (gai_ret != 0) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "Client cannot resolve " + host + ": " + gai_strerror(gai_ret), kcurrent_lib_name);
+		return SocketReturnValue::kconnect_server_failed;
+	}
+
+	// first address that answers wins, so a dual-stack name falls back from IPv6 to IPv4
+	int sock_fd = -1;
+	for (struct addrinfo* ai = addresses.head; ai != nullptr; ai = ai->ai_next) {
+		sock_fd = ::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+		if (sock_fd < 0) {
+			continue;
+		}
+		if (::connect(sock_fd, ai->ai_addr, ai->ai_addrlen) == 0) {
+			break;
+		}
+		close(sock_fd);
+		sock_fd = -1;
+	}
+	if (sock_fd < 0) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    std::string("Client connect failed: ") + host + ":" + std::to_string(port) + " " +
+		        strerror(errno),
+		    kcurrent_lib_name);
+		return SocketReturnValue::kconnect_server_failed;
+	}
+
+	SocketReturnValue retval = applyTcpOptions(sock_fd, options);
+	if (retval != SocketReturnValue::ksuccess) {
+		close(sock_fd);
+		return retval;
+	}
+
+	this->setFD_safe(sock_fd);
+
+	return SocketReturnValue::ksuccess;
+}
+
+SocketReturnValue BaseImpl::startTcpServer(const size_t& timeout) {
+	std::string host;
+	uint16_t port = 0;
+	{
+		std::lock_guard<std::mutex> lock(*(socket_mutex_.get()));
+		host = tcp_host_;
+		port = tcp_port_;
+	}
+
+	if (getSocketType_safe() == SocketType::kseqpacket) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "SOCK_SEQPACKET framing is not available over TCP, use SocketType::kstream",
+		    kcurrent_lib_name);
+		return SocketReturnValue::kbind_error;
+	}
+
+	AddrInfoList addresses;
+	int gai_ret = ResolveTcpEndpoint(host, port, true, addresses);
+	if (gai_ret != 0) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "Server cannot resolve " + host + ": " + gai_strerror(gai_ret), kcurrent_lib_name);
+		return SocketReturnValue::kbind_error;
+	}
+
+	// prefer the IPv6 wildcard with V6ONLY off: one socket then serves both families
+	std::vector<struct addrinfo*> candidates;
+	for (struct addrinfo* ai = addresses.head; ai != nullptr; ai = ai->ai_next) {
+		candidates.push_back(ai);
+	}
+	std::stable_partition(candidates.begin(), candidates.end(),
+	                      [](const struct addrinfo* ai) { return ai->ai_family == AF_INET6; });
+
+	int sock_fd = -1;
+	for (struct addrinfo* ai : candidates) {
+		sock_fd = ::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+		if (sock_fd < 0) {
+			continue;
+		}
+
+		// restarting the server must not wait out TIME_WAIT of the previous instance
+		int on = 1;
+		::setsockopt(sock_fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+		if (ai->ai_family == AF_INET6) {
+			int v6only = 0;
+			::setsockopt(sock_fd, IPPROTO_IPV6, IPV6_V6ONLY, &v6only, sizeof(v6only));
+		}
+
+		if (::bind(sock_fd, ai->ai_addr, ai->ai_addrlen) == 0) {
+			break;
+		}
+		close(sock_fd);
+		sock_fd = -1;
+	}
+	if (sock_fd < 0) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    std::string("Server bind failed: ") + host + ":" + std::to_string(port) + " " +
+		        strerror(errno),
+		    kcurrent_lib_name);
+		return SocketReturnValue::kbind_error;
+	}
+
+	SocketReturnValue retval = listenOn(sock_fd, timeout);
+	if (retval != SocketReturnValue::ksuccess) {
+		close(sock_fd);
+		return retval;
+	}
+
 	this->setFD_safe(sock_fd);
 
 	return SocketReturnValue::ksuccess;
@@ -601,7 +3364,8 @@ SocketAcceptImplReturn::SocketAcceptImplReturn(SocketReturnValue value,
 
 SocketAcceptImplReturn BaseImpl::acceptClient() {
 
-	struct sockaddr_un client_addr;
+	// large enough for a sockaddr_un as well as an IPv6 peer
+	struct sockaddr_storage client_addr;
 	socklen_t client_len = sizeof(client_addr);
 
 	int listening_fd = this->getFD_safe();
@@ -637,6 +3401,29 @@ SocketAcceptImplReturn BaseImpl::acceptClient() {
 
 	auto client_connection = std::make_unique<BaseImpl>();
 	client_connection->setFD_safe(client_fd);
+	// accepted connections inherit the transport chosen on the listening side
+	client_connection->setSocketType_safe(getSocketType_safe());
+	client_connection->setIoBackend_safe(getIoBackend_safe());
+
+	TransportFamily transport = TransportFamily::kunix;
+	TcpOptions options;
+	{
+		std::lock_guard<std::mutex> lock(*(socket_mutex_.get()));
+		transport = transport_;
+		options = tcp_options_;
+	}
+	if (transport == TransportFamily::ktcp) {
+		{
+			std::lock_guard<std::mutex> lock(*(client_connection->socket_mutex_.get()));
+			client_connection->transport_ = transport;
+			client_connection->tcp_options_ = options;
+		}
+		if (applyTcpOptions(client_fd, options) != SocketReturnValue::ksuccess) {
+			arcforge::embedded::utils::Logger::GetInstance().Warning(
+			    std::string("accepted TCP connection keeps default options: ") + strerror(errno),
+			    kcurrent_lib_name);
+		}
+	}
 
 	return {SocketReturnValue::ksuccess, std::move(client_connection)};
 	// return SocketReturnValue::ksuccess;
@@ -0,0 +1,525 @@
+// Copyright (c) 2025 PotterWhite
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// libs/network/src/base/impl/io-uring.cpp
+#include "Network/base/impl/io-uring.h"
+
+#if defined(ARC_NETWORK_HAVE_IO_URING)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+namespace arcforge {
+namespace embedded {
+namespace network_socket {
+
+#if defined(ARC_NETWORK_HAVE_IO_URING)
+
+namespace {
+
+int sysIoUringSetup(unsigned entries, struct io_uring_params* params) {
+	return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+int sysIoUringEnter(int ring_fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+	return static_cast<int>(
+	    ::syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+int sysIoUringRegister(int ring_fd, unsigned opcode, void* arg, unsigned nr_args) {
+	return static_cast<int>(::syscall(__NR_io_uring_register, ring_fd, opcode, arg, nr_args));
+}
+
+template <typename T>
+T* ringField(void* base, uint32_t offset) {
+	return static_cast<T*>(static_cast<void*>(static_cast<char*>(base) + offset));
+}
+
+}  // namespace
+
+/*===================================================
+ * constructors and operators
+ *===================================================*/
+IoUring::IoUring() = default;
+
+IoUring::~IoUring() {
+	release();
+}
+
+bool IoUring::isSupported() {
+	static const bool supported = []() {
+		IoUring probe;
+		return probe.init(2);
+	}();
+	return supported;
+}
+
+/*===================================================
+ * ring setup / teardown
+ *===================================================*/
+bool IoUring::init(unsigned entries) {
+	if (ring_fd_ >= 0) {
+		return true;
+	}
+
+	struct io_uring_params params;
+	std::memset(&params, 0, sizeof(params));
+
+	ring_fd_ = sysIoUringSetup(entries, &params);
+	if (ring_fd_ < 0) {
+		ring_fd_ = -1;
+		return false;
+	}
+
+	sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+	cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+	const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+	if (single_mmap) {
+		sq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+		cq_ring_size_ = sq_ring_size_;
+	}
+
+	sq_ring_ptr_ = ::mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE,
+	                      MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+	if (sq_ring_ptr_ == MAP_FAILED) {
+		sq_ring_ptr_ = nullptr;
+		release();
+		return false;
+	}
+
+	if (single_mmap) {
+		cq_ring_ptr_ = sq_ring_ptr_;
+	} else {
+		cq_ring_ptr_ = ::mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE,
+		                      MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING);
+		if (cq_ring_ptr_ == MAP_FAILED) {
+			cq_ring_ptr_ = nullptr;
+			release();
+			return false;
+		}
+	}
+
+	sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+	void* sqes = ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+	                    ring_fd_, IORING_OFF_SQES);
+	if (sqes == MAP_FAILED) {
+		release();
+		return false;
+	}
+	sqes_ = static_cast<struct io_uring_sqe*>(sqes);
+
+	sq_head_ = ringField<unsigned>(sq_ring_ptr_, params.sq_off.head);
+	sq_tail_ = ringField<unsigned>(sq_ring_ptr_, params.sq_off.tail);
+	sq_mask_ = *ringField<unsigned>(sq_ring_ptr_, params.sq_off.ring_mask);
+	sq_array_ = ringField<unsigned>(sq_ring_ptr_, params.sq_off.array);
+
+	cq_head_ = ringField<unsigned>(cq_ring_ptr_, params.cq_off.head);
+	cq_tail_ = ringField<unsigned>(cq_ring_ptr_, params.cq_off.tail);
+	cq_mask_ = *ringField<unsigned>(cq_ring_ptr_, params.cq_off.ring_mask);
+	cqes_ = ringField<struct io_uring_cqe>(cq_ring_ptr_, params.cq_off.cqes);
+
+	return true;
+}
+
+bool IoUring::isReady() const {
+	return ring_fd_ >= 0;
+}
+
+void IoUring::release() {
+	// closing the ring fd cancels the armed multishot receive, so do it before the
+	// provided buffers it may still write into are unmapped
+	if (ring_fd_ >= 0) {
+		::close(ring_fd_);
+		ring_fd_ = -1;
+	}
+	if (buffer_ring_ != nullptr) {
+		::munmap(buffer_ring_, buffer_ring_size_);
+		buffer_ring_ = nullptr;
+	}
+	if (sqes_ != nullptr) {
+		::munmap(sqes_, sqes_size_);
+		sqes_ = nullptr;
+	}
+	if (cq_ring_ptr_ != nullptr && cq_ring_ptr_ != sq_ring_ptr_) {
+		::munmap(cq_ring_ptr_, cq_ring_size_);
+	}
+	cq_ring_ptr_ = nullptr;
+	if (sq_ring_ptr_ != nullptr) {
+		::munmap(sq_ring_ptr_, sq_ring_size_);
+		sq_ring_ptr_ = nullptr;
+	}
+	buffer_storage_.reset();
+	segments_.clear();
+	rx_fd_ = -1;
+	rx_armed_ = false;
+}
+
+/*===================================================
+ * submission / completion primitives
+ *===================================================*/
+struct io_uring_sqe* IoUring::nextSqe() {
+	const unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+	const unsigned tail = *sq_tail_ + pending_submissions_;
+	if (tail - head > sq_mask_) {
+		return nullptr;  // ring full
+	}
+
+	const unsigned index = tail & sq_mask_;
+	struct io_uring_sqe* sqe = &sqes_[index];
+	std::memset(sqe, 0, sizeof(*sqe));
+	sq_array_[index] = index;
+	return sqe;
+}
+
+void IoUring::submitSqe() {
+	++pending_submissions_;
+}
+
+int IoUring::enter(unsigned to_submit, unsigned min_complete, unsigned flags) {
+	if (pending_submissions_ > 0) {
+		__atomic_store_n(sq_tail_, *sq_tail_ + pending_submissions_, __ATOMIC_RELEASE);
+		pending_submissions_ = 0;
+	}
+
+	int ret = 0;
+	do {
+		ret = sysIoUringEnter(ring_fd_, to_submit, min_complete, flags);
+		// an interrupted wait has still consumed the submissions
+		if (ret < 0 && errno == EINTR) {
+			to_submit = 0;
+		}
+	} while (ret < 0 && errno == EINTR);
+
+	return ret < 0 ? -errno : ret;
+}
+
+bool IoUring::popCqe(struct io_uring_cqe& out) {
+	const unsigned head = *cq_head_;
+	if (head == __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+		return false;
+	}
+
+	out = cqes_[head & cq_mask_];
+	__atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+	return true;
+}
+
+/*===================================================
+ * tx: linked sends
+ *===================================================*/
+ssize_t IoUring::sendLinked(int fd, const struct iovec* parts, unsigned count) {
+	if (!isReady() || count == 0 || count > sq_mask_ + 1) {
+		return -EINVAL;
+	}
+
+	for (unsigned i = 0; i < count; ++i) {
+		struct io_uring_sqe* sqe = nextSqe();
+		if (sqe == nullptr) {
+			return -EBUSY;
+		}
+		sqe->opcode = IORING_OP_SEND;
+		sqe->fd = fd;
+		sqe->addr = reinterpret_cast<uint64_t>(parts[i].iov_base);
+		sqe->len = static_cast<uint32_t>(parts[i].iov_len);
+		// never parks in the kernel: a full send buffer ends the chain early and the
+		// caller finishes the frame where it can also wait for a cancellation
+		sqe->msg_flags = MSG_WAITALL | MSG_DONTWAIT;
+		sqe->user_data = i;
+		if (i + 1 < count) {
+			sqe->flags = IOSQE_IO_LINK;
+		}
+		submitSqe();
+	}
+
+	const int entered = enter(count, count, IORING_ENTER_GETEVENTS);
+	if (entered < 0) {
+		return entered;
+	}
+
+	// a short or failed link cancels the rest of the chain; report the contiguous
+	// prefix that really went out so the caller can finish the frame itself
+	std::vector<ssize_t> results(count, -ECANCELED);
+	unsigned reaped = 0;
+	while (reaped < count) {
+		struct io_uring_cqe cqe;
+		if (!popCqe(cqe)) {
+			const int waited = enter(0, 1, IORING_ENTER_GETEVENTS);
+			if (waited < 0) {
+				return waited;
+			}
+			continue;
+		}
+		if (cqe.user_data < count) {
+			results[cqe.user_data] = cqe.res;
+		}
+		++reaped;
+	}
+
+	ssize_t total = 0;
+	for (unsigned i = 0; i < count; ++i) {
+		if (results[i] < 0) {
+			return total > 0 ? total : results[i];
+		}
+		total += results[i];
+		if (static_cast<size_t>(results[i]) < parts[i].iov_len) {
+			break;
+		}
+	}
+	return total;
+}
+
+/*===================================================
+ * rx: multishot receive into provided buffers
+ *===================================================*/
+bool IoUring::enableMultishotReceive(int fd, unsigned buffer_count, unsigned buffer_size) {
+	if (!isReady() || buffer_ring_ != nullptr) {
+		return false;
+	}
+	// the kernel wants a power-of-two ring and 16-bit buffer ids
+	if (buffer_count == 0 || (buffer_count & (buffer_count - 1)) != 0 || buffer_count > 32768) {
+		return false;
+	}
+
+	buffer_ring_size_ = buffer_count * sizeof(struct io_uring_buf);
+	void* ring = ::mmap(nullptr, buffer_ring_size_, PROT_READ | PROT_WRITE,
+	                    MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+	if (ring == MAP_FAILED) {
+		return false;
+	}
+	buffer_ring_ = static_cast<struct io_uring_buf_ring*>(ring);
+
+	struct io_uring_buf_reg reg;
+	std::memset(&reg, 0, sizeof(reg));
+	reg.ring_addr = reinterpret_cast<uint64_t>(buffer_ring_);
+	reg.ring_entries = buffer_count;
+	reg.bgid = kbuffer_group_id_;
+	if (sysIoUringRegister(ring_fd_, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+		// provided buffer rings need 5.19+
+		::munmap(buffer_ring_, buffer_ring_size_);
+		buffer_ring_ = nullptr;
+		return false;
+	}
+
+	buffer_count_ = buffer_count;
+	buffer_size_ = buffer_size;
+	buffer_ring_tail_ = 0;
+	buffer_storage_ = std::make_unique<char[]>(static_cast<size_t>(buffer_count) * buffer_size);
+	for (unsigned i = 0; i < buffer_count; ++i) {
+		recycleBuffer(static_cast<uint16_t>(i));
+	}
+
+	rx_fd_ = fd;
+	rx_eof_ = false;
+	rx_error_ = 0;
+	rx_delivered_any_ = false;
+	return armMultishotReceive();
+}
+
+bool IoUring::isMultishotReceiveEnabled() const {
+	return rx_fd_ >= 0;
+}
+
+bool IoUring::hasBufferedData() const {
+	if (segments_.empty() == false || rx_eof_ || rx_error_ != 0) {
+		return true;
+	}
+	return cq_head_ != nullptr && *cq_head_ != __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+}
+
+int IoUring::getFD() const {
+	return ring_fd_;
+}
+
+void IoUring::recycleBuffer(uint16_t buffer_id) {
+	const uint16_t mask = static_cast<uint16_t>(buffer_count_ - 1);
+	// index from the ring base instead of ->bufs: under C++ the UAPI flex-array macro moves
+	// bufs to offset 8, while the kernel ABI puts entry 0 at offset 0 (overlaying tail)
+	struct io_uring_buf* buf =
+	    static_cast<struct io_uring_buf*>(static_cast<void*>(buffer_ring_)) +
+	    (buffer_ring_tail_ & mask);
+	buf->addr = reinterpret_cast<uint64_t>(buffer_storage_.get() +
+	                                       static_cast<size_t>(buffer_id) * buffer_size_);
+	buf->len = buffer_size_;
+	buf->bid = buffer_id;
+	++buffer_ring_tail_;
+	__atomic_store_n(&buffer_ring_->tail, buffer_ring_tail_, __ATOMIC_RELEASE);
+}
+
+bool IoUring::armMultishotReceive() {
+	struct io_uring_sqe* sqe = nextSqe();
+	if (sqe == nullptr) {
+		return false;
+	}
+	sqe->opcode = IORING_OP_RECV;
+	sqe->fd = rx_fd_;
+	sqe->ioprio = IORING_RECV_MULTISHOT;
+	sqe->flags = IOSQE_BUFFER_SELECT;
+	sqe->buf_group = kbuffer_group_id_;
+	submitSqe();
+
+	if (enter(1, 0, 0) < 0) {
+		return false;
+	}
+	rx_armed_ = true;
+	return true;
+}
+
+void IoUring::drainReceiveCompletions() {
+	struct io_uring_cqe cqe;
+	while (popCqe(cqe)) {
+		if ((cqe.flags & IORING_CQE_F_MORE) == 0) {
+			rx_armed_ = false;
+		}
+
+		if (cqe.res > 0) {
+			const uint16_t buffer_id = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+			segments_.push_back({buffer_id, static_cast<size_t>(cqe.res), 0});
+			rx_delivered_any_ = true;
+		} else if (cqe.res == 0) {
+			rx_eof_ = true;
+		} else if (cqe.res == -EINVAL && !rx_delivered_any_) {
+			// 5.19 knows provided buffer rings but not RECV_MULTISHOT
+			rx_error_ = EOPNOTSUPP;
+		} else if (cqe.res != -ENOBUFS) {
+			// ENOBUFS only means every buffer is still queued here; re-arming after the
+			// next recycle is enough. Anything else is a real socket error.
+			rx_error_ = -cqe.res;
+		}
+	}
+}
+
+ssize_t IoUring::receive(void* dst, size_t max_len, int timeout_ms, int cancel_fd) {
+	if (rx_fd_ < 0) {
+		return -EINVAL;
+	}
+
+	const auto give_up = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+
+	while (segments_.empty()) {
+		drainReceiveCompletions();
+		if (!segments_.empty()) {
+			break;
+		}
+		if (rx_error_ != 0) {
+			return -rx_error_;
+		}
+		if (rx_eof_) {
+			return 0;
+		}
+		if (!rx_armed_ && !armMultishotReceive()) {
+			return -EIO;
+		}
+
+		if (timeout_ms < 0 && cancel_fd < 0) {
+			const int waited = enter(0, 1, IORING_ENTER_GETEVENTS);
+			if (waited < 0) {
+				return waited;
+			}
+			continue;
+		}
+
+		// the ring fd turns readable as soon as a completion is posted
+		int wait_ms = -1;
+		if (timeout_ms >= 0) {
+			const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+			    give_up - std::chrono::steady_clock::now());
+			if (remaining.count() <= 0) {
+				return -ETIMEDOUT;
+			}
+			wait_ms = static_cast<int>(remaining.count());
+		}
+		struct pollfd waits[2];
+		waits[0].fd = ring_fd_;
+		waits[0].events = POLLIN;
+		waits[0].revents = 0;
+		waits[1].fd = cancel_fd;
+		waits[1].events = POLLIN;
+		waits[1].revents = 0;
+		const nfds_t wait_count = cancel_fd >= 0 ? 2U : 1U;
+		if (::poll(waits, wait_count, wait_ms) < 0 && errno != EINTR) {
+			return -errno;
+		}
+		if ((waits[1].revents & POLLIN) != 0) {
+			return -ECANCELED;
+		}
+	}
+
+	char* out = static_cast<char*>(dst);
+	size_t copied = 0;
+	while (copied < max_len && !segments_.empty()) {
+		Segment& segment = segments_.front();
+		const size_t take = std::min(max_len - copied, segment.length - segment.consumed);
+		std::memcpy(out + copied,
+		            buffer_storage_.get() +
+		                static_cast<size_t>(segment.buffer_id) * buffer_size_ + segment.consumed,
+		            take);
+		copied += take;
+		segment.consumed += take;
+		if (segment.consumed == segment.length) {
+			recycleBuffer(segment.buffer_id);
+			segments_.pop_front();
+		}
+	}
+
+	return static_cast<ssize_t>(copied);
+}
+
+#else  // !ARC_NETWORK_HAVE_IO_URING
+
+IoUring::IoUring() = default;
+IoUring::~IoUring() = default;
+
+bool IoUring::isSupported() {
+	return false;
+}
+bool IoUring::init(unsigned /*entries*/) {
+	return false;
+}
+bool IoUring::isReady() const {
+	return false;
+}
+ssize_t IoUring::sendLinked(int /*fd*/, const struct iovec* /*parts*/, unsigned /*count*/) {
+	return -ENOSYS;
+}
+bool IoUring::enableMultishotReceive(int /*fd*/, unsigned /*buffer_count*/,
+                                     unsigned /*buffer_size*/) {
+	return false;
+}
+bool IoUring::isMultishotReceiveEnabled() const {
+	return false;
+}
+bool IoUring::hasBufferedData() const {
+	return false;
+}
+int IoUring::getFD() const {
+	return -1;
+}
+ssize_t IoUring::receive(void* /*dst*/, size_t /*max_len*/, int /*timeout_ms*/,
+                         int /*cancel_fd*/) {
+	return -ENOSYS;
+}
+
+#endif  // ARC_NETWORK_HAVE_IO_URING
+
+}  // namespace network_socket
+}  // namespace embedded
+}  // namespace arcforge
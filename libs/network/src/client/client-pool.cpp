@@ -0,0 +1,263 @@
+// Copyright (c) 2025 PotterWhite
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// libs/network/src/client/client-pool.cpp
+#include "Network/client/client-pool.h"
+#include "Utils/logger/logger.h"
+
+#include <thread>
+
+namespace arcforge {
+namespace embedded {
+namespace network_socket {
+
+/*===================================================
+ * ClientPool
+ *===================================================*/
+std::shared_ptr<ClientPool> ClientPool::create(const ClientPoolConfig& config) {
+	return std::shared_ptr<ClientPool>(new ClientPool(config));
+}
+
+ClientPool::ClientPool(const ClientPoolConfig& config) : config_(config) {}
+
+SocketReturnValue ClientPool::warmUp() {
+	while (true) {
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			if (closed_ == true) {
+				return SocketReturnValue::kpool_closed;
+			}
+			if (idle_.size() + leased_.size() + opening_ >= config_.size) {
+				return SocketReturnValue::ksuccess;
+			}
+			++opening_;
+		}
+
+		IdleClient idle;
+		const SocketReturnValue retval = openConnection(idle.client, idle.full_credits);
+
+		std::lock_guard<std::mutex> lock(mutex_);
+		--opening_;
+		if (retval != SocketReturnValue::ksuccess) {
+			released_.notify_one();
+			return retval;
+		}
+		idle_.push_back(std::move(idle));
+		released_.notify_one();
+	}
+}
+
+SocketReturnValue ClientPool::acquire(PooledClient& client, Deadline deadline) {
+	// hand a lease we still hold back before taking the lock the recycler needs
+	client.reset();
+
+	std::unique_lock<std::mutex> lock(mutex_);
+	while (true) {
+		if (closed_ == true) {
+			return SocketReturnValue::kpool_closed;
+		}
+
+		// most recently returned first: the one least likely to have hit the idle timeout
+		while (idle_.empty() == false) {
+			IdleClient idle = std::move(idle_.back());
+			idle_.pop_back();
+			if (isReusable(*idle.client, idle.full_credits) == true) {
+				leased_[idle.client.get()] = idle.full_credits;
+				client = PooledClient(idle.client.release(), ClientRecycler{shared_from_this()});
+				return SocketReturnValue::ksuccess;
+			}
+			arcforge::embedded::utils::Logger::GetInstance().Info(
+			    "Replacing a pooled connection the server closed while idle.", kcurrent_lib_name);
+		}
+
+		if (leased_.size() + opening_ < config_.size) {
+			++opening_;
+			lock.unlock();
+			std::unique_ptr<ClientBase> fresh;
+			uint32_t full_credits = kunlimited_send_credits;
+			const SocketReturnValue retval = openConnection(fresh, full_credits);
+			lock.lock();
+			--opening_;
+			if (retval != SocketReturnValue::ksuccess) {
+				released_.notify_one();
+				return retval;
+			}
+			leased_[fresh.get()] = full_credits;
+			client = PooledClient(fresh.release(), ClientRecycler{shared_from_this()});
+			return SocketReturnValue::ksuccess;
+		}
+
+		// every connection is leased: wait for one to come back
+		if (deadline == kno_deadline) {
+			released_.wait(lock);
+		} else if (released_.wait_until(lock, deadline) == std::cv_status::timeout) {
+			return SocketReturnValue::kio_timeout;
+		}
+	}
+}
+
+SocketReturnValue ClientPool::reconnect(PooledClient& client) {
+	if (client == nullptr) {
+		return SocketReturnValue::kimpl_nullptr_error;
+	}
+
+	// the broken connection keeps its slot while the new one is set up, so the pool never
+	// grows past its size
+	std::unique_ptr<ClientBase> fresh;
+	uint32_t full_credits = kunlimited_send_credits;
+	const SocketReturnValue retval = openConnection(fresh, full_credits);
+	if (retval != SocketReturnValue::ksuccess) {
+		return retval;
+	}
+
+	// the lease keeps its address, the old connection is closed with the state it gives up
+	*client = std::move(*fresh);
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	leased_[client.get()] = full_credits;
+	return SocketReturnValue::ksuccess;
+}
+
+SessionGrant ClientPool::getGrant() {
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	return grant_;
+}
+
+size_t ClientPool::idleCount() {
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	return idle_.size();
+}
+
+size_t ClientPool::leasedCount() {
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	return leased_.size();
+}
+
+void ClientPool::close() {
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	closed_ = true;
+	idle_.clear();
+	released_.notify_all();
+}
+
+void ClientPool::recycle(ClientBase* client) {
+	std::unique_ptr<ClientBase> owned(client);
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	uint32_t full_credits = kunlimited_send_credits;
+	auto leased = leased_.find(client);
+	if (leased != leased_.end()) {
+		full_credits = leased->second;
+		leased_.erase(leased);
+	}
+
+	if (closed_ == false && isReusable(*owned, full_credits) == true) {
+		idle_.push_back({std::move(owned), full_credits});
+	}
+	// a connection that is not reusable is closed right here, its slot opens up again
+	released_.notify_one();
+}
+
+SocketReturnValue ClientPool::openConnection(std::unique_ptr<ClientBase>& client,
+                                             uint32_t& full_credits) {
+	SocketReturnValue retval = SocketReturnValue::kconnect_server_failed;
+	const uint32_t attempts = std::max<uint32_t>(config_.connect_attempts, 1);
+
+	for (uint32_t attempt = 0; attempt < attempts; ++attempt) {
+		if (attempt > 0) {
+			std::this_thread::sleep_for(config_.retry_backoff * attempt);
+		}
+
+		auto fresh = std::make_unique<ClientBase>();
+		if (config_.tcp_port != 0) {
+			fresh->setTcpEndpoint(config_.tcp_host, config_.tcp_port);
+			fresh->setTcpOptions(config_.tcp_options);
+		} else {
+			fresh->setSocketPath(config_.socket_path);
+		}
+		retval = fresh->setSocketType(config_.socket_type);
+		if (retval != SocketReturnValue::ksuccess) {
+			return retval;
+		}
+
+		retval = fresh->connectToServer();
+		SessionGrant granted;
+		if (retval == SocketReturnValue::ksuccess) {
+			retval = fresh->handshake(config_.params, granted);
+		}
+		if (retval == SocketReturnValue::ksuccess) {
+			full_credits = fresh->getSendCredits();
+			client = std::move(fresh);
+			std::lock_guard<std::mutex> lock(mutex_);
+			grant_ = granted;
+			return SocketReturnValue::ksuccess;
+		}
+
+		arcforge::embedded::utils::Logger::GetInstance().Warning(
+		    "Pooled connection attempt " + std::to_string(attempt + 1) + " failed: " +
+		        SocketReturnValueToString(retval),
+		    kcurrent_lib_name);
+	}
+
+	return retval;
+}
+
+// reusable: open, every result of the last utterance read and nothing pending. A readable
+// idle socket either carries the server's hang-up or a stale result, neither of which may
+// reach the next request. Either may also have been read ahead already, into the staging
+// buffer or the io_uring buffers, where polling the socket does not see it.
+bool ClientPool::isReusable(ClientBase& client, uint32_t full_credits) {
+	if (client.isSocketFDValid() != SocketStatus::kvalid) {
+		return false;
+	}
+	if (client.getSendCredits() != full_credits) {
+		return false;
+	}
+	if (client.hasBufferedData() == true) {
+		return false;
+	}
+
+	struct pollfd pfds[2] = {{client.getFD(), POLLIN | POLLRDHUP, 0},
+	                         {client.getReadinessFD(), POLLIN, 0}};
+	const nfds_t count = (pfds[1].fd != pfds[0].fd) ? 2 : 1;
+	return ::poll(pfds, count, 0) == 0;
+}
+
+/*===================================================
+ * ClientRecycler
+ *===================================================*/
+void ClientRecycler::operator()(ClientBase* client) const {
+	if (client == nullptr) {
+		return;
+	}
+	if (pool != nullptr) {
+		pool->recycle(client);
+	} else {
+		delete client;
+	}
+}
+
+}  // namespace network_socket
+}  // namespace embedded
+}  // namespace arcforge
@@ -0,0 +1,113 @@
+// Copyright (c) 2025 PotterWhite
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// libs/network/src/common/audio-buffer.cpp
+#include "Network/common/audio-buffer.h"
+
+namespace arcforge {
+namespace embedded {
+namespace network_socket {
+
+/*===================================================
+ * AudioBuffer
+ *===================================================*/
+AudioBuffer::AudioBuffer(size_t capacity) {
+	reserve(capacity);
+}
+
+void AudioBuffer::reserve(size_t capacity) {
+	if (capacity <= capacity_) {
+		return;
+	}
+	// new float[] default-initialises, i.e. leaves the samples untouched
+	std::unique_ptr<float[]> grown(new float[capacity]);
+	if (size_ > 0) {
+		memcpy(grown.get(), storage_.get(), size_ * sizeof(float));
+	}
+	storage_ = std::move(grown);
+	capacity_ = capacity;
+}
+
+void AudioBuffer::resize(size_t count) {
+	if (count > capacity_) {
+		// the receive paths overwrite the whole frame, so don't carry old samples over
+		size_ = 0;
+		reserve(count);
+	}
+	size_ = count;
+}
+
+/*===================================================
+ * AudioBufferPool
+ *===================================================*/
+AudioBufferPool::AudioBufferPool(size_t max_cached) : max_cached_(max_cached) {}
+
+std::shared_ptr<AudioBufferPool> AudioBufferPool::create(size_t max_cached) {
+	return std::shared_ptr<AudioBufferPool>(new AudioBufferPool(max_cached));
+}
+
+PooledAudioBuffer AudioBufferPool::acquire(size_t min_capacity) {
+	std::unique_ptr<AudioBuffer> buffer;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (free_list_.empty() == false) {
+			buffer = std::move(free_list_.back());
+			free_list_.pop_back();
+		}
+	}
+	if (buffer == nullptr) {
+		buffer = std::make_unique<AudioBuffer>();
+	}
+
+	buffer->clear();
+	buffer->reserve(min_capacity);
+	return PooledAudioBuffer(buffer.release(), AudioBufferRecycler{shared_from_this()});
+}
+
+size_t AudioBufferPool::cachedCount() {
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	return free_list_.size();
+}
+
+void AudioBufferPool::recycle(AudioBuffer* buffer) {
+	std::unique_ptr<AudioBuffer> owned(buffer);
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (free_list_.size() < max_cached_) {
+		free_list_.push_back(std::move(owned));
+	}
+}
+
+void AudioBufferRecycler::operator()(AudioBuffer* buffer) const {
+	if (buffer == nullptr) {
+		return;
+	}
+	if (pool != nullptr) {
+		pool->recycle(buffer);
+	} else {
+		delete buffer;
+	}
+}
+
+}  // namespace network_socket
+}  // namespace embedded
+}  // namespace arcforge
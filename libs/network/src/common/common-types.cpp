@@ -38,6 +38,14 @@ std::string SocketReturnValueToString(SocketReturnValue value) {
 			return "kreceived_illegal (0x51)";
 		case SocketReturnValue::kreceivelength_failed:
 			return "kreceivelength_failed (0x52)";
+		case SocketReturnValue::kreceived_fds:
+			return "kreceived_fds (0x53)";
+		case SocketReturnValue::kreceived_encoding_offer:
+			return "kreceived_encoding_offer (0x54)";
+		case SocketReturnValue::kreceived_hello:
+			return "kreceived_hello (0x55)";
+		case SocketReturnValue::kserver_busy:
+			return "kserver_busy (0x56)";
 		// --- send opts errors ---
 		case SocketReturnValue::ksendcount_failed:
 			return "ksendcount_failed (0x60)";
@@ -45,6 +53,8 @@ std::string SocketReturnValueToString(SocketReturnValue value) {
 			return "ksenddata_failed (0x61)";
 		case SocketReturnValue::ksendlength_failed:
 			return "ksendlength_failed (0x62)";
+		case SocketReturnValue::kno_send_credit:
+			return "kno_send_credit (0x63)";
 		// --- configuration errors ---
 		case SocketReturnValue::kcount_too_large:
 			return "kcount_too_large (0x70)";
@@ -56,6 +66,10 @@ std::string SocketReturnValueToString(SocketReturnValue value) {
 			return "keof (0x73)";
 		case SocketReturnValue::ksocketpath_empty:
 			return "ksocketpath_empty (0x74)";
+		case SocketReturnValue::kbuffer_too_small:
+			return "kbuffer_too_small (0x75)";
+		case SocketReturnValue::ksample_encoding_mismatch:
+			return "ksample_encoding_mismatch (0x76)";
 		// --- posix api errors ---
 		case SocketReturnValue::kconnect_server_failed:
 			return "kconnect_server_failed (0x80)";
@@ -69,9 +83,21 @@ std::string SocketReturnValueToString(SocketReturnValue value) {
 			return "kaccept_timeout (0x84)";
 		case SocketReturnValue::ksetsocketopt_error:
 			return "ksetsocketopt_error (0x85)";
+		case SocketReturnValue::kepoll_error:
+			return "kepoll_error (0x86)";
+		case SocketReturnValue::kio_timeout:
+			return "kio_timeout (0x87)";
+		case SocketReturnValue::kpool_closed:
+			return "kpool_closed (0x88)";
+		case SocketReturnValue::kcancelled:
+			return "kcancelled (0x89)";
+		case SocketReturnValue::kpeer_credentials_unavailable:
+			return "kpeer_credentials_unavailable (0x8a)";
 		// --- impl layer errors ---
 		case SocketReturnValue::kimpl_nullptr_error:
 			return "kimpl_nullptr_error (0x90)";
+		case SocketReturnValue::kio_backend_unavailable:
+			return "kio_backend_unavailable (0x91)";
 		// ***************************
 		case SocketReturnValue::kinit_state:
 			return "kinit_state (0xff)";
@@ -96,16 +122,23 @@ bool SocketReturnValueIsSuccess(SocketReturnValue value) {
 		case SocketReturnValue::kreceived_null:
 		case SocketReturnValue::kreceived_illegal:
 		case SocketReturnValue::kreceivelength_failed:
+		case SocketReturnValue::kreceived_fds:
+		case SocketReturnValue::kreceived_encoding_offer:
+		case SocketReturnValue::kreceived_hello:
+		case SocketReturnValue::kserver_busy:
 		// --- send opts errors ---
 		case SocketReturnValue::ksendcount_failed:
 		case SocketReturnValue::ksenddata_failed:
 		case SocketReturnValue::ksendlength_failed:
+		case SocketReturnValue::kno_send_credit:
 		// --- configuration errors ---
 		case SocketReturnValue::kcount_too_large:
 		case SocketReturnValue::kempty_string:
 		case SocketReturnValue::kfd_illegal:
 		case SocketReturnValue::keof:
 		case SocketReturnValue::ksocketpath_empty:
+		case SocketReturnValue::kbuffer_too_small:
+		case SocketReturnValue::ksample_encoding_mismatch:
 		// --- posix api errors ---
 		case SocketReturnValue::kconnect_server_failed:
 		case SocketReturnValue::klisten_error:
@@ -113,8 +146,14 @@ bool SocketReturnValueIsSuccess(SocketReturnValue value) {
 		case SocketReturnValue::kpeer_abnormally_closed:
 		case SocketReturnValue::kaccept_timeout:
 		case SocketReturnValue::ksetsocketopt_error:
+		case SocketReturnValue::kepoll_error:
+		case SocketReturnValue::kio_timeout:
+		case SocketReturnValue::kpool_closed:
+		case SocketReturnValue::kcancelled:
+		case SocketReturnValue::kpeer_credentials_unavailable:
 			// --- impl layer errors ---
 		case SocketReturnValue::kimpl_nullptr_error:
+		case SocketReturnValue::kio_backend_unavailable:
 		// ***************************
 		case SocketReturnValue::kinit_state:
 		case SocketReturnValue::kunknownerror:
@@ -0,0 +1,151 @@
+// Copyright (c) 2025 PotterWhite
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// libs/network/src/common/sample-codec.cpp
+#include "Network/common/sample-codec.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace arcforge {
+namespace embedded {
+namespace network_socket {
+
+namespace {
+
+constexpr float kpcm16_scale = 1.0f / 32768.0f;
+
+int16_t FloatToPcm16(float sample) {
+	const float scaled = std::nearbyint(sample * 32768.0f);
+	if (scaled >= 32767.0f) {
+		return 32767;
+	}
+	if (scaled <= -32768.0f) {
+		return -32768;
+	}
+	return static_cast<int16_t>(scaled);
+}
+
+// G.711 µ-law on 14-bit magnitude, the classic bias/clip constants
+constexpr int kmulaw_bias = 0x84;
+constexpr int kmulaw_clip = 32635;
+
+uint8_t Pcm16ToMulaw(int16_t pcm) {
+	const int sign = (pcm < 0) ? 0x80 : 0x00;
+	int magnitude = (pcm < 0) ? -static_cast<int>(pcm) : static_cast<int>(pcm);
+	magnitude = std::min(magnitude, kmulaw_clip) + kmulaw_bias;
+
+	int exponent = 7;
+	for (int mask = 0x4000; (magnitude & mask) == 0 && exponent > 0; mask >>= 1) {
+		--exponent;
+	}
+	const int mantissa = (magnitude >> (exponent + 3)) & 0x0F;
+	return static_cast<uint8_t>(~(sign | (exponent << 4) | mantissa));
+}
+
+int16_t MulawToPcm16(uint8_t code) {
+	const int inverted = static_cast<uint8_t>(~code);
+	const int exponent = (inverted >> 4) & 0x07;
+	const int mantissa = inverted & 0x0F;
+	const int magnitude = (((mantissa << 3) + kmulaw_bias) << exponent) - kmulaw_bias;
+	return static_cast<int16_t>((inverted & 0x80) != 0 ? -magnitude : magnitude);
+}
+
+}  // namespace
+
+void ConvertPcm16ToFloat(const int16_t* src, float* dst, size_t count) {
+	size_t i = 0;
+#if defined(__SSE2__)
+	const __m128 scale = _mm_set1_ps(kpcm16_scale);
+	for (; i + 8 <= count; i += 8) {
+		const __m128i pcm = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+		// unpack into the high half and shift back down: sign-extends without SSE4.1
+		const __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(pcm, pcm), 16);
+		const __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(pcm, pcm), 16);
+		_mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(low), scale));
+		_mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(high), scale));
+	}
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+	for (; i + 8 <= count; i += 8) {
+		const int16x8_t pcm = vld1q_s16(src + i);
+		vst1q_f32(dst + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(pcm))), kpcm16_scale));
+		vst1q_f32(dst + i + 4,
+		          vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(pcm))), kpcm16_scale));
+	}
+#endif
+	for (; i < count; ++i) {
+		dst[i] = static_cast<float>(src[i]) * kpcm16_scale;
+	}
+}
+
+void ConvertFloatToPcm16(const float* src, int16_t* dst, size_t count) {
+	size_t i = 0;
+#if defined(__SSE2__)
+	// clamp first: cvtps turns out-of-range values into INT_MIN, packs then saturates
+	const __m128 scale = _mm_set1_ps(32768.0f);
+	const __m128 upper = _mm_set1_ps(32767.0f);
+	const __m128 lower = _mm_set1_ps(-32768.0f);
+	for (; i + 8 <= count; i += 8) {
+		const __m128 low = _mm_max_ps(_mm_min_ps(_mm_mul_ps(_mm_loadu_ps(src + i), scale), upper),
+		                              lower);
+		const __m128 high = _mm_max_ps(
+		    _mm_min_ps(_mm_mul_ps(_mm_loadu_ps(src + i + 4), scale), upper), lower);
+		const __m128i packed = _mm_packs_epi32(_mm_cvtps_epi32(low), _mm_cvtps_epi32(high));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), packed);
+	}
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+	for (; i + 8 <= count; i += 8) {
+		const int32x4_t low = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(src + i), 32768.0f));
+		const int32x4_t high = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(src + i + 4), 32768.0f));
+		vst1q_s16(dst + i, vcombine_s16(vqmovn_s32(low), vqmovn_s32(high)));
+	}
+#endif
+	for (; i < count; ++i) {
+		dst[i] = FloatToPcm16(src[i]);
+	}
+}
+
+void ConvertMulawToFloat(const uint8_t* src, float* dst, size_t count) {
+	static const std::array<float, 256> table = []() {
+		std::array<float, 256> decoded{};
+		for (size_t code = 0; code < decoded.size(); ++code) {
+			decoded[code] =
+			    static_cast<float>(MulawToPcm16(static_cast<uint8_t>(code))) * kpcm16_scale;
+		}
+		return decoded;
+	}();
+
+	for (size_t i = 0; i < count; ++i) {
+		dst[i] = table[src[i]];
+	}
+}
+
+void ConvertFloatToMulaw(const float* src, uint8_t* dst, size_t count) {
+	for (size_t i = 0; i < count; ++i) {
+		dst[i] = Pcm16ToMulaw(FloatToPcm16(src[i]));
+	}
+}
+
+}  // namespace network_socket
+}  // namespace embedded
+}  // namespace arcforge
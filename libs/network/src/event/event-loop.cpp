@@ -0,0 +1,101 @@
+// Copyright (c) 2025 PotterWhite
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "Network/event/event-loop.h"
+#include "Network/event/impl/event-loop-impl.h"
+
+namespace arcforge {
+namespace embedded {
+namespace network_socket {
+
+EventLoop::EventLoop() : impl_(std::make_unique<EventLoopImpl>()) {}
+
+EventLoop::~EventLoop() {}
+
+EventLoop::EventLoop(EventLoop&& other) noexcept = default;
+
+EventLoop& EventLoop::operator=(EventLoop&& other) noexcept = default;
+
+SocketReturnValue EventLoop::addFD(int fd, uint32_t events, EventCallback callback) {
+	if (impl_) {
+		return impl_->addFD_safe(fd, events, std::move(callback), nullptr);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue EventLoop::addFD(int fd, uint32_t events, EventCallback callback,
+                                   PendingCheck has_pending) {
+	if (impl_) {
+		return impl_->addFD_safe(fd, events, std::move(callback), std::move(has_pending));
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue EventLoop::modifyFD(int fd, uint32_t events) {
+	if (impl_) {
+		return impl_->modifyFD_safe(fd, events);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue EventLoop::removeFD(int fd) {
+	if (impl_) {
+		return impl_->removeFD_safe(fd);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue EventLoop::runOnce(int timeout_ms) {
+	if (impl_) {
+		return impl_->runOnce(timeout_ms);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue EventLoop::run() {
+	if (impl_) {
+		return impl_->run();
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+void EventLoop::stop() {
+	if (impl_) {
+		impl_->stop();
+	}
+}
+
+void EventLoop::wakeup() {
+	if (impl_) {
+		impl_->wakeup();
+	}
+}
+
+bool EventLoop::isStopped() const {
+	if (impl_) {
+		return impl_->isStopped();
+	}
+	return true;
+}
+
+}  // namespace network_socket
+}  // namespace embedded
+}  // namespace arcforge
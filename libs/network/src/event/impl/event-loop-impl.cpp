@@ -0,0 +1,288 @@
+// Copyright (c) 2025 PotterWhite
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "Network/event/impl/event-loop-impl.h"
+#include "Utils/logger/logger.h"
+
+namespace arcforge {
+namespace embedded {
+namespace network_socket {
+
+/*===================================================
+ * constructors and operators
+ *===================================================*/
+EventLoopImpl::EventLoopImpl() : ready_events_(kmax_events_per_wait_) {
+	epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+	if (epoll_fd_ < 0) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "EventLoopImpl: epoll_create1() failed. errno: " + std::to_string(errno) + " (" +
+		        strerror(errno) + ")",
+		    kcurrent_lib_name);
+		return;
+	}
+
+	// eventfd is the self-pipe: stop()/wakeup() write to it, the loop drains it
+	wakeup_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (wakeup_fd_ < 0) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "EventLoopImpl: eventfd() failed. errno: " + std::to_string(errno) + " (" +
+		        strerror(errno) + ")",
+		    kcurrent_lib_name);
+		return;
+	}
+
+	struct epoll_event ev;
+	memset(&ev, 0, sizeof(ev));
+	ev.events = EPOLLIN;
+	ev.data.fd = wakeup_fd_;
+	if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wakeup_fd_, &ev) < 0) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "EventLoopImpl: failed to register wakeup fd. errno: " + std::to_string(errno),
+		    kcurrent_lib_name);
+	}
+}
+
+EventLoopImpl::~EventLoopImpl() {
+	if (wakeup_fd_ >= 0) {
+		close(wakeup_fd_);
+		wakeup_fd_ = -1;
+	}
+	if (epoll_fd_ >= 0) {
+		close(epoll_fd_);
+		epoll_fd_ = -1;
+	}
+}
+
+/*===================================================
+ * interest list management
+ *===================================================*/
+SocketReturnValue EventLoopImpl::addFD_safe(int fd, uint32_t events,
+                                            EventLoop::EventCallback callback,
+                                            EventLoop::PendingCheck has_pending) {
+	if (epoll_fd_ < 0 || fd < 0) {
+		return SocketReturnValue::kfd_illegal;
+	}
+
+	std::lock_guard<std::mutex> lock(handlers_mutex_);
+
+	struct epoll_event ev;
+	memset(&ev, 0, sizeof(ev));
+	ev.events = events;
+	ev.data.fd = fd;
+	if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) < 0) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "EventLoopImpl::addFD - epoll_ctl(ADD) failed for fd " + std::to_string(fd) +
+		        ". errno: " + std::to_string(errno) + " (" + strerror(errno) + ")",
+		    kcurrent_lib_name);
+		return SocketReturnValue::kepoll_error;
+	}
+
+	Handler& handler = handlers_[fd];
+	handler.callback = std::make_shared<EventLoop::EventCallback>(std::move(callback));
+	handler.has_pending = std::move(has_pending);
+	handler.events = events;
+
+	return SocketReturnValue::ksuccess;
+}
+
+SocketReturnValue EventLoopImpl::modifyFD_safe(int fd, uint32_t events) {
+	if (epoll_fd_ < 0 || fd < 0) {
+		return SocketReturnValue::kfd_illegal;
+	}
+
+	std::lock_guard<std::mutex> lock(handlers_mutex_);
+
+	struct epoll_event ev;
+	memset(&ev, 0, sizeof(ev));
+	ev.events = events;
+	ev.data.fd = fd;
+	if (::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &ev) < 0) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "EventLoopImpl::modifyFD - epoll_ctl(MOD) failed for fd " + std::to_string(fd) +
+		        ". errno: " + std::to_string(errno),
+		    kcurrent_lib_name);
+		return SocketReturnValue::kepoll_error;
+	}
+
+	auto it = handlers_.find(fd);
+	if (it != handlers_.end()) {
+		it->second.events = events;
+	}
+
+	return SocketReturnValue::ksuccess;
+}
+
+SocketReturnValue EventLoopImpl::removeFD_safe(int fd) {
+	if (epoll_fd_ < 0 || fd < 0) {
+		return SocketReturnValue::kfd_illegal;
+	}
+
+	std::lock_guard<std::mutex> lock(handlers_mutex_);
+
+	handlers_.erase(fd);
+	if (::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr) < 0) {
+		// the fd may already have been closed, which removes it from epoll implicitly
+		arcforge::embedded::utils::Logger::GetInstance().Debug(
+		    "EventLoopImpl::removeFD - epoll_ctl(DEL) failed for fd " + std::to_string(fd) +
+		        ". errno: " + std::to_string(errno),
+		    kcurrent_lib_name);
+		return SocketReturnValue::kepoll_error;
+	}
+
+	return SocketReturnValue::ksuccess;
+}
+
+/*===================================================
+ * dispatch
+ *===================================================*/
+SocketReturnValue EventLoopImpl::runOnce(int timeout_ms) {
+	if (epoll_fd_ < 0) {
+		return SocketReturnValue::kfd_illegal;
+	}
+
+	// input already taken off a socket (read-ahead, io_uring buffers) will not wake epoll
+	pending_fds_.clear();
+	{
+		std::lock_guard<std::mutex> lock(handlers_mutex_);
+		for (const auto& [fd, handler] : handlers_) {
+			if (handler.has_pending && (handler.events & kevent_readable) != 0 &&
+			    handler.has_pending() == true) {
+				pending_fds_.push_back(fd);
+			}
+		}
+	}
+	if (pending_fds_.empty() == false) {
+		timeout_ms = 0;
+	}
+
+	int ready_count = ::epoll_wait(epoll_fd_, ready_events_.data(), kmax_events_per_wait_,
+	                               timeout_ms);
+	if (ready_count < 0) {
+		if (errno == EINTR) {
+			// interrupted by a signal, let the caller re-check its own flags
+			return SocketReturnValue::ksuccess;
+		}
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "EventLoopImpl::runOnce - epoll_wait() failed. errno: " + std::to_string(errno) +
+		        " (" + strerror(errno) + ")",
+		    kcurrent_lib_name);
+		return SocketReturnValue::kepoll_error;
+	}
+
+	for (int i = 0; i < ready_count; ++i) {
+		const struct epoll_event& ev = ready_events_[static_cast<size_t>(i)];
+		if (ev.data.fd == wakeup_fd_) {
+			drainWakeupFD();
+			continue;
+		}
+
+		CallbackHolder holder;
+		{
+			std::lock_guard<std::mutex> lock(handlers_mutex_);
+			auto it = handlers_.find(ev.data.fd);
+			if (it == handlers_.end()) {
+				// removed by an earlier callback of this same batch
+				continue;
+			}
+			holder = it->second.callback;
+		}
+
+		// invoke without holding the lock so the callback may (de)register fds
+		if (holder && *holder) {
+			(*holder)(ev.events);
+		}
+	}
+
+	// pending fds epoll did not report get a readable event of their own
+	for (const int fd : pending_fds_) {
+		bool reported = false;
+		for (int i = 0; i < ready_count; ++i) {
+			if (ready_events_[static_cast<size_t>(i)].data.fd == fd) {
+				reported = true;
+				break;
+			}
+		}
+		if (reported == true) {
+			continue;
+		}
+
+		CallbackHolder holder;
+		{
+			std::lock_guard<std::mutex> lock(handlers_mutex_);
+			auto it = handlers_.find(fd);
+			// removed, or no longer reading, by an earlier callback of this round
+			if (it == handlers_.end() || (it->second.events & kevent_readable) == 0) {
+				continue;
+			}
+			holder = it->second.callback;
+		}
+		if (holder && *holder) {
+			(*holder)(kevent_readable);
+		}
+	}
+
+	return SocketReturnValue::ksuccess;
+}
+
+SocketReturnValue EventLoopImpl::run() {
+	// not reset on entry: a stop() that came before run() (e.g. from a signal handler during
+	// start-up) must still end the loop. It is consumed on the way out, so run() can be reused.
+	SocketReturnValue retval = SocketReturnValue::ksuccess;
+	while (stop_flag_ == false) {
+		retval = runOnce(-1);
+		if (retval != SocketReturnValue::ksuccess) {
+			break;
+		}
+	}
+
+	stop_flag_ = false;
+	return retval;
+}
+
+void EventLoopImpl::stop() {
+	stop_flag_ = true;
+	wakeup();
+}
+
+void EventLoopImpl::wakeup() {
+	if (wakeup_fd_ < 0) {
+		return;
+	}
+
+	// only write(2) here, this must stay async-signal-safe
+	uint64_t one = 1;
+	ssize_t n = ::write(wakeup_fd_, &one, sizeof(one));
+	(void)n;
+}
+
+bool EventLoopImpl::isStopped() const {
+	return stop_flag_;
+}
+
+void EventLoopImpl::drainWakeupFD() {
+	uint64_t counter = 0;
+	while (::read(wakeup_fd_, &counter, sizeof(counter)) > 0) {
+	}
+}
+
+}  // namespace network_socket
+}  // namespace embedded
+}  // namespace arcforge
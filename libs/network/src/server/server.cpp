@@ -25,10 +25,12 @@ namespace arcforge {
 namespace embedded {
 namespace network_socket {
 
-ServerBase::ServerBase() {}
+ServerBase::ServerBase() : event_loop_(std::make_unique<EventLoop>()) {}
 
 ServerBase::~ServerBase() {
 
+	disableEventMode();
+
 	std::ostringstream ss;
 	ss << "[ServerBase PID:" << getpid()
 	   << "] ServerBase destructor called. Attempting to unlink socket path.";
@@ -42,6 +44,113 @@ ServerBase::~ServerBase() {
 	arcforge::embedded::utils::Logger::GetInstance().Info(ss.str(), kcurrent_lib_name);
 }
 
+/*===================================================
+ * event-driven mode
+ *===================================================*/
+SocketReturnValue ServerBase::enableEventMode(AcceptHandler on_accept) {
+	int listening_fd = getFD();
+	if (listening_fd < 0) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "ServerBase::enableEventMode - server is not started, call startServer() first.",
+		    kcurrent_lib_name);
+		return SocketReturnValue::kfd_illegal;
+	}
+
+	// drain-until-EAGAIN needs a non-blocking listening fd
+	int flags = ::fcntl(listening_fd, F_GETFL, 0);
+	if (flags < 0 || ::fcntl(listening_fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "ServerBase::enableEventMode - fcntl(O_NONBLOCK) failed. errno: " +
+		        std::to_string(errno),
+		    kcurrent_lib_name);
+		return SocketReturnValue::ksetsocketopt_error;
+	}
+
+	disableEventMode();
+
+	on_accept_ = std::move(on_accept);
+	SocketReturnValue retval = event_loop_->addFD(
+	    listening_fd, kevent_readable, [this](uint32_t events) { onListeningFDReady(events); });
+	if (retval != SocketReturnValue::ksuccess) {
+		return retval;
+	}
+
+	watched_fd_ = listening_fd;
+	accepting_ = true;
+
+	return SocketReturnValue::ksuccess;
+}
+
+void ServerBase::disableEventMode() {
+	if (watched_fd_ >= 0) {
+		event_loop_->removeFD(watched_fd_);
+		watched_fd_ = -1;
+	}
+	accepting_ = false;
+}
+
+SocketReturnValue ServerBase::setAccepting(bool accepting) {
+	if (watched_fd_ < 0) {
+		return SocketReturnValue::kfd_illegal;
+	}
+	if (accepting_ == accepting) {
+		return SocketReturnValue::ksuccess;
+	}
+
+	// an empty interest set keeps the fd registered but silent (no busy wake-ups while full)
+	SocketReturnValue retval =
+	    event_loop_->modifyFD(watched_fd_, accepting ? kevent_readable : 0u);
+	if (retval == SocketReturnValue::ksuccess) {
+		accepting_ = accepting;
+	}
+
+	return retval;
+}
+
+SocketReturnValue ServerBase::run(AcceptHandler on_accept) {
+	SocketReturnValue retval = enableEventMode(std::move(on_accept));
+	if (retval != SocketReturnValue::ksuccess) {
+		return retval;
+	}
+
+	return event_loop_->run();
+}
+
+void ServerBase::stop() {
+	event_loop_->stop();
+}
+
+EventLoop& ServerBase::getEventLoop() {
+	return *event_loop_;
+}
+
+void ServerBase::onListeningFDReady(uint32_t events) {
+	if ((events & kevent_error) != 0) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "ServerBase: error condition reported on the listening fd", kcurrent_lib_name);
+	}
+
+	// accept everything that is queued, the handler may pause us half-way
+	while (accepting_ == true) {
+		SocketAcceptReturn accept_retval = acceptClient();
+		if (accept_retval.return_value == SocketReturnValue::kaccept_timeout) {
+			// EAGAIN: backlog is empty
+			break;
+		}
+		if (SocketReturnValueIsSuccess(accept_retval.return_value) == false) {
+			arcforge::embedded::utils::Logger::GetInstance().Error(
+			    "ServerBase: acceptClient() returned " +
+			        SocketReturnValueToString(accept_retval.return_value),
+			    kcurrent_lib_name);
+			break;
+		}
+
+		if (on_accept_) {
+			on_accept_(std::move(accept_retval.client));
+		}
+	}
+}
+
 }  // namespace network_socket
 }  // namespace embedded
 }  // namespace arcforge
\ No newline at end of file
@@ -0,0 +1,344 @@
+// Copyright (c) 2025 PotterWhite
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// libs/network/src/shm/impl/shm-channel-impl.cpp
+#include "Network/shm/impl/shm-channel-impl.h"
+#include "Utils/logger/logger.h"
+
+#include <new>  //placement new
+#include <sys/stat.h>
+
+namespace arcforge {
+namespace embedded {
+namespace network_socket {
+
+/*===================================================
+ * constructors and operators
+ *===================================================*/
+ShmChannelImpl::ShmChannelImpl(bool is_writer, int control_fd)
+    : is_writer_(is_writer), control_fd_(control_fd) {}
+
+ShmChannelImpl::~ShmChannelImpl() {
+	release();
+}
+
+void ShmChannelImpl::release() {
+	if (mapping_ != nullptr) {
+		::munmap(mapping_, mapping_size_);
+		mapping_ = nullptr;
+		header_ = nullptr;
+	}
+	for (int* fd : {&memfd_, &data_event_fd_, &space_event_fd_}) {
+		if (*fd >= 0) {
+			::close(*fd);
+			*fd = -1;
+		}
+	}
+}
+
+/*===================================================
+ * setup
+ *===================================================*/
+SocketReturnValue ShmChannelImpl::create(size_t capacity_bytes) {
+	// whole records only: keeps every record and wrap marker 8-byte aligned
+	capacity_ = (capacity_bytes + 7) & ~uint64_t{7};
+	mapping_size_ = kshm_data_offset + capacity_;
+
+	memfd_ = ::memfd_create("arcforge-shm-ring", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+	if (memfd_ < 0 || ::ftruncate(memfd_, static_cast<off_t>(mapping_size_)) < 0) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    std::string("ShmChannel: memfd setup failed: ") + strerror(errno), kcurrent_lib_name);
+		release();
+		return SocketReturnValue::kfd_illegal;
+	}
+	// the reader maps the same size; a sealed size means it can never hit SIGBUS
+	::fcntl(memfd_, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL);
+
+	data_event_fd_ = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	space_event_fd_ = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	mapping_ = ::mmap(nullptr, mapping_size_, PROT_READ | PROT_WRITE, MAP_SHARED, memfd_, 0);
+	if (data_event_fd_ < 0 || space_event_fd_ < 0 || mapping_ == MAP_FAILED) {
+		mapping_ = mapping_ == MAP_FAILED ? nullptr : mapping_;
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    std::string("ShmChannel: ring setup failed: ") + strerror(errno), kcurrent_lib_name);
+		release();
+		return SocketReturnValue::kfd_illegal;
+	}
+
+	header_ = new (mapping_) ShmRingHeader();
+	header_->magic = kshm_magic;
+	header_->version = kshm_version;
+	header_->capacity = capacity_;
+	header_->write_pos.store(0);
+	header_->read_pos.store(0);
+	header_->reader_waiting.store(0);
+	header_->writer_waiting.store(0);
+	header_->closed.store(0);
+
+	return SocketReturnValue::ksuccess;
+}
+
+SocketReturnValue ShmChannelImpl::attach(const std::vector<int>& fds) {
+	if (fds.size() != 3) {
+		for (int fd : fds) {
+			::close(fd);
+		}
+		return SocketReturnValue::kreceived_illegal;
+	}
+	memfd_ = fds[0];
+	data_event_fd_ = fds[1];
+	space_event_fd_ = fds[2];
+
+	struct stat file_stat;
+	const int seals = ::fcntl(memfd_, F_GET_SEALS);
+	if (::fstat(memfd_, &file_stat) < 0 ||
+	    file_stat.st_size < static_cast<off_t>(kshm_data_offset) || seals < 0 ||
+	    (seals & F_SEAL_SHRINK) == 0) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "ShmChannel: passed memfd is not a sealed ring", kcurrent_lib_name);
+		release();
+		return SocketReturnValue::kreceived_illegal;
+	}
+
+	mapping_size_ = static_cast<size_t>(file_stat.st_size);
+	mapping_ = ::mmap(nullptr, mapping_size_, PROT_READ | PROT_WRITE, MAP_SHARED, memfd_, 0);
+	if (mapping_ == MAP_FAILED) {
+		mapping_ = nullptr;
+		release();
+		return SocketReturnValue::kfd_illegal;
+	}
+
+	header_ = static_cast<ShmRingHeader*>(mapping_);
+	capacity_ = header_->capacity;
+	if (header_->magic != kshm_magic || header_->version != kshm_version ||
+	    capacity_ > mapping_size_ - kshm_data_offset || (capacity_ & 7) != 0) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "ShmChannel: ring header mismatch", kcurrent_lib_name);
+		release();
+		return SocketReturnValue::kreceived_illegal;
+	}
+
+	return SocketReturnValue::ksuccess;
+}
+
+std::vector<int> ShmChannelImpl::passableFDs() const {
+	return {memfd_, data_event_fd_, space_event_fd_};
+}
+
+/*===================================================
+ * helpers
+ *===================================================*/
+size_t ShmChannelImpl::recordSize(size_t count) {
+	return kshm_record_header + ((count * sizeof(float) + 7) & ~size_t{7});
+}
+
+char* ShmChannelImpl::data() const {
+	return static_cast<char*>(mapping_) + kshm_data_offset;
+}
+
+void ShmChannelImpl::notify(int event_fd, std::atomic<uint32_t>& waiting_flag) {
+	// pairs with the store/re-check in waitFor(): either the sleeper sees the new position
+	// or we see its flag, so no wake-up is lost and an awake peer costs no syscall
+	if (waiting_flag.load() != 0) {
+		uint64_t one = 1;
+		[[maybe_unused]] ssize_t written = ::write(event_fd, &one, sizeof(one));
+	}
+}
+
+bool ShmChannelImpl::waitFor(int event_fd, std::atomic<uint32_t>& waiting_flag,
+                             const std::function<bool()>& ready) {
+	waiting_flag.store(1);
+	if (ready() || header_->closed.load() != 0) {
+		waiting_flag.store(0);
+		return true;
+	}
+
+	struct pollfd fds[2];
+	fds[0].fd = event_fd;
+	fds[0].events = POLLIN;
+	fds[0].revents = 0;
+	// the control socket only tells us about a vanished peer
+	fds[1].fd = control_fd_;
+	fds[1].events = POLLRDHUP;
+	fds[1].revents = 0;
+	const nfds_t fd_count = control_fd_ >= 0 ? 2 : 1;
+
+	int retval = ::poll(fds, fd_count, -1);
+	waiting_flag.store(0);
+	if (retval < 0) {
+		return errno == EINTR;
+	}
+
+	if ((fds[0].revents & POLLIN) != 0) {
+		uint64_t counter = 0;
+		[[maybe_unused]] ssize_t drained = ::read(event_fd, &counter, sizeof(counter));
+	}
+	if (fd_count == 2 && (fds[1].revents & (POLLRDHUP | POLLHUP | POLLERR | POLLNVAL)) != 0) {
+		peer_gone_ = true;
+	}
+	return true;
+}
+
+/*===================================================
+ * writer
+ *===================================================*/
+SocketReturnValue ShmChannelImpl::sendFloat(const float* samples, size_t count) {
+	if (header_ == nullptr || is_writer_ == false) {
+		return SocketReturnValue::kfd_illegal;
+	}
+
+	const uint64_t record = recordSize(count);
+	if (record > capacity_ / 2) {
+		return SocketReturnValue::kcount_too_large;
+	}
+
+	// only this side moves write_pos
+	uint64_t write_pos = header_->write_pos.load(std::memory_order_relaxed);
+	uint64_t offset = write_pos % capacity_;
+	const uint64_t tail_room = capacity_ - offset;
+	const uint64_t needed = record + (record > tail_room ? tail_room : 0);
+
+	auto has_room = [&]() { return capacity_ - (write_pos - header_->read_pos.load()) >= needed; };
+	while (has_room() == false) {
+		if (header_->closed.load() != 0 || peer_gone_) {
+			return SocketReturnValue::kpeer_abnormally_closed;
+		}
+		if (waitFor(space_event_fd_, header_->writer_waiting, has_room) == false) {
+			return SocketReturnValue::ksenddata_failed;
+		}
+	}
+
+	if (record > tail_room) {
+		// records never straddle the end, so the reader can hand out a contiguous pointer
+		const uint32_t marker = kshm_wrap_marker;
+		memcpy(data() + offset, &marker, sizeof(marker));
+		write_pos += tail_room;
+		offset = 0;
+	}
+
+	const uint32_t count32 = static_cast<uint32_t>(count);
+	memcpy(data() + offset, &count32, sizeof(count32));
+	if (count > 0) {
+		memcpy(data() + offset + kshm_record_header, samples, count * sizeof(float));
+	}
+
+	header_->write_pos.store(write_pos + record);
+	notify(data_event_fd_, header_->reader_waiting);
+	return SocketReturnValue::ksuccess;
+}
+
+/*===================================================
+ * reader
+ *===================================================*/
+SocketReturnValue ShmChannelImpl::peekFloat(const float*& samples, size_t& count) {
+	samples = nullptr;
+	count = 0;
+	if (header_ == nullptr || is_writer_ == true) {
+		return SocketReturnValue::kfd_illegal;
+	}
+	releaseFloat();
+
+	while (true) {
+		const uint64_t read_pos = header_->read_pos.load(std::memory_order_relaxed);
+		const uint64_t write_pos = header_->write_pos.load(std::memory_order_acquire);
+
+		if (write_pos == read_pos) {
+			if (header_->closed.load() != 0 || peer_gone_) {
+				return SocketReturnValue::kpeer_abnormally_closed;
+			}
+			auto has_data = [&]() { return header_->write_pos.load() != read_pos; };
+			if (waitFor(data_event_fd_, header_->reader_waiting, has_data) == false) {
+				return SocketReturnValue::kreceived_illegal;
+			}
+			continue;
+		}
+
+		const uint64_t offset = read_pos % capacity_;
+		uint32_t frame_count = 0;
+		memcpy(&frame_count, data() + offset, sizeof(frame_count));
+
+		if (frame_count == kshm_wrap_marker) {
+			header_->read_pos.store(read_pos + (capacity_ - offset));
+			notify(space_event_fd_, header_->writer_waiting);
+			continue;
+		}
+
+		// the peer is another process: never trust a record to stay inside the ring
+		const uint64_t record = recordSize(frame_count);
+		if (record > capacity_ - offset || record > write_pos - read_pos) {
+			arcforge::embedded::utils::Logger::GetInstance().Error(
+			    "ShmChannel: corrupted record in ring", kcurrent_lib_name);
+			return SocketReturnValue::kreceived_illegal;
+		}
+
+		if (frame_count == 0) {
+			header_->read_pos.store(read_pos + record);
+			notify(space_event_fd_, header_->writer_waiting);
+			return SocketReturnValue::keof;
+		}
+
+		samples = static_cast<const float*>(
+		    static_cast<const void*>(data() + offset + kshm_record_header));
+		count = frame_count;
+		pending_release_ = record;
+		return SocketReturnValue::ksuccess;
+	}
+}
+
+void ShmChannelImpl::releaseFloat() {
+	if (pending_release_ == 0 || header_ == nullptr) {
+		return;
+	}
+	header_->read_pos.store(header_->read_pos.load(std::memory_order_relaxed) + pending_release_);
+	pending_release_ = 0;
+	notify(space_event_fd_, header_->writer_waiting);
+}
+
+int ShmChannelImpl::readinessFD() const {
+	return is_writer_ == true ? -1 : data_event_fd_;
+}
+
+bool ShmChannelImpl::armReadiness() {
+	if (header_ == nullptr || is_writer_ == true) {
+		return true;
+	}
+	// signals left over from frames already read would report the fd readable for nothing
+	uint64_t counter = 0;
+	[[maybe_unused]] ssize_t drained = ::read(data_event_fd_, &counter, sizeof(counter));
+	// same handshake as waitFor(): either the writer sees the flag or we see its new position
+	header_->reader_waiting.store(1);
+	const uint64_t read_pos = header_->read_pos.load() + pending_release_;
+	return header_->write_pos.load() != read_pos || header_->closed.load() != 0 || peer_gone_;
+}
+
+void ShmChannelImpl::close() {
+	if (header_ == nullptr) {
+		return;
+	}
+	header_->closed.store(1);
+	uint64_t one = 1;
+	[[maybe_unused]] ssize_t data_written = ::write(data_event_fd_, &one, sizeof(one));
+	[[maybe_unused]] ssize_t space_written = ::write(space_event_fd_, &one, sizeof(one));
+}
+
+}  // namespace network_socket
+}  // namespace embedded
+}  // namespace arcforge
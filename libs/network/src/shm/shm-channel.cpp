@@ -0,0 +1,172 @@
+// Copyright (c) 2025 PotterWhite
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// libs/network/src/shm/shm-channel.cpp
+#include "Network/shm/shm-channel.h"
+#include "Network/shm/impl/shm-channel-impl.h"
+#include "Utils/logger/logger.h"
+
+namespace arcforge {
+namespace embedded {
+namespace network_socket {
+
+namespace {
+const std::string kshm_accept_ack = "shm-ring:ok";
+}  // namespace
+
+ShmChannel::ShmChannel(std::unique_ptr<ShmChannelImpl> param_impl)
+    : impl_(std::move(param_impl)) {}
+
+ShmChannel::~ShmChannel() {}
+
+ShmChannel::ShmChannel(ShmChannel&& other) noexcept = default;
+
+ShmChannel& ShmChannel::operator=(ShmChannel&& other) noexcept = default;
+
+SocketReturnValue ShmChannel::offer(Base& control, std::unique_ptr<ShmChannel>& channel,
+                                    size_t capacity_bytes) {
+	auto impl = std::make_unique<ShmChannelImpl>(true, control.getFD());
+	SocketReturnValue retval = impl->create(capacity_bytes);
+	if (retval != SocketReturnValue::ksuccess) {
+		return retval;
+	}
+
+	retval = control.sendFDs(impl->passableFDs());
+	if (retval != SocketReturnValue::ksuccess) {
+		return retval;
+	}
+
+	// the ring is only usable once the peer has mapped it
+	std::string ack;
+	retval = control.receiveString(ack);
+	if (retval != SocketReturnValue::ksuccess) {
+		return retval;
+	}
+	if (ack != kshm_accept_ack) {
+		arcforge::embedded::utils::Logger::GetInstance().Error(
+		    "ShmChannel::offer: peer refused the ring: " + ack, kcurrent_lib_name);
+		return SocketReturnValue::kreceived_illegal;
+	}
+
+	channel.reset(new ShmChannel(std::move(impl)));
+	return SocketReturnValue::ksuccess;
+}
+
+SocketReturnValue ShmChannel::accept(Base& control, std::unique_ptr<ShmChannel>& channel) {
+	std::vector<int> fds;
+	SocketReturnValue retval = control.receiveFDs(fds);
+	if (retval != SocketReturnValue::ksuccess) {
+		return retval;
+	}
+
+	auto impl = std::make_unique<ShmChannelImpl>(false, control.getFD());
+	retval = impl->attach(fds);
+	if (retval != SocketReturnValue::ksuccess) {
+		control.sendString("shm-ring:refused");
+		return retval;
+	}
+
+	retval = control.sendString(kshm_accept_ack);
+	if (retval != SocketReturnValue::ksuccess) {
+		return retval;
+	}
+
+	channel.reset(new ShmChannel(std::move(impl)));
+	return SocketReturnValue::ksuccess;
+}
+
+SocketReturnValue ShmChannel::sendFloat(const float* data, size_t count) {
+	if (impl_) {
+		return impl_->sendFloat(data, count);
+	}
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+SocketReturnValue ShmChannel::sendFloat(const std::vector<float>& data) {
+	return sendFloat(data.data(), data.size());
+}
+
+SocketReturnValue ShmChannel::receiveFloat(std::vector<float>& data) {
+	const float* samples = nullptr;
+	size_t count = 0;
+	SocketReturnValue retval = peekFloat(samples, count);
+	if (retval != SocketReturnValue::ksuccess) {
+		data.clear();
+		return retval;
+	}
+	data.assign(samples, samples + count);
+	releaseFloat();
+	return retval;
+}
+
+SocketReturnValue ShmChannel::receiveFloat(AudioBuffer& buffer) {
+	const float* samples = nullptr;
+	size_t count = 0;
+	SocketReturnValue retval = peekFloat(samples, count);
+	if (retval != SocketReturnValue::ksuccess) {
+		buffer.clear();
+		return retval;
+	}
+	buffer.resize(count);
+	memcpy(buffer.data(), samples, count * sizeof(float));
+	releaseFloat();
+	return retval;
+}
+
+SocketReturnValue ShmChannel::peekFloat(const float*& samples, size_t& count) {
+	if (impl_) {
+		return impl_->peekFloat(samples, count);
+	}
+	samples = nullptr;
+	count = 0;
+	return SocketReturnValue::kimpl_nullptr_error;
+}
+
+void ShmChannel::releaseFloat() {
+	if (impl_) {
+		impl_->releaseFloat();
+	}
+}
+
+int ShmChannel::getReadinessFD() const {
+	if (impl_) {
+		return impl_->readinessFD();
+	}
+	return -1;
+}
+
+bool ShmChannel::armReadiness() {
+	if (impl_) {
+		return impl_->armReadiness();
+	}
+	// nothing to wait for, the read reports the error
+	return true;
+}
+
+void ShmChannel::close() {
+	if (impl_) {
+		impl_->close();
+	}
+}
+
+}  // namespace network_socket
+}  // namespace embedded
+}  // namespace arcforge
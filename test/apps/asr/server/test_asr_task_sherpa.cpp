@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2025 PotterWhite
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_asr_task_sherpa.cpp
+ * @brief Session tests for the ASR server's ASRTaskSherpa.
+ * @details A session is driven step by step over a socketpair, the way the acceptor drives it
+ *          from the event loop. Needs the recognizer model; skipped where it is not installed.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include <poll.h>
+#include <sys/socket.h>
+
+#include "asr-task-sherpa.h"
+
+namespace ns = arcforge::embedded::network_socket;
+
+// -----------------------------------------------------------------------------
+// I. Helpers
+// -----------------------------------------------------------------------------
+namespace {
+
+// 100 ms chunks at the default rate, as a pushed client sends them
+constexpr size_t kCHUNK_SAMPLES = 1600;
+constexpr int kCHUNKS_PER_UTTERANCE = 3;
+constexpr std::chrono::seconds kRESULT_DEADLINE{5};
+
+// audio, the end-of-utterance marker, then results up to the end-of-utterance final
+bool SendUtterance(ns::Base& client) {
+    const std::vector<float> chunk(kCHUNK_SAMPLES, 0.01f);
+    for (int i = 0; i < kCHUNKS_PER_UTTERANCE; ++i) {
+        if (client.sendFloat(chunk) != ns::SocketReturnValue::ksuccess) {
+            return false;
+        }
+    }
+    if (client.sendFloat(std::vector<float>()) != ns::SocketReturnValue::ksuccess) {
+        return false;
+    }
+    ns::ResultMessage result;
+    do {
+        if (client.receiveResult(result, std::chrono::steady_clock::now() + kRESULT_DEADLINE) !=
+            ns::SocketReturnValue::ksuccess) {
+            return false;
+        }
+    } while (result.kind != ns::ResultKind::kend_of_utterance);
+    return true;
+}
+
+// one step whenever input is ready or the quota lets the session go on, as the acceptor
+// does; records how long the longest step held its thread and how often one was throttled
+void RunSteps(ASRTaskSherpa& task, std::chrono::steady_clock::duration& longest_step,
+              int& throttled_steps) {
+    while (task.isCompleted() == false) {
+        const auto resume_at = task.resumeAt();
+        if (resume_at != std::chrono::steady_clock::time_point()) {
+            ++throttled_steps;
+            std::this_thread::sleep_until(resume_at);
+        } else if (task.hasBufferedInput() == false) {
+            struct pollfd input = {task.inputFD(), POLLIN, 0};
+            ::poll(&input, 1, 50);
+        }
+        const auto begin = std::chrono::steady_clock::now();
+        task.step();
+        longest_step = std::max(longest_step, std::chrono::steady_clock::now() - begin);
+    }
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+// II. Test Cases
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Utterances On One Pushed Session
+ * @details A pushed-results session stays open after the end-of-utterance final: a second
+ *          utterance on the same connection is decoded and answered like the first, and the
+ *          session ends once the client hangs up.
+ */
+TEST(ASRTaskSherpaTest, PushedSessionServesSeveralUtterances) {
+    auto model = ASRTaskSherpa::LoadModel();
+    if (model == nullptr) {
+        GTEST_SKIP() << "recognizer model not installed";
+    }
+
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    ns::Base client;
+    client.setFD(fds[0]);
+    auto server = std::make_unique<ns::Base>();
+    server->setFD(fds[1]);
+    auto task = ASRTaskSherpa::Create(std::move(server), model);
+
+    std::chrono::steady_clock::duration longest_step{0};
+    int throttled_steps = 0;
+    std::thread steps([&]() { RunSteps(*task, longest_step, throttled_steps); });
+
+    ns::StreamParams requested;
+    requested.push_results = true;
+    ns::SessionGrant granted;
+    EXPECT_EQ(client.handshake(requested, granted), ns::SocketReturnValue::ksuccess);
+    EXPECT_TRUE(granted.params.push_results);
+    EXPECT_TRUE(SendUtterance(client));
+    EXPECT_TRUE(SendUtterance(client));
+
+    client.closeSocket();
+    const auto give_up = std::chrono::steady_clock::now() + kRESULT_DEADLINE;
+    while (task->isCompleted() == false && std::chrono::steady_clock::now() < give_up) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_TRUE(task->isCompleted());
+
+    task->stop_me();
+    steps.join();
+}
+
+/**
+ * @brief Throttled Session Yields Its Worker
+ * @details A client over its decode rate quota does not hold the thread its session steps on:
+ *          the step ends with a resume time instead of sleeping for the refill, and the
+ *          utterance is still answered in full once the quota allows it.
+ */
+TEST(ASRTaskSherpaTest, ThrottledStepReturnsInsteadOfWaiting) {
+    auto model = ASRTaskSherpa::LoadModel();
+    if (model == nullptr) {
+        GTEST_SKIP() << "recognizer model not installed";
+    }
+
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    ns::Base client;
+    client.setFD(fds[0]);
+    auto server = std::make_unique<ns::Base>();
+    server->setFD(fds[1]);
+    auto task = ASRTaskSherpa::Create(std::move(server), model);
+    // a quarter audio second per second and a burst of one chunk: every further 100 ms
+    // chunk has to wait 400 ms for its tokens
+    task->setScheduler(std::make_shared<DecodeScheduler>(1, 0.25, 0.1), ClientKey{1});
+
+    std::chrono::steady_clock::duration longest_step{0};
+    int throttled_steps = 0;
+    std::thread steps([&]() { RunSteps(*task, longest_step, throttled_steps); });
+
+    ns::StreamParams requested;
+    requested.push_results = true;
+    ns::SessionGrant granted;
+    EXPECT_EQ(client.handshake(requested, granted), ns::SocketReturnValue::ksuccess);
+    EXPECT_TRUE(SendUtterance(client));
+
+    client.closeSocket();
+    const auto give_up = std::chrono::steady_clock::now() + kRESULT_DEADLINE;
+    while (task->isCompleted() == false && std::chrono::steady_clock::now() < give_up) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_TRUE(task->isCompleted());
+
+    task->stop_me();
+    steps.join();
+    EXPECT_GT(throttled_steps, 0);
+    EXPECT_LT(longest_step, std::chrono::milliseconds(200));
+}
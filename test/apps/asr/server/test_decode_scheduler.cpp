@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2025 PotterWhite
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file test_decode_scheduler.cpp
+ * @brief Unit tests for the ASR server's DecodeScheduler.
+ * @details Checks that decode slots are shared between clients rather than between sessions.
+ */
+
+#include <gtest/gtest.h>
+
+#include "decode-scheduler.h"
+
+// -----------------------------------------------------------------------------
+// I. Helpers
+// -----------------------------------------------------------------------------
+namespace {
+
+// two local client processes of the same uid, keyed the way Acceptor::identifyClient() does
+constexpr ClientKey kBATCH_CLIENT = (ClientKey{100} << 32) | 1000;
+constexpr ClientKey kINTERACTIVE_CLIENT = (ClientKey{200} << 32) | 1000;
+// a rate quota that never throttles, so only the fair share decides
+constexpr double kUNLIMITED_SECONDS = 1000.0;
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+// II. Test Cases
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Fair Share Order
+ * @details With the only slot taken and three sessions of a batch client queued ahead of it,
+ *          the single session of a client that has not been served yet gets the slot next.
+ */
+TEST(DecodeSchedulerTest, ServesLeastServedClientFirst) {
+    DecodeScheduler scheduler(1, kUNLIMITED_SECONDS, kUNLIMITED_SECONDS);
+    std::atomic<bool> stop{false};
+    ASSERT_TRUE(scheduler.acquire(kBATCH_CLIENT, 1.0, stop));
+
+    std::mutex order_mutex;
+    std::vector<ClientKey> order;
+    auto session = [&](ClientKey client) {
+        if (scheduler.acquire(client, 1.0, stop) == true) {
+            {
+                std::lock_guard<std::mutex> lock(order_mutex);
+                order.push_back(client);
+            }
+            scheduler.release(client, 1.0, std::chrono::milliseconds(1));
+        }
+    };
+    std::vector<std::thread> sessions;
+    for (int i = 0; i < 3; ++i) {
+        sessions.emplace_back(session, kBATCH_CLIENT);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    sessions.emplace_back(session, kINTERACTIVE_CLIENT);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    scheduler.release(kBATCH_CLIENT, 1.0, std::chrono::milliseconds(1));
+    for (std::thread& thread : sessions) {
+        thread.join();
+    }
+    ASSERT_EQ(order.size(), 4u);
+    EXPECT_EQ(order.front(), kINTERACTIVE_CLIENT);
+}
+
+/**
+ * @brief No Starvation
+ * @details A client decoding from four sessions back to back and a client with one session
+ *          share a single slot; the single session gets about half of the decodes instead of
+ *          a fifth.
+ */
+TEST(DecodeSchedulerTest, ManySessionClientCannotStarveSingleSession) {
+    DecodeScheduler scheduler(1, kUNLIMITED_SECONDS, kUNLIMITED_SECONDS);
+    std::atomic<bool> stop{false};
+    std::atomic<size_t> batch_decodes{0};
+    std::atomic<size_t> interactive_decodes{0};
+    auto session = [&](ClientKey client, std::atomic<size_t>& decodes) {
+        while (scheduler.acquire(client, 0.1, stop) == true) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            scheduler.release(client, 0.1, std::chrono::milliseconds(1));
+            ++decodes;
+        }
+    };
+    std::vector<std::thread> sessions;
+    for (int i = 0; i < 4; ++i) {
+        sessions.emplace_back(session, kBATCH_CLIENT, std::ref(batch_decodes));
+    }
+    sessions.emplace_back(session, kINTERACTIVE_CLIENT, std::ref(interactive_decodes));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    stop = true;
+    scheduler.interrupt();
+    for (std::thread& thread : sessions) {
+        thread.join();
+    }
+    ASSERT_GT(batch_decodes.load(), 0u);
+    EXPECT_GE(interactive_decodes.load() * 3, batch_decodes.load());
+}
+
+/**
+ * @brief Client Turnover
+ * @details A thousand short-lived clients, keyed like TCP connections, come and go while one
+ *          client keeps decoding; once their sessions have ended only the one still decoding
+ *          is accounted for, and forgetting it while it holds a slot is refused.
+ */
+TEST(DecodeSchedulerTest, ForgetsClientsWhoseSessionsEnded) {
+    DecodeScheduler scheduler(2, kUNLIMITED_SECONDS, kUNLIMITED_SECONDS);
+    std::atomic<bool> stop{false};
+    ASSERT_TRUE(scheduler.acquire(kBATCH_CLIENT, 1.0, stop));
+
+    for (ClientKey i = 0; i < 1000; ++i) {
+        const ClientKey client = kREMOTE_CLIENT_KEY_BIT | i;
+        ASSERT_TRUE(scheduler.acquire(client, 0.1, stop));
+        scheduler.release(client, 0.1, std::chrono::milliseconds(1));
+        scheduler.removeClient(client);
+    }
+    EXPECT_EQ(scheduler.clientCount(), 1u);
+
+    scheduler.removeClient(kBATCH_CLIENT);
+    EXPECT_EQ(scheduler.clientCount(), 1u);
+    scheduler.release(kBATCH_CLIENT, 1.0, std::chrono::milliseconds(1));
+    scheduler.removeClient(kBATCH_CLIENT);
+    EXPECT_EQ(scheduler.clientCount(), 0u);
+}
+
+/**
+ * @brief Quota Without Blocking
+ * @details A client that has used its burst is told how long to hold off instead of being made
+ *          to wait: quotaDelay() reports the refill time and acquire() still returns at once,
+ *          running the bucket into debt; a client within its quota gets no delay.
+ */
+TEST(DecodeSchedulerTest, QuotaDelayReplacesWaitingForTokens) {
+    // half an audio second per second, a burst of one second
+    DecodeScheduler scheduler(1, 0.5, 1.0);
+    std::atomic<bool> stop{false};
+    EXPECT_EQ(scheduler.quotaDelay(kBATCH_CLIENT, 1.0),
+              std::chrono::steady_clock::duration::zero());
+
+    ASSERT_TRUE(scheduler.acquire(kBATCH_CLIENT, 1.0, stop));
+    scheduler.release(kBATCH_CLIENT, 1.0, std::chrono::milliseconds(1));
+    const auto delay = scheduler.quotaDelay(kBATCH_CLIENT, 1.0);
+    EXPECT_GT(delay, std::chrono::milliseconds(1500));
+    EXPECT_LE(delay, std::chrono::milliseconds(2001));
+    EXPECT_EQ(scheduler.quotaDelay(kINTERACTIVE_CLIENT, 1.0),
+              std::chrono::steady_clock::duration::zero());
+
+    const auto begin = std::chrono::steady_clock::now();
+    ASSERT_TRUE(scheduler.acquire(kBATCH_CLIENT, 1.0, stop));
+    EXPECT_LT(std::chrono::steady_clock::now() - begin, std::chrono::milliseconds(100));
+    scheduler.release(kBATCH_CLIENT, 1.0, std::chrono::milliseconds(1));
+    EXPECT_GT(scheduler.quotaDelay(kBATCH_CLIENT, 1.0), delay);
+}
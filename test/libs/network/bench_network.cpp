@@ -0,0 +1,432 @@
+/*
+ * Copyright (c) 2025 PotterWhite
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file bench_network.cpp
+ * @brief Throughput comparison of the Network module's framing modes and transports.
+ * @details Not a pass/fail benchmark: the timings are printed for comparison and only the
+ *          correctness of every round trip is asserted, so the case stays stable on loaded
+ *          CI machines.
+ */
+
+#include <gtest/gtest.h>
+
+#include <Network/base/base.h>
+#include <Network/client/client-pool.h>
+#include <Network/client/client.h>
+#include <Network/server/server.h>
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+namespace ns = arcforge::embedded::network_socket;
+
+namespace {
+
+/**
+ * @brief Streams audio chunks one way and result strings back, like one ASR session.
+ * @return average microseconds per chunk + result round trip
+ */
+double RunRoundTrips(ns::Base& client, ns::Base& server, size_t chunk_samples, int rounds) {
+    const std::vector<float> chunk(chunk_samples, 0.125f);
+    const std::string result = "partial result of a typical length";
+
+    std::thread peer([&]() {
+        ns::AudioBuffer samples;
+        for (int i = 0; i < rounds; ++i) {
+            if (server.receiveFloat(samples) != ns::SocketReturnValue::ksuccess ||
+                samples.size() != chunk.size()) {
+                ADD_FAILURE() << "chunk " << i << " arrived damaged";
+                return;
+            }
+            server.sendString(result);
+        }
+    });
+
+    const auto begin = std::chrono::steady_clock::now();
+    std::string reply;
+    for (int i = 0; i < rounds; ++i) {
+        EXPECT_EQ(client.sendFloat(chunk), ns::SocketReturnValue::ksuccess);
+        EXPECT_EQ(client.receiveString(reply), ns::SocketReturnValue::ksuccess);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - begin;
+    peer.join();
+    EXPECT_EQ(reply, result);
+
+    return std::chrono::duration<double, std::micro>(elapsed).count() / rounds;
+}
+
+// 800 ms of 16 kHz audio, the chunk size the sherpa client sends
+constexpr size_t kclient_chunk_samples = 12800;
+
+double MeasureRoundTrips(int socket_type, ns::SocketType framing, int rounds) {
+    int fds[2];
+    if (::socketpair(AF_UNIX, socket_type, 0, fds) != 0) {
+        ADD_FAILURE() << "socketpair() failed";
+        return 0.0;
+    }
+
+    ns::Base client;
+    ns::Base server;
+    client.setFD(fds[0]);
+    server.setFD(fds[1]);
+    client.setSocketType(framing);
+    server.setSocketType(framing);
+
+    return RunRoundTrips(client, server, kclient_chunk_samples, rounds);
+}
+
+/**
+ * @brief Same session over a listening socket: the Unix socket path or TCP on 127.0.0.1.
+ */
+double MeasureListenerRoundTrips(bool tcp, size_t chunk_samples, int rounds) {
+    ns::ServerBase listener;
+    if (tcp == true) {
+        listener.setTcpEndpoint("127.0.0.1", 0);
+    } else {
+        listener.setSocketPath("/tmp/arcforge_bench_" + std::to_string(getpid()) + ".sock");
+    }
+    if (listener.startServer() != ns::SocketReturnValue::ksuccess) {
+        ADD_FAILURE() << "startServer() failed";
+        return 0.0;
+    }
+
+    ns::ClientBase client;
+    if (tcp == true) {
+        client.setTcpEndpoint("127.0.0.1", listener.getLocalPort());
+    } else {
+        client.setSocketPath(listener.getSocketPath());
+    }
+    if (client.connectToServer() != ns::SocketReturnValue::ksuccess) {
+        ADD_FAILURE() << "connectToServer() failed";
+        return 0.0;
+    }
+    ns::SocketAcceptReturn accepted = listener.acceptClient();
+    if (accepted.client == nullptr) {
+        ADD_FAILURE() << "acceptClient() failed";
+        return 0.0;
+    }
+
+    return RunRoundTrips(client, *accepted.client, chunk_samples, rounds);
+}
+
+/**
+ * @brief Short requests over TCP loopback: one chunk, its result and EOF per request, each on
+ *        a fresh connection + handshake or on a connection leased from a warm ClientPool.
+ * @return average microseconds per request
+ */
+double MeasureShortRequests(bool pooled, int requests) {
+    ns::ServerBase listener;
+    listener.setTcpEndpoint("127.0.0.1", 0);
+    if (listener.startServer() != ns::SocketReturnValue::ksuccess) {
+        ADD_FAILURE() << "startServer() failed";
+        return 0.0;
+    }
+
+    // a cold client opens one connection per request, the pool a single one for all of them
+    const int connections = pooled == true ? 1 : requests;
+    std::thread peer([&]() {
+        ns::AudioBuffer samples;
+        for (int i = 0; i < connections; ++i) {
+            ns::SocketAcceptReturn accepted = listener.acceptClient();
+            if (accepted.client == nullptr) {
+                ADD_FAILURE() << "acceptClient() failed";
+                return;
+            }
+            // served until the client hangs up
+            while (true) {
+                const ns::SocketReturnValue retval = accepted.client->receiveFloat(samples);
+                if (retval == ns::SocketReturnValue::kreceived_hello) {
+                    ns::SessionGrant grant;
+                    accepted.client->takeHello(grant.params);
+                    accepted.client->answerHello(grant);
+                } else if (retval == ns::SocketReturnValue::ksuccess) {
+                    accepted.client->sendString("short result");
+                } else if (retval != ns::SocketReturnValue::keof) {
+                    break;
+                }
+            }
+        }
+    });
+
+    ns::ClientPoolConfig config;
+    config.tcp_host = "127.0.0.1";
+    config.tcp_port = listener.getLocalPort();
+    config.size = 1;
+    auto pool = ns::ClientPool::create(config);
+    if (pooled == true) {
+        EXPECT_EQ(pool->warmUp(), ns::SocketReturnValue::ksuccess);
+    }
+
+    const std::vector<float> chunk(160, 0.125f);
+    std::string reply;
+    const auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < requests; ++i) {
+        ns::PooledClient lease;
+        std::unique_ptr<ns::ClientBase> cold;
+        ns::ClientBase* client = nullptr;
+        if (pooled == true) {
+            EXPECT_EQ(pool->acquire(lease), ns::SocketReturnValue::ksuccess);
+            client = lease.get();
+        } else {
+            cold = std::make_unique<ns::ClientBase>();
+            cold->setTcpEndpoint(config.tcp_host, config.tcp_port);
+            ns::SessionGrant granted;
+            EXPECT_EQ(cold->connectToServer(), ns::SocketReturnValue::ksuccess);
+            EXPECT_EQ(cold->handshake(config.params, granted), ns::SocketReturnValue::ksuccess);
+            client = cold.get();
+        }
+        EXPECT_EQ(client->sendFloat(chunk), ns::SocketReturnValue::ksuccess);
+        EXPECT_EQ(client->receiveString(reply), ns::SocketReturnValue::ksuccess);
+        EXPECT_EQ(client->sendFloat({}), ns::SocketReturnValue::ksuccess);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - begin;
+    pool->close();
+    peer.join();
+
+    return std::chrono::duration<double, std::micro>(elapsed).count() / requests;
+}
+
+/**
+ * @brief 100 ms chunks with results pushed per received batch instead of per chunk: the
+ *        client keeps sending while it has credits and only reads a result when it runs out.
+ * @return average microseconds per chunk
+ */
+double MeasurePushedChunks(int chunks) {
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+        ADD_FAILURE() << "socketpair() failed";
+        return 0.0;
+    }
+
+    ns::Base client;
+    ns::Base server;
+    client.setFD(fds[0]);
+    server.setFD(fds[1]);
+
+    std::thread peer([&]() {
+        std::vector<ns::AudioBuffer> received(8);
+        size_t count = 0;
+        ns::SessionGrant grant;
+        if (server.receiveFloatBatch(received, count) != ns::SocketReturnValue::kreceived_hello ||
+            server.takeHello(grant.params) != ns::SocketReturnValue::ksuccess) {
+            ADD_FAILURE() << "no hello";
+            return;
+        }
+        grant.max_inflight_chunks = 8;
+        server.answerHello(grant);
+        ns::ResultMessage result;
+        result.text = "partial result of a typical length";
+        for (int total = 0; total < chunks; total += static_cast<int>(count)) {
+            if (server.receiveFloatBatch(received, count) != ns::SocketReturnValue::ksuccess) {
+                ADD_FAILURE() << "receive failed after " << total << " chunks";
+                return;
+            }
+            result.acknowledged_chunks = static_cast<uint32_t>(count);
+            server.sendResult(result);
+        }
+    });
+
+    ns::StreamParams requested;
+    requested.push_results = true;
+    ns::SessionGrant granted;
+    EXPECT_EQ(client.handshake(requested, granted), ns::SocketReturnValue::ksuccess);
+
+    const std::vector<float> chunk(1600, 0.125f);
+    ns::ResultMessage result;
+    uint32_t acknowledged = 0;
+    const auto begin = std::chrono::steady_clock::now();
+    for (int sent = 0; sent < chunks; ++sent) {
+        while (client.getSendCredits() == 0) {
+            EXPECT_EQ(client.receiveResult(result), ns::SocketReturnValue::ksuccess);
+            acknowledged += result.acknowledged_chunks;
+        }
+        EXPECT_EQ(client.sendFloat(chunk), ns::SocketReturnValue::ksuccess);
+    }
+    while (acknowledged < static_cast<uint32_t>(chunks)) {
+        if (client.receiveResult(result) != ns::SocketReturnValue::ksuccess) {
+            ADD_FAILURE() << "result missing";
+            break;
+        }
+        acknowledged += result.acknowledged_chunks;
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - begin;
+    peer.join();
+
+    return std::chrono::duration<double, std::micro>(elapsed).count() / chunks;
+}
+
+/**
+ * @brief Pushes frames one way as fast as the peer drains them.
+ * @return average microseconds per frame
+ */
+double MeasureOneWay(int socket_type, ns::SocketType framing, bool batched, int frames) {
+    int fds[2];
+    if (::socketpair(AF_UNIX, socket_type, 0, fds) != 0) {
+        ADD_FAILURE() << "socketpair() failed";
+        return 0.0;
+    }
+
+    ns::Base sender;
+    ns::Base receiver;
+    sender.setFD(fds[0]);
+    receiver.setFD(fds[1]);
+    sender.setSocketType(framing);
+    receiver.setSocketType(framing);
+
+    // 10 ms chunks, the case where per-frame syscalls dominate
+    constexpr size_t kbatch = 16;
+    const std::vector<std::vector<float>> batch(kbatch, std::vector<float>(160, 0.125f));
+
+    std::thread peer([&]() {
+        std::vector<ns::AudioBuffer> received(batched ? kbatch : 1);
+        int total = 0;
+        while (total < frames) {
+            size_t count = 0;
+            ns::SocketReturnValue retval = batched
+                                               ? receiver.receiveFloatBatch(received, count)
+                                               : receiver.receiveFloat(received[0]);
+            if (retval != ns::SocketReturnValue::ksuccess) {
+                ADD_FAILURE() << "receive failed after " << total << " frames";
+                return;
+            }
+            total += batched ? static_cast<int>(count) : 1;
+        }
+    });
+
+    const auto begin = std::chrono::steady_clock::now();
+    for (int sent = 0; sent < frames; sent += static_cast<int>(kbatch)) {
+        if (batched) {
+            size_t frames_sent = 0;
+            EXPECT_EQ(sender.sendFloatBatch(batch, frames_sent), ns::SocketReturnValue::ksuccess);
+        } else {
+            for (const auto& frame : batch) {
+                EXPECT_EQ(sender.sendFloat(frame), ns::SocketReturnValue::ksuccess);
+            }
+        }
+    }
+    peer.join();
+    const auto elapsed = std::chrono::steady_clock::now() - begin;
+
+    return std::chrono::duration<double, std::micro>(elapsed).count() / frames;
+}
+
+}  // namespace
+
+/**
+ * @brief Stream vs Seqpacket Framing
+ * @details Same payloads over SOCK_STREAM with length-prefix reassembly and over
+ *          SOCK_SEQPACKET with one message per frame.
+ */
+TEST(NetworkBenchmarkTest, SeqpacketVsStreamFraming) {
+    constexpr int krounds = 2000;
+
+    const double stream_us = MeasureRoundTrips(SOCK_STREAM, ns::SocketType::kstream, krounds);
+    const double packet_us =
+        MeasureRoundTrips(SOCK_SEQPACKET, ns::SocketType::kseqpacket, krounds);
+
+    std::printf("[ bench    ] stream    : %8.2f us / round trip\n", stream_us);
+    std::printf("[ bench    ] seqpacket : %8.2f us / round trip\n", packet_us);
+    SUCCEED();
+}
+
+/**
+ * @brief TCP Loopback vs Unix Socket
+ * @details Small 10 ms chunks show the per-frame latency a remote client pays on top of the
+ *          local socket, the 800 ms chunks of the sherpa client its throughput.
+ */
+TEST(NetworkBenchmarkTest, TcpLoopbackVsUnixStream) {
+    constexpr int krounds = 2000;
+    constexpr size_t ksmall_chunk_samples = 160;
+
+    const double unix_small_us = MeasureListenerRoundTrips(false, ksmall_chunk_samples, krounds);
+    const double tcp_small_us = MeasureListenerRoundTrips(true, ksmall_chunk_samples, krounds);
+    const double unix_large_us = MeasureListenerRoundTrips(false, kclient_chunk_samples, krounds);
+    const double tcp_large_us = MeasureListenerRoundTrips(true, kclient_chunk_samples, krounds);
+
+    std::printf("[ bench    ] unix   10 ms : %8.2f us / round trip\n", unix_small_us);
+    std::printf("[ bench    ] tcp    10 ms : %8.2f us / round trip\n", tcp_small_us);
+    std::printf("[ bench    ] unix  800 ms : %8.2f us / round trip\n", unix_large_us);
+    std::printf("[ bench    ] tcp   800 ms : %8.2f us / round trip\n", tcp_large_us);
+    SUCCEED();
+}
+
+/**
+ * @brief Batched vs Single Frames
+ * @details A backlog of small frames pushed and drained one per call, then 16 per call.
+ */
+TEST(NetworkBenchmarkTest, BatchedVsSingleFrames) {
+    constexpr int kframes = 32000;
+
+    const double stream_single =
+        MeasureOneWay(SOCK_STREAM, ns::SocketType::kstream, false, kframes);
+    const double stream_batch = MeasureOneWay(SOCK_STREAM, ns::SocketType::kstream, true, kframes);
+    const double packet_single =
+        MeasureOneWay(SOCK_SEQPACKET, ns::SocketType::kseqpacket, false, kframes);
+    const double packet_batch =
+        MeasureOneWay(SOCK_SEQPACKET, ns::SocketType::kseqpacket, true, kframes);
+
+    std::printf("[ bench    ] stream    single : %8.2f us / frame\n", stream_single);
+    std::printf("[ bench    ] stream    batch  : %8.2f us / frame\n", stream_batch);
+    std::printf("[ bench    ] seqpacket single : %8.2f us / frame\n", packet_single);
+    std::printf("[ bench    ] seqpacket batch  : %8.2f us / frame\n", packet_batch);
+    SUCCEED();
+}
+
+/**
+ * @brief Pooled vs Cold Connections
+ * @details Many short requests, each paying socket(), connect() and the hello, against the
+ *          same requests on a pre-connected, pre-handshaken connection.
+ */
+TEST(NetworkBenchmarkTest, PooledVsColdConnections) {
+    constexpr int krequests = 500;
+
+    const double cold_us = MeasureShortRequests(false, krequests);
+    const double pooled_us = MeasureShortRequests(true, krequests);
+
+    std::printf("[ bench    ] cold   : %8.2f us / request\n", cold_us);
+    std::printf("[ bench    ] pooled : %8.2f us / request\n", pooled_us);
+    SUCCEED();
+}
+
+/**
+ * @brief Lockstep vs Pushed Results
+ * @details 100 ms chunks answered one by one against the same chunks with the result
+ *          channel decoupled from the audio path.
+ */
+TEST(NetworkBenchmarkTest, LockstepVsPushedResults) {
+    constexpr int kchunks = 4000;
+
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    ns::Base client;
+    ns::Base server;
+    client.setFD(fds[0]);
+    server.setFD(fds[1]);
+    const double lockstep_us = RunRoundTrips(client, server, 1600, kchunks);
+    const double pushed_us = MeasurePushedChunks(kchunks);
+
+    std::printf("[ bench    ] lockstep : %8.2f us / chunk\n", lockstep_us);
+    std::printf("[ bench    ] pushed   : %8.2f us / chunk\n", pushed_us);
+    SUCCEED();
+}
@@ -35,6 +35,18 @@
 // -----------------------------------------------------------------------------
 // Based on your tree structure: libs/network/include/Network/base/base.h
 #include <Network/base/base.h>
+#include <Network/client/client-pool.h>
+#include <Network/client/client.h>
+#include <Network/common/sample-codec.h>
+#include <Network/event/event-loop.h>
+#include <Network/server/server.h>
+#include <Network/shm/shm-channel.h>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+#include <atomic>
+#include <thread>
 
 // -----------------------------------------------------------------------------
 // II. Test Cases
@@ -70,4 +82,1436 @@ TEST(NetworkModuleTest, LibraryLinkage) {
     FAIL() << "PROJECT_NAME macro is missing.";
 #endif
 
-}
\ No newline at end of file
+}
+
+// -----------------------------------------------------------------------------
+// III. Helpers
+// -----------------------------------------------------------------------------
+namespace ns = arcforge::embedded::network_socket;
+
+namespace {
+
+/**
+ * @brief Per-process unique socket path, so parallel ctest runs do not collide.
+ */
+std::string MakeTestSocketPath(const std::string& tag) {
+    return "/tmp/arcforge_test_" + tag + "_" + std::to_string(getpid()) + ".sock";
+}
+
+}  // namespace
+
+// -----------------------------------------------------------------------------
+// IV. Event-driven Server
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Event Mode Accept
+ * @details Several clients connect while the server thread sits in ServerBase::run();
+ *          every one of them must be handed to the accept handler, and stop() must
+ *          return the loop without any accept timeout configured.
+ */
+TEST(NetworkEventLoopTest, ServerRunAcceptsAllPendingClients) {
+    ns::ServerBase server;
+    server.setSocketPath(MakeTestSocketPath("event"));
+    ASSERT_EQ(server.startServer(), ns::SocketReturnValue::ksuccess);
+
+    constexpr int kclient_count = 3;
+    std::atomic<int> accepted{0};
+    std::vector<std::unique_ptr<ns::Base>> sessions;
+
+    std::thread loop_thread([&]() {
+        server.run([&](std::unique_ptr<ns::Base> client) {
+            sessions.push_back(std::move(client));
+            if (++accepted == kclient_count) {
+                server.stop();
+            }
+        });
+    });
+
+    std::vector<ns::ClientBase> clients(kclient_count);
+    for (auto& client : clients) {
+        client.setSocketPath(server.getSocketPath());
+        EXPECT_EQ(client.connectToServer(), ns::SocketReturnValue::ksuccess);
+    }
+
+    loop_thread.join();
+    EXPECT_EQ(accepted.load(), kclient_count);
+    EXPECT_EQ(sessions.size(), static_cast<size_t>(kclient_count));
+}
+
+/**
+ * @brief Readiness Callback
+ * @details A client fd registered on the loop is reported readable once data arrives.
+ */
+TEST(NetworkEventLoopTest, DispatchesClientReadiness) {
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+    ns::EventLoop loop;
+    uint32_t seen_events = 0;
+    ASSERT_EQ(loop.addFD(fds[1], ns::kevent_readable,
+                         [&](uint32_t events) { seen_events = events; }),
+              ns::SocketReturnValue::ksuccess);
+
+    // nothing to read yet
+    EXPECT_EQ(loop.runOnce(0), ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(seen_events, 0u);
+
+    char byte = 'x';
+    ASSERT_EQ(::write(fds[0], &byte, 1), 1);
+    EXPECT_EQ(loop.runOnce(1000), ns::SocketReturnValue::ksuccess);
+    EXPECT_NE(seen_events & ns::kevent_readable, 0u);
+
+    EXPECT_EQ(loop.removeFD(fds[1]), ns::SocketReturnValue::ksuccess);
+    close(fds[0]);
+    close(fds[1]);
+}
+
+/**
+ * @brief Early Stop
+ * @details A stop() issued before run() (a signal during start-up) is not lost: run() returns
+ *          right away, and the request is used up, so the next run() blocks again.
+ */
+TEST(NetworkEventLoopTest, StopBeforeRunIsNotLost) {
+    ns::EventLoop loop;
+    loop.stop();
+    EXPECT_EQ(loop.run(), ns::SocketReturnValue::ksuccess);
+
+    std::atomic<bool> returned{false};
+    std::thread runner([&]() {
+        loop.run();
+        returned = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(returned.load());
+    loop.stop();
+    runner.join();
+    EXPECT_TRUE(returned.load());
+}
+
+/**
+ * @brief Read-ahead Readiness
+ * @details A receive pulls the frame queued behind it into user space, so the socket no longer
+ *          polls readable for it. hasBufferedData() says so, and a loop given it as the
+ *          pending check still reports the connection readable instead of waiting on epoll.
+ */
+TEST(NetworkEventLoopTest, ReportsFramesReadAhead) {
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    ns::Base client;
+    ns::Base server;
+    client.setFD(fds[0]);
+    server.setFD(fds[1]);
+
+    ASSERT_EQ(client.sendString("first"), ns::SocketReturnValue::ksuccess);
+    ASSERT_EQ(client.sendString("second"), ns::SocketReturnValue::ksuccess);
+    std::string text;
+    ASSERT_EQ(server.receiveString(text), ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(text, "first");
+    EXPECT_TRUE(server.hasBufferedData());
+    EXPECT_EQ(server.getReadinessFD(), fds[1]);
+
+    ns::EventLoop loop;
+    uint32_t seen_events = 0;
+    ASSERT_EQ(loop.addFD(server.getReadinessFD(), ns::kevent_readable,
+                         [&](uint32_t events) { seen_events = events; },
+                         [&]() { return server.hasBufferedData(); }),
+              ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(loop.runOnce(1000), ns::SocketReturnValue::ksuccess);
+    EXPECT_NE(seen_events & ns::kevent_readable, 0u);
+
+    ASSERT_EQ(server.receiveString(text), ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(text, "second");
+    EXPECT_FALSE(server.hasBufferedData());
+    seen_events = 0;
+    EXPECT_EQ(loop.runOnce(0), ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(seen_events, 0u);
+    EXPECT_EQ(loop.removeFD(fds[1]), ns::SocketReturnValue::ksuccess);
+}
+
+// -----------------------------------------------------------------------------
+// V. Transport Backends
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief io_uring Round Trip
+ * @details Frames larger than one provided rx buffer must arrive intact over the io_uring
+ *          backend. Where io_uring is missing the setter reports it and the same traffic
+ *          runs over the posix fallback.
+ */
+TEST(NetworkBackendTest, IoUringRoundTripOrFallback) {
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+    ns::Base sender;
+    ns::Base receiver;
+    sender.setFD(fds[0]);
+    receiver.setFD(fds[1]);
+
+    for (ns::Base* end : {&sender, &receiver}) {
+        ns::SocketReturnValue retval = end->setIoBackend(ns::IoBackend::kio_uring);
+        if (retval == ns::SocketReturnValue::ksuccess) {
+            EXPECT_EQ(end->getIoBackend(), ns::IoBackend::kio_uring);
+        } else {
+            EXPECT_EQ(retval, ns::SocketReturnValue::kio_backend_unavailable);
+            EXPECT_EQ(end->getIoBackend(), ns::IoBackend::kposix);
+        }
+    }
+
+    std::vector<float> payload(100000);
+    for (size_t i = 0; i < payload.size(); ++i) {
+        payload[i] = static_cast<float>(i) * 0.5f;
+    }
+
+    std::thread writer([&]() {
+        EXPECT_EQ(sender.sendFloat(payload), ns::SocketReturnValue::ksuccess);
+        EXPECT_EQ(sender.sendString("partial text"), ns::SocketReturnValue::ksuccess);
+        EXPECT_EQ(sender.sendFloat({}), ns::SocketReturnValue::ksuccess);
+    });
+
+    std::vector<float> received;
+    EXPECT_EQ(receiver.receiveFloat(received), ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(received, payload);
+
+    std::string text;
+    EXPECT_EQ(receiver.receiveString(text), ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(text, "partial text");
+
+    EXPECT_EQ(receiver.receiveFloat(received), ns::SocketReturnValue::keof);
+    writer.join();
+
+    sender.closeSocket();
+    EXPECT_EQ(receiver.receiveFloat(received), ns::SocketReturnValue::kpeer_abnormally_closed);
+}
+
+/**
+ * @brief Coalesced Frames
+ * @details Several frames queued before the peer reads them arrive in as few reads as the
+ *          kernel allows; bytes pulled past the end of one frame must feed the next one.
+ */
+TEST(NetworkBackendTest, BackToBackFramesSurviveCoalescedReads) {
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+    ns::Base sender;
+    ns::Base receiver;
+    sender.setFD(fds[0]);
+    receiver.setFD(fds[1]);
+
+    const std::vector<float> chunk = {0.25f, -0.5f, 1.0f};
+    ASSERT_EQ(sender.sendString("first"), ns::SocketReturnValue::ksuccess);
+    ASSERT_EQ(sender.sendFloat(chunk), ns::SocketReturnValue::ksuccess);
+    ASSERT_EQ(sender.sendString("second"), ns::SocketReturnValue::ksuccess);
+    ASSERT_EQ(sender.sendFloat({}), ns::SocketReturnValue::ksuccess);
+
+    std::string text;
+    std::vector<float> received;
+    EXPECT_EQ(receiver.receiveString(text), ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(text, "first");
+    EXPECT_EQ(receiver.receiveFloat(received), ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(received, chunk);
+    EXPECT_EQ(receiver.receiveString(text), ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(text, "second");
+    EXPECT_EQ(receiver.receiveFloat(received), ns::SocketReturnValue::keof);
+}
+
+/**
+ * @brief Reusable Receive Buffers
+ * @details AudioBuffer, caller spans and pooled buffers receive the same frames; storage is
+ *          reused across frames, and an oversized frame is dropped without desyncing.
+ */
+TEST(NetworkBackendTest, ReceiveIntoReusableBuffers) {
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+    ns::Base sender;
+    ns::Base receiver;
+    sender.setFD(fds[0]);
+    receiver.setFD(fds[1]);
+
+    const std::vector<float> big(64, 1.5f);
+    const std::vector<float> small = {2.0f, 4.0f};
+
+    // AudioBuffer: shrinking keeps the same storage
+    ns::AudioBuffer buffer;
+    ASSERT_EQ(sender.sendFloat(big), ns::SocketReturnValue::ksuccess);
+    ASSERT_EQ(receiver.receiveFloat(buffer), ns::SocketReturnValue::ksuccess);
+    ASSERT_EQ(buffer.size(), big.size());
+    const float* storage = buffer.data();
+    ASSERT_EQ(sender.sendFloat(small), ns::SocketReturnValue::ksuccess);
+    ASSERT_EQ(receiver.receiveFloat(buffer), ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(buffer.data(), storage);
+    EXPECT_EQ(std::vector<float>(buffer.data(), buffer.data() + buffer.size()), small);
+
+    // caller span: a frame larger than capacity is skipped, the next one still arrives
+    float span[4];
+    size_t count = 0;
+    ASSERT_EQ(sender.sendFloat(big), ns::SocketReturnValue::ksuccess);
+    ASSERT_EQ(sender.sendFloat(small), ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(receiver.receiveFloat(span, 4, count), ns::SocketReturnValue::kbuffer_too_small);
+    EXPECT_EQ(count, 0u);
+    EXPECT_EQ(receiver.receiveFloat(span, 4, count), ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(count, small.size());
+    EXPECT_EQ(span[1], 4.0f);
+
+    // pooled: a released buffer goes back to the connection's pool
+    {
+        ns::PooledAudioBuffer pooled;
+        ASSERT_EQ(sender.sendFloat(small), ns::SocketReturnValue::ksuccess);
+        ASSERT_EQ(receiver.receiveFloat(pooled), ns::SocketReturnValue::ksuccess);
+        ASSERT_NE(pooled, nullptr);
+        EXPECT_EQ(pooled->size(), small.size());
+    }
+    EXPECT_EQ(receiver.getBufferPool()->cachedCount(), 1u);
+}
+
+/**
+ * @brief Seqpacket Message Mode
+ * @details Every frame is one packet: floats and strings land in any of the receive
+ *          flavours, a frame that does not fit the caller is dropped whole, and the
+ *          empty frame still signals EOF.
+ */
+TEST(NetworkBackendTest, SeqpacketFramesArriveWhole) {
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds), 0);
+
+    ns::Base sender;
+    ns::Base receiver;
+    sender.setFD(fds[0]);
+    receiver.setFD(fds[1]);
+    ASSERT_EQ(sender.setSocketType(ns::SocketType::kseqpacket), ns::SocketReturnValue::ksuccess);
+    ASSERT_EQ(receiver.setSocketType(ns::SocketType::kseqpacket),
+              ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(receiver.getSocketType(), ns::SocketType::kseqpacket);
+
+    const std::vector<float> big(4096, 0.75f);
+    const std::vector<float> small = {1.0f, -1.0f};
+
+    // vector: part of the frame lands in place, the rest comes from the staging buffer
+    std::vector<float> received(small.size());
+    ASSERT_EQ(sender.sendFloat(big), ns::SocketReturnValue::ksuccess);
+    ASSERT_EQ(receiver.receiveFloat(received), ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(received, big);
+
+    ns::AudioBuffer buffer;
+    ASSERT_EQ(sender.sendFloat(small), ns::SocketReturnValue::ksuccess);
+    ASSERT_EQ(receiver.receiveFloat(buffer), ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(std::vector<float>(buffer.data(), buffer.data() + buffer.size()), small);
+
+    // caller span: the oversized packet is consumed, the next one is intact
+    float span[4];
+    size_t count = 0;
+    ASSERT_EQ(sender.sendFloat(big), ns::SocketReturnValue::ksuccess);
+    ASSERT_EQ(sender.sendFloat(small), ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(receiver.receiveFloat(span, 4, count), ns::SocketReturnValue::kbuffer_too_small);
+    EXPECT_EQ(receiver.receiveFloat(span, 4, count), ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(count, small.size());
+
+    std::string text;
+    ASSERT_EQ(sender.sendString("result"), ns::SocketReturnValue::ksuccess);
+    ASSERT_EQ(receiver.receiveString(text), ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(text, "result");
+
+    ASSERT_EQ(sender.sendFloat({}), ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(receiver.receiveFloat(received), ns::SocketReturnValue::keof);
+}
+
+/**
+ * @brief Full-duplex Connection
+ * @details A receive blocked on one thread must not stop another thread from sending on
+ *          the same connection, and closeSocket() must wake the blocked receive.
+ */
+TEST(NetworkBackendTest, SendWhileReceiveIsPending) {
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+    ns::Base local;
+    ns::Base remote;
+    local.setFD(fds[0]);
+    remote.setFD(fds[1]);
+
+    std::atomic<bool> reader_started{false};
+    ns::SocketReturnValue reader_result = ns::SocketReturnValue::kinit_state;
+    std::string reader_text;
+    std::thread reader([&]() {
+        reader_started = true;
+        reader_result = local.receiveString(reader_text);
+    });
+    while (reader_started == false) {
+        std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    // the reader holds the receive side; the send side is still free
+    ASSERT_EQ(local.sendString("ping"), ns::SocketReturnValue::ksuccess);
+    std::string text;
+    ASSERT_EQ(remote.receiveString(text), ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(text, "ping");
+    ASSERT_EQ(remote.sendString("pong"), ns::SocketReturnValue::ksuccess);
+    reader.join();
+    EXPECT_EQ(reader_result, ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(reader_text, "pong");
+
+    // closing from another thread releases a receive that would otherwise block forever
+    std::thread blocked([&]() { reader_result = local.receiveString(reader_text); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    local.closeSocket();
+    blocked.join();
+    EXPECT_NE(reader_result, ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(local.isSocketFDValid(), ns::SocketStatus::kinvalid);
+}
+
+/**
+ * @brief Deadline-aware Calls
+ * @details A timed receive on a silent peer returns kio_timeout close to its deadline and
+ *          leaves the connection usable; a frame cut in half by a deadline, on either side,
+ *          poisons that direction instead of desynchronising it.
+ */
+TEST(NetworkBackendTest, DeadlinesBoundBlockingCalls) {
+    using std::chrono::milliseconds;
+    using std::chrono::steady_clock;
+
+    for (ns::IoBackend backend : {ns::IoBackend::kposix, ns::IoBackend::kio_uring}) {
+        SCOPED_TRACE(backend == ns::IoBackend::kposix ? "posix" : "io_uring");
+        int fds[2];
+        ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+        ns::Base local;
+        ns::Base remote;
+        local.setFD(fds[0]);
+        remote.setFD(fds[1]);
+        // io_uring rx takes over after the first frame; falls back to posix where unsupported
+        local.setIoBackend(backend);
+
+        // silent peer: the call comes back on time and nothing is lost
+        std::vector<float> received;
+        const auto begin = steady_clock::now();
+        EXPECT_EQ(local.receiveFloat(received, begin + milliseconds(30)),
+                  ns::SocketReturnValue::kio_timeout);
+        const auto waited = steady_clock::now() - begin;
+        EXPECT_GE(waited, milliseconds(30));
+        EXPECT_LT(waited, milliseconds(1000));
+
+        const std::vector<float> chunk = {3.0f, 5.0f};
+        ASSERT_EQ(remote.sendFloat(chunk), ns::SocketReturnValue::ksuccess);
+        EXPECT_EQ(local.receiveFloat(received, steady_clock::now() + milliseconds(1000)),
+                  ns::SocketReturnValue::ksuccess);
+        EXPECT_EQ(received, chunk);
+
+        // a header without its body: the half-read frame must not be mistaken for the next one
+        const uint32_t orphan_count = 8;
+        ASSERT_EQ(::write(fds[1], &orphan_count, sizeof(orphan_count)),
+                  static_cast<ssize_t>(sizeof(orphan_count)));
+        EXPECT_EQ(local.receiveFloat(received, steady_clock::now() + milliseconds(30)),
+                  ns::SocketReturnValue::kio_timeout);
+        EXPECT_EQ(local.receiveFloat(received, steady_clock::now() + milliseconds(30)),
+                  ns::SocketReturnValue::kreceived_illegal);
+
+        // a reader that never drains: the send gives up midway and the tx side stays closed
+        const std::vector<float> flood(4 * 1024 * 1024, 1.0f);
+        EXPECT_EQ(remote.sendFloat(flood, steady_clock::now() + milliseconds(30)),
+                  ns::SocketReturnValue::kio_timeout);
+        EXPECT_EQ(remote.sendFloat(chunk), ns::SocketReturnValue::ksenddata_failed);
+    }
+}
+
+/**
+ * @brief Compact Sample Frames
+ * @details The client's encoding offer surfaces on the server's sample receive and is
+ *          answered there; pcm16 and mu-law frames then round-trip, a frame in the wrong
+ *          encoding is dropped without losing the next one, and the codecs are accurate.
+ */
+TEST(NetworkBackendTest, Pcm16FramesAndEncodingNegotiation) {
+    for (int type : {SOCK_STREAM, SOCK_SEQPACKET}) {
+        SCOPED_TRACE(type == SOCK_STREAM ? "stream" : "seqpacket");
+        int fds[2];
+        ASSERT_EQ(::socketpair(AF_UNIX, type, 0, fds), 0);
+
+        ns::Base client;
+        ns::Base server;
+        client.setFD(fds[0]);
+        server.setFD(fds[1]);
+        if (type == SOCK_SEQPACKET) {
+            client.setSocketType(ns::SocketType::kseqpacket);
+            server.setSocketType(ns::SocketType::kseqpacket);
+        }
+
+        ns::SampleEncoding client_side = ns::SampleEncoding::kfloat32;
+        ns::SocketReturnValue client_result = ns::SocketReturnValue::kinit_state;
+        std::thread negotiator([&]() {
+            client_result = client.negotiateSampleEncoding(ns::SampleEncoding::kpcm16, client_side);
+        });
+        std::vector<int16_t> pcm;
+        ASSERT_EQ(server.receivePcm16(pcm), ns::SocketReturnValue::kreceived_encoding_offer);
+        ns::SampleEncoding server_side = ns::SampleEncoding::kfloat32;
+        ASSERT_EQ(server.acceptSampleEncoding(server_side), ns::SocketReturnValue::ksuccess);
+        negotiator.join();
+        ASSERT_EQ(client_result, ns::SocketReturnValue::ksuccess);
+        EXPECT_EQ(client_side, ns::SampleEncoding::kpcm16);
+        EXPECT_EQ(server_side, ns::SampleEncoding::kpcm16);
+        EXPECT_EQ(server.getSampleEncoding(), ns::SampleEncoding::kpcm16);
+
+        const std::vector<int16_t> chunk = {0, 1, -1, 32767, -32768, 1234};
+        ASSERT_EQ(client.sendPcm16(chunk), ns::SocketReturnValue::ksuccess);
+        ASSERT_EQ(server.receivePcm16(pcm), ns::SocketReturnValue::ksuccess);
+        EXPECT_EQ(pcm, chunk);
+
+        // a float frame where pcm16 was agreed is dropped, the stream stays in sync
+        ASSERT_EQ(client.sendFloat({0.5f, 0.25f}), ns::SocketReturnValue::ksuccess);
+        ASSERT_EQ(client.sendPcm16(chunk), ns::SocketReturnValue::ksuccess);
+        EXPECT_EQ(server.receivePcm16(pcm), ns::SocketReturnValue::ksample_encoding_mismatch);
+        ASSERT_EQ(server.receivePcm16(pcm), ns::SocketReturnValue::ksuccess);
+        EXPECT_EQ(pcm, chunk);
+
+        const std::vector<uint8_t> law = {0x00, 0x7f, 0x80, 0xff};
+        std::vector<uint8_t> law_received;
+        ASSERT_EQ(client.sendMulaw(law), ns::SocketReturnValue::ksuccess);
+        ASSERT_EQ(server.receiveMulaw(law_received), ns::SocketReturnValue::ksuccess);
+        EXPECT_EQ(law_received, law);
+
+        // the empty frame is EOF in every encoding
+        ASSERT_EQ(client.sendFloat(std::vector<float>()), ns::SocketReturnValue::ksuccess);
+        EXPECT_EQ(server.receivePcm16(pcm), ns::SocketReturnValue::keof);
+    }
+
+    // vector body plus scalar tail: an odd length covers both
+    std::vector<int16_t> pcm(1001);
+    for (size_t i = 0; i < pcm.size(); ++i) {
+        pcm[i] = static_cast<int16_t>(static_cast<int>(i * 131) - 32768);
+    }
+    std::vector<float> widened(pcm.size());
+    ns::ConvertPcm16ToFloat(pcm.data(), widened.data(), pcm.size());
+    std::vector<int16_t> narrowed(pcm.size());
+    ns::ConvertFloatToPcm16(widened.data(), narrowed.data(), widened.size());
+    EXPECT_EQ(narrowed, pcm);
+    EXPECT_FLOAT_EQ(widened[0], -1.0f);
+
+    std::vector<uint8_t> law(widened.size());
+    ns::ConvertFloatToMulaw(widened.data(), law.data(), widened.size());
+    std::vector<float> expanded(law.size());
+    ns::ConvertMulawToFloat(law.data(), expanded.data(), law.size());
+    for (size_t i = 0; i < expanded.size(); ++i) {
+        // mu-law keeps roughly 3% relative precision, plus a small step near zero
+        EXPECT_NEAR(expanded[i], widened[i], 0.04f * std::fabs(widened[i]) + 0.002f);
+    }
+}
+
+/**
+ * @brief Session Handshake
+ * @details The hello surfaces on the server's sample receive, the grant reaches the client
+ *          and sets the connection's encoding; a hello from a newer client with words this
+ *          side does not know is still understood.
+ */
+TEST(NetworkBackendTest, SessionHandshakeNegotiatesParameters) {
+    for (int type : {SOCK_STREAM, SOCK_SEQPACKET}) {
+        SCOPED_TRACE(type == SOCK_STREAM ? "stream" : "seqpacket");
+        int fds[2];
+        ASSERT_EQ(::socketpair(AF_UNIX, type, 0, fds), 0);
+
+        ns::Base client;
+        ns::Base server;
+        client.setFD(fds[0]);
+        server.setFD(fds[1]);
+        if (type == SOCK_SEQPACKET) {
+            client.setSocketType(ns::SocketType::kseqpacket);
+            server.setSocketType(ns::SocketType::kseqpacket);
+        }
+
+        ns::StreamParams requested;
+        requested.sample_rate = 8000;
+        requested.encoding = ns::SampleEncoding::kpcm16;
+        requested.chunk_duration_ms = 40;
+        requested.pipelined_results = true;
+        requested.max_streams = 4;
+        ns::SessionGrant granted;
+        ns::SocketReturnValue client_result = ns::SocketReturnValue::kinit_state;
+        std::thread hello([&]() { client_result = client.handshake(requested, granted); });
+
+        // the server has a sample buffer ready, as it would in its receive loop
+        ns::AudioBuffer chunk(16);
+        ASSERT_EQ(server.receiveFloat(chunk), ns::SocketReturnValue::kreceived_hello);
+        ns::StreamParams seen;
+        ASSERT_EQ(server.takeHello(seen), ns::SocketReturnValue::ksuccess);
+        EXPECT_EQ(seen.protocol_version, ns::kprotocol_version);
+        EXPECT_EQ(seen.sample_rate, 8000u);
+        EXPECT_EQ(seen.encoding, ns::SampleEncoding::kpcm16);
+        EXPECT_EQ(seen.chunk_duration_ms, 40u);
+        EXPECT_TRUE(seen.pipelined_results);
+        EXPECT_EQ(seen.max_streams, 4u);
+        EXPECT_EQ(server.takeHello(seen), ns::SocketReturnValue::kreceived_null);
+
+        ns::SessionGrant grant;
+        grant.params = seen;
+        grant.params.pipelined_results = false;
+        grant.params.max_streams = 2;
+        grant.max_frame_samples = 640;
+        grant.max_inflight_chunks = 2;
+        grant.idle_timeout_ms = 5000;
+        ASSERT_EQ(server.answerHello(grant), ns::SocketReturnValue::ksuccess);
+        hello.join();
+        ASSERT_EQ(client_result, ns::SocketReturnValue::ksuccess);
+        EXPECT_EQ(granted.params.sample_rate, 8000u);
+        EXPECT_FALSE(granted.params.pipelined_results);
+        EXPECT_EQ(granted.params.max_streams, 2u);
+        EXPECT_EQ(granted.max_frame_samples, 640u);
+        EXPECT_EQ(granted.max_inflight_chunks, 2u);
+        EXPECT_EQ(granted.idle_timeout_ms, 5000u);
+        EXPECT_EQ(client.getSampleEncoding(), ns::SampleEncoding::kpcm16);
+        EXPECT_EQ(server.getSampleEncoding(), ns::SampleEncoding::kpcm16);
+
+        const std::vector<int16_t> samples = {7, -7};
+        std::vector<int16_t> received;
+        ASSERT_EQ(client.sendPcm16(samples), ns::SocketReturnValue::ksuccess);
+        ASSERT_EQ(server.receivePcm16(received), ns::SocketReturnValue::ksuccess);
+        EXPECT_EQ(received, samples);
+    }
+
+    // a later protocol revision appends words: this side reads the ones it knows
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    ns::Base server;
+    server.setFD(fds[1]);
+    const uint32_t future_hello[] = {0xE7000000u | 7 * sizeof(uint32_t), 3, 22050, 0x41, 200, 0,
+                                     1, 0xDEADBEEFu};
+    ASSERT_EQ(::write(fds[0], future_hello, sizeof(future_hello)),
+              static_cast<ssize_t>(sizeof(future_hello)));
+    std::vector<float> none;
+    ASSERT_EQ(server.receiveFloat(none), ns::SocketReturnValue::kreceived_hello);
+    ns::StreamParams seen;
+    ASSERT_EQ(server.takeHello(seen), ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(seen.protocol_version, 3u);
+    EXPECT_EQ(seen.sample_rate, 22050u);
+    EXPECT_EQ(seen.chunk_duration_ms, 200u);
+    EXPECT_EQ(seen.max_streams, 1u);
+
+    // the stream is still in step for the next frame
+    const uint32_t legacy_frame[] = {1, 0x3F800000u};
+    ASSERT_EQ(::write(fds[0], legacy_frame, sizeof(legacy_frame)),
+              static_cast<ssize_t>(sizeof(legacy_frame)));
+    ASSERT_EQ(server.receiveFloat(none), ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(none, std::vector<float>{1.0f});
+    ::close(fds[0]);
+}
+
+/**
+ * @brief Multiplexed Streams
+ * @details Frames of several logical sessions interleave on one connection and keep their
+ *          stream ids, encodings and order; an empty frame ends one stream only, and a plain
+ *          frame is refused by the multiplexed receive.
+ */
+TEST(NetworkBackendTest, MultiplexedStreamsShareOneConnection) {
+    for (int type : {SOCK_STREAM, SOCK_SEQPACKET}) {
+        SCOPED_TRACE(type == SOCK_STREAM ? "stream" : "seqpacket");
+        int fds[2];
+        ASSERT_EQ(::socketpair(AF_UNIX, type, 0, fds), 0);
+
+        ns::Base client;
+        ns::Base server;
+        client.setFD(fds[0]);
+        server.setFD(fds[1]);
+        if (type == SOCK_SEQPACKET) {
+            client.setSocketType(ns::SocketType::kseqpacket);
+            server.setSocketType(ns::SocketType::kseqpacket);
+        }
+
+        const std::vector<float> left = {0.5f, -0.5f, 0.25f};
+        const std::vector<int16_t> right = {100, -100};
+        ASSERT_EQ(client.sendStreamFloat(1, left), ns::SocketReturnValue::ksuccess);
+        ASSERT_EQ(client.sendStreamPcm16(7, right), ns::SocketReturnValue::ksuccess);
+        ASSERT_EQ(client.sendStreamFloat(1, {}), ns::SocketReturnValue::ksuccess);
+        ASSERT_EQ(client.sendStreamFloat(7, left), ns::SocketReturnValue::ksuccess);
+
+        ns::StreamFrame frame;
+        ASSERT_EQ(server.receiveStreamFrame(frame), ns::SocketReturnValue::ksuccess);
+        EXPECT_EQ(frame.stream, 1);
+        EXPECT_EQ(frame.kind, ns::StreamFrameKind::ksamples);
+        EXPECT_EQ(frame.encoding, ns::SampleEncoding::kfloat32);
+        ASSERT_EQ(frame.count, left.size());
+        const float* floats = reinterpret_cast<const float*>(frame.payload.data());
+        EXPECT_EQ(std::vector<float>(floats, floats + frame.count), left);
+
+        ASSERT_EQ(server.receiveStreamFrame(frame), ns::SocketReturnValue::ksuccess);
+        EXPECT_EQ(frame.stream, 7);
+        EXPECT_EQ(frame.encoding, ns::SampleEncoding::kpcm16);
+        ASSERT_EQ(frame.count, right.size());
+        const int16_t* pcm = reinterpret_cast<const int16_t*>(frame.payload.data());
+        EXPECT_EQ(std::vector<int16_t>(pcm, pcm + frame.count), right);
+
+        // stream 1 ends, stream 7 carries on
+        EXPECT_EQ(server.receiveStreamFrame(frame), ns::SocketReturnValue::keof);
+        EXPECT_EQ(frame.stream, 1);
+        ASSERT_EQ(server.receiveStreamFrame(frame), ns::SocketReturnValue::ksuccess);
+        EXPECT_EQ(frame.stream, 7);
+        EXPECT_EQ(frame.count, left.size());
+
+        // results travel back tagged the same way, empty ones included
+        ASSERT_EQ(server.sendStreamString(7, "seven"), ns::SocketReturnValue::ksuccess);
+        ASSERT_EQ(server.sendStreamString(1, ""), ns::SocketReturnValue::ksuccess);
+        ASSERT_EQ(client.receiveStreamFrame(frame), ns::SocketReturnValue::ksuccess);
+        EXPECT_EQ(frame.stream, 7);
+        EXPECT_EQ(frame.kind, ns::StreamFrameKind::ktext);
+        EXPECT_EQ(std::string(frame.payload.data(), frame.count), "seven");
+        ASSERT_EQ(client.receiveStreamFrame(frame), ns::SocketReturnValue::ksuccess);
+        EXPECT_EQ(frame.stream, 1);
+        EXPECT_EQ(frame.count, 0u);
+
+        ASSERT_EQ(client.sendFloat(left), ns::SocketReturnValue::ksuccess);
+        EXPECT_EQ(server.receiveStreamFrame(frame), ns::SocketReturnValue::kreceived_illegal);
+    }
+}
+
+/**
+ * @brief Batched Frames
+ * @details A batch send arrives as separate frames; a batch receive drains only what is
+ *          queued, caps at the number of buffers handed in and stops in front of the EOF
+ *          marker, which the next call reports. Packets larger than a buffer grow it.
+ */
+TEST(NetworkBackendTest, BatchedFramesStopAtNonSampleFrames) {
+    for (int type : {SOCK_STREAM, SOCK_SEQPACKET}) {
+        SCOPED_TRACE(type == SOCK_STREAM ? "stream" : "seqpacket");
+        int fds[2];
+        ASSERT_EQ(::socketpair(AF_UNIX, type, 0, fds), 0);
+
+        ns::Base client;
+        ns::Base server;
+        client.setFD(fds[0]);
+        server.setFD(fds[1]);
+        if (type == SOCK_SEQPACKET) {
+            client.setSocketType(ns::SocketType::kseqpacket);
+            server.setSocketType(ns::SocketType::kseqpacket);
+        }
+
+        const std::vector<std::vector<float>> batch = {
+            {1.0f, 2.0f}, std::vector<float>(4000, 0.5f), {3.0f}, {}};
+        size_t sent = 0;
+        ASSERT_EQ(client.sendFloatBatch(batch, sent), ns::SocketReturnValue::ksuccess);
+        EXPECT_EQ(sent, batch.size());
+        ASSERT_EQ(client.sendFloat({4.0f, 5.0f}), ns::SocketReturnValue::ksuccess);
+
+        std::vector<ns::AudioBuffer> two(2);
+        size_t count = 0;
+        ASSERT_EQ(server.receiveFloatBatch(two, count), ns::SocketReturnValue::ksuccess);
+        ASSERT_EQ(count, 2u);
+        ASSERT_EQ(two[0].size(), 2u);
+        EXPECT_EQ(two[0].data()[1], 2.0f);
+        ASSERT_EQ(two[1].size(), 4000u);
+        EXPECT_EQ(two[1].data()[3999], 0.5f);
+
+        std::vector<ns::AudioBuffer> frames(8);
+        ASSERT_EQ(server.receiveFloatBatch(frames, count), ns::SocketReturnValue::ksuccess);
+        ASSERT_EQ(count, 1u);
+        ASSERT_EQ(frames[0].size(), 1u);
+        EXPECT_EQ(frames[0].data()[0], 3.0f);
+
+        ns::AudioBuffer single;
+        EXPECT_EQ(server.receiveFloat(single), ns::SocketReturnValue::keof);
+        ASSERT_EQ(server.receiveFloatBatch(frames, count), ns::SocketReturnValue::ksuccess);
+        ASSERT_EQ(count, 1u);
+        ASSERT_EQ(frames[0].size(), 2u);
+        EXPECT_EQ(frames[0].data()[1], 5.0f);
+    }
+}
+
+/**
+ * @brief Credit Window
+ * @details After a handshake granting two chunks in flight, a third sample frame is
+ *          refused until a result returns a credit; EOF markers need none, batches are
+ *          cut at the window, and every stream of a multiplexed connection has its own.
+ */
+TEST(NetworkBackendTest, CreditWindowBoundsChunksInFlight) {
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    ns::Base client;
+    ns::Base server;
+    client.setFD(fds[0]);
+    server.setFD(fds[1]);
+    EXPECT_EQ(client.getSendCredits(), ns::kunlimited_send_credits);
+
+    ns::StreamParams requested;
+    requested.pipelined_results = true;
+    ns::SessionGrant granted;
+    ns::SocketReturnValue client_result = ns::SocketReturnValue::kinit_state;
+    std::thread hello([&]() { client_result = client.handshake(requested, granted); });
+    ns::AudioBuffer chunk(16);
+    ASSERT_EQ(server.receiveFloat(chunk), ns::SocketReturnValue::kreceived_hello);
+    ns::SessionGrant grant;
+    ASSERT_EQ(server.takeHello(grant.params), ns::SocketReturnValue::ksuccess);
+    grant.max_inflight_chunks = 2;
+    ASSERT_EQ(server.answerHello(grant), ns::SocketReturnValue::ksuccess);
+    hello.join();
+    ASSERT_EQ(client_result, ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(granted.max_inflight_chunks, 2u);
+
+    const std::vector<float> samples = {0.25f, 0.5f};
+    EXPECT_EQ(client.getSendCredits(), 2u);
+    ASSERT_EQ(client.sendFloat(samples), ns::SocketReturnValue::ksuccess);
+    ASSERT_EQ(client.sendFloat(samples), ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(client.getSendCredits(), 0u);
+    EXPECT_EQ(client.sendFloat(samples), ns::SocketReturnValue::kno_send_credit);
+    size_t sent = 0;
+    EXPECT_EQ(client.sendFloatBatch({samples, samples}, sent),
+              ns::SocketReturnValue::kno_send_credit);
+    EXPECT_EQ(sent, 0u);
+
+    // an empty result answers a chunk as well
+    ASSERT_EQ(server.sendString(""), ns::SocketReturnValue::ksuccess);
+    std::string result;
+    EXPECT_EQ(client.receiveString(result), ns::SocketReturnValue::kempty_string);
+    EXPECT_EQ(client.getSendCredits(), 1u);
+    EXPECT_EQ(client.sendFloatBatch({samples, samples, {}}, sent),
+              ns::SocketReturnValue::kno_send_credit);
+    EXPECT_EQ(sent, 1u);
+    EXPECT_EQ(client.sendFloat(std::vector<float>()), ns::SocketReturnValue::ksuccess);
+
+    // only the frames that left reach the server: two, the batched one, then EOF
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_EQ(server.receiveFloat(chunk), ns::SocketReturnValue::ksuccess);
+        EXPECT_EQ(chunk.size(), samples.size());
+    }
+    EXPECT_EQ(server.receiveFloat(chunk), ns::SocketReturnValue::keof);
+
+    // multiplexed: the window applies per stream
+    EXPECT_EQ(client.getSendCredits(5), 2u);
+    ASSERT_EQ(client.sendStreamFloat(5, samples), ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(client.getSendCredits(5), 1u);
+    EXPECT_EQ(client.getSendCredits(6), 2u);
+    ASSERT_EQ(server.sendStreamString(5, "five"), ns::SocketReturnValue::ksuccess);
+    ns::StreamFrame frame;
+    ASSERT_EQ(client.receiveStreamFrame(frame), ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(client.getSendCredits(5), 2u);
+}
+
+/**
+ * @brief Cancellation
+ * @details cancel() from another thread wakes an untimed receive and a send stuck on a full
+ *          socket buffer while both hold their locks; later calls fail fast until the socket
+ *          is closed, after which the object serves a new connection normally.
+ */
+TEST(NetworkBackendTest, CancelWakesBlockedCalls) {
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    ns::Base client;
+    ns::Base server;
+    client.setFD(fds[0]);
+    server.setFD(fds[1]);
+
+    ns::SocketReturnValue receive_result = ns::SocketReturnValue::kinit_state;
+    ns::SocketReturnValue send_result = ns::SocketReturnValue::kinit_state;
+    std::thread receiver([&]() {
+        std::vector<float> data;
+        receive_result = client.receiveFloat(data);
+    });
+    // nobody reads the client's frames, so the send buffer fills up and the sender blocks
+    std::thread sender([&]() {
+        const std::vector<float> chunk(64 * 1024, 0.5f);
+        do {
+            send_result = client.sendFloat(chunk);
+        } while (send_result == ns::SocketReturnValue::ksuccess);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    const auto begin = std::chrono::steady_clock::now();
+    client.cancel();
+    receiver.join();
+    sender.join();
+    EXPECT_LT(std::chrono::steady_clock::now() - begin, std::chrono::milliseconds(500));
+    EXPECT_EQ(receive_result, ns::SocketReturnValue::kcancelled);
+    EXPECT_EQ(send_result, ns::SocketReturnValue::kcancelled);
+    EXPECT_TRUE(client.isCancelled());
+    EXPECT_EQ(client.sendString("late"), ns::SocketReturnValue::kcancelled);
+    EXPECT_FALSE(server.isCancelled());
+
+    // closing resets the cancellation for the next connection
+    server.closeSocket();
+    client.closeSocket();
+    EXPECT_FALSE(client.isCancelled());
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    client.setFD(fds[0]);
+    server.setFD(fds[1]);
+    std::string text;
+    ASSERT_EQ(server.sendString("again"), ns::SocketReturnValue::ksuccess);
+    ASSERT_EQ(client.receiveString(text), ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(text, "again");
+}
+
+/**
+ * @brief Streaming Receive
+ * @details A frame is handed over in contiguous slices; the first slice arrives while the
+ *          sender still holds back the rest of the frame. Packet sockets deliver the same
+ *          slices from one message, and EOF markers come back as from receiveFloat().
+ */
+TEST(NetworkBackendTest, StreamingReceiveHandsOverSlicesEarly) {
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    ns::Base receiver;
+    receiver.setFD(fds[1]);
+
+    constexpr uint32_t kframe = 48000;
+    constexpr size_t kslice = 160;
+    std::vector<float> frame(kframe);
+    for (uint32_t i = 0; i < kframe; ++i) {
+        frame[i] = static_cast<float>(i);
+    }
+    // header and first slice, the rest only once the receiver has seen that slice
+    std::atomic<bool> first_slice_seen{false};
+    std::thread writer([&]() {
+        const uint32_t header = kframe;
+        ASSERT_EQ(::write(fds[0], &header, sizeof(header)), static_cast<ssize_t>(sizeof(header)));
+        ASSERT_EQ(::write(fds[0], frame.data(), kslice * sizeof(float)),
+                  static_cast<ssize_t>(kslice * sizeof(float)));
+        const auto give_up = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (first_slice_seen == false && std::chrono::steady_clock::now() < give_up) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        const char* rest = reinterpret_cast<const char*>(frame.data() + kslice);
+        size_t left = (kframe - kslice) * sizeof(float);
+        while (left > 0) {
+            const ssize_t n = ::write(fds[0], rest, left);
+            ASSERT_GT(n, 0);
+            rest += n;
+            left -= static_cast<size_t>(n);
+        }
+        const uint32_t eof = 0;
+        ASSERT_EQ(::write(fds[0], &eof, sizeof(eof)), static_cast<ssize_t>(sizeof(eof)));
+    });
+
+    std::vector<float> assembled;
+    size_t largest_slice = 0;
+    const ns::SampleSliceHandler collect = [&](const ns::SampleSlice& slice) {
+        EXPECT_EQ(slice.offset, assembled.size());
+        EXPECT_EQ(slice.frame_count, kframe);
+        assembled.insert(assembled.end(), slice.samples, slice.samples + slice.count);
+        largest_slice = std::max(largest_slice, slice.count);
+        first_slice_seen = true;
+    };
+    uint32_t frame_count = 0;
+    ASSERT_EQ(receiver.receiveFloatStreaming(kslice, collect, frame_count,
+                                             std::chrono::steady_clock::now() +
+                                                 std::chrono::seconds(1)),
+              ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(frame_count, kframe);
+    EXPECT_EQ(largest_slice, kslice);
+    EXPECT_EQ(assembled, frame);
+    EXPECT_EQ(receiver.receiveFloatStreaming(kslice, collect, frame_count),
+              ns::SocketReturnValue::keof);
+    writer.join();
+    ::close(fds[0]);
+
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds), 0);
+    ns::Base packet_sender;
+    ns::Base packet_receiver;
+    packet_sender.setFD(fds[0]);
+    packet_receiver.setFD(fds[1]);
+    packet_sender.setSocketType(ns::SocketType::kseqpacket);
+    packet_receiver.setSocketType(ns::SocketType::kseqpacket);
+    const std::vector<float> packet(frame.begin(), frame.begin() + 1000);
+    ASSERT_EQ(packet_sender.sendFloat(packet), ns::SocketReturnValue::ksuccess);
+    assembled.clear();
+    ASSERT_EQ(packet_receiver.receiveFloatStreaming(
+                  kslice,
+                  [&](const ns::SampleSlice& slice) {
+                      EXPECT_EQ(slice.offset, assembled.size());
+                      assembled.insert(assembled.end(), slice.samples,
+                                       slice.samples + slice.count);
+                  },
+                  frame_count),
+              ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(frame_count, 1000u);
+    EXPECT_EQ(assembled, packet);
+}
+
+/**
+ * @brief Pushed Results
+ * @details push_results survives the handshake; a partial acknowledging several chunks
+ *          returns that many credits, finals and end-of-utterance finals carry their kind,
+ *          over stream and packet sockets. A plain string answer reads as a partial for one
+ *          chunk.
+ */
+TEST(NetworkBackendTest, PushedResultsReturnAcknowledgedCredits) {
+    for (const int type : {SOCK_STREAM, SOCK_SEQPACKET}) {
+        int fds[2];
+        ASSERT_EQ(::socketpair(AF_UNIX, type, 0, fds), 0);
+        ns::Base client;
+        ns::Base server;
+        client.setFD(fds[0]);
+        server.setFD(fds[1]);
+
+        ns::StreamParams requested;
+        requested.push_results = true;
+        ns::SessionGrant granted;
+        ns::SocketReturnValue client_result = ns::SocketReturnValue::kinit_state;
+        std::thread hello([&]() { client_result = client.handshake(requested, granted); });
+        ns::AudioBuffer chunk(16);
+        ASSERT_EQ(server.receiveFloat(chunk), ns::SocketReturnValue::kreceived_hello);
+        ns::SessionGrant grant;
+        ASSERT_EQ(server.takeHello(grant.params), ns::SocketReturnValue::ksuccess);
+        EXPECT_TRUE(grant.params.push_results);
+        grant.max_inflight_chunks = 3;
+        ASSERT_EQ(server.answerHello(grant), ns::SocketReturnValue::ksuccess);
+        hello.join();
+        ASSERT_EQ(client_result, ns::SocketReturnValue::ksuccess);
+        EXPECT_TRUE(granted.params.push_results);
+
+        const std::vector<float> samples = {0.25f, 0.5f};
+        for (int i = 0; i < 3; ++i) {
+            ASSERT_EQ(client.sendFloat(samples), ns::SocketReturnValue::ksuccess);
+        }
+        EXPECT_EQ(client.getSendCredits(), 0u);
+
+        ns::ResultMessage pushed;
+        pushed.kind = ns::ResultKind::kpartial;
+        pushed.acknowledged_chunks = 2;
+        pushed.text = "hello";
+        ASSERT_EQ(server.sendResult(pushed), ns::SocketReturnValue::ksuccess);
+        pushed.kind = ns::ResultKind::kfinal;
+        pushed.acknowledged_chunks = 1;
+        pushed.text = "hello world";
+        ASSERT_EQ(server.sendResult(pushed), ns::SocketReturnValue::ksuccess);
+        ASSERT_EQ(server.sendString("legacy"), ns::SocketReturnValue::ksuccess);
+        pushed.kind = ns::ResultKind::kend_of_utterance;
+        pushed.acknowledged_chunks = 0;
+        pushed.text = "hello world.";
+        ASSERT_EQ(server.sendResult(pushed), ns::SocketReturnValue::ksuccess);
+
+        ns::ResultMessage result;
+        ASSERT_EQ(client.receiveResult(result), ns::SocketReturnValue::ksuccess);
+        EXPECT_EQ(result.kind, ns::ResultKind::kpartial);
+        EXPECT_EQ(result.acknowledged_chunks, 2u);
+        EXPECT_EQ(result.text, "hello");
+        EXPECT_EQ(client.getSendCredits(), 2u);
+        ASSERT_EQ(client.receiveResult(result), ns::SocketReturnValue::ksuccess);
+        EXPECT_EQ(result.kind, ns::ResultKind::kfinal);
+        EXPECT_EQ(result.text, "hello world");
+        EXPECT_EQ(client.getSendCredits(), 3u);
+        ASSERT_EQ(client.receiveResult(result), ns::SocketReturnValue::ksuccess);
+        EXPECT_EQ(result.kind, ns::ResultKind::kpartial);
+        EXPECT_EQ(result.acknowledged_chunks, 1u);
+        EXPECT_EQ(result.text, "legacy");
+        ASSERT_EQ(client.receiveResult(result), ns::SocketReturnValue::ksuccess);
+        EXPECT_EQ(result.kind, ns::ResultKind::kend_of_utterance);
+        EXPECT_EQ(result.acknowledged_chunks, 0u);
+        EXPECT_EQ(result.text, "hello world.");
+    }
+}
+
+/**
+ * @brief Peer Credentials
+ * @details An accepted Unix-domain connection names the process that connected (this one),
+ *          a TCP connection has no such identity.
+ */
+TEST(NetworkBackendTest, PeerCredentialsIdentifyLocalClients) {
+    ns::ServerBase server;
+    server.setSocketPath(MakeTestSocketPath("peercred"));
+    ASSERT_EQ(server.startServer(), ns::SocketReturnValue::ksuccess);
+    ns::ClientBase client;
+    client.setSocketPath(MakeTestSocketPath("peercred"));
+    ASSERT_EQ(client.connectToServer(), ns::SocketReturnValue::ksuccess);
+    ns::SocketAcceptReturn accepted = server.acceptClient();
+    ASSERT_EQ(accepted.return_value, ns::SocketReturnValue::ksuccess);
+
+    ns::PeerCredentials peer;
+    ASSERT_EQ(accepted.client->getPeerCredentials(peer), ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(peer.pid, getpid());
+    EXPECT_EQ(peer.uid, getuid());
+    EXPECT_EQ(peer.gid, getgid());
+
+    ns::ServerBase tcp_server;
+    tcp_server.setTcpEndpoint("127.0.0.1", 0);
+    ASSERT_EQ(tcp_server.startServer(), ns::SocketReturnValue::ksuccess);
+    ns::ClientBase tcp_client;
+    tcp_client.setTcpEndpoint("127.0.0.1", tcp_server.getLocalPort());
+    ASSERT_EQ(tcp_client.connectToServer(), ns::SocketReturnValue::ksuccess);
+    ns::SocketAcceptReturn tcp_accepted = tcp_server.acceptClient();
+    ASSERT_EQ(tcp_accepted.return_value, ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(tcp_accepted.client->getPeerCredentials(peer),
+              ns::SocketReturnValue::kpeer_credentials_unavailable);
+}
+
+/**
+ * @brief Frame Metadata
+ * @details A session granted frame_metadata numbers its sample frames and stamps their send
+ *          time, the receiver reads both back next to the kernel ingress time; a packet
+ *          trailer that straddles the caller's buffer, a dropped frame in the wrong encoding
+ *          and the EOF marker keep the framing intact.
+ */
+TEST(NetworkBackendTest, FrameMetadataCarriesSequenceAndTimestamps) {
+    const auto now_ns = []() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    };
+    for (const int type : {SOCK_STREAM, SOCK_SEQPACKET}) {
+        int fds[2];
+        ASSERT_EQ(::socketpair(AF_UNIX, type, 0, fds), 0);
+        ns::Base client;
+        ns::Base server;
+        client.setFD(fds[0]);
+        server.setFD(fds[1]);
+        if (type == SOCK_SEQPACKET) {
+            client.setSocketType(ns::SocketType::kseqpacket);
+            server.setSocketType(ns::SocketType::kseqpacket);
+        }
+
+        ns::StreamParams requested;
+        requested.frame_metadata = true;
+        ns::SessionGrant granted;
+        ns::SocketReturnValue client_result = ns::SocketReturnValue::kinit_state;
+        std::thread hello([&]() { client_result = client.handshake(requested, granted); });
+        ns::AudioBuffer chunk(4);
+        ASSERT_EQ(server.receiveFloat(chunk), ns::SocketReturnValue::kreceived_hello);
+        ns::SessionGrant grant;
+        ASSERT_EQ(server.takeHello(grant.params), ns::SocketReturnValue::ksuccess);
+        EXPECT_TRUE(grant.params.frame_metadata);
+        grant.max_inflight_chunks = 8;
+        ASSERT_EQ(server.answerHello(grant), ns::SocketReturnValue::ksuccess);
+        hello.join();
+        ASSERT_EQ(client_result, ns::SocketReturnValue::ksuccess);
+        ASSERT_EQ(server.setReceiveTimestamps(true), ns::SocketReturnValue::ksuccess);
+
+        const int64_t before_ns = now_ns();
+        const std::vector<float> samples = {0.25f, -0.5f, 0.75f};
+        const std::vector<int16_t> pcm = {100, -100};
+        ASSERT_EQ(client.sendFloat(samples), ns::SocketReturnValue::ksuccess);
+        ASSERT_EQ(client.sendPcm16(pcm), ns::SocketReturnValue::ksuccess);
+        ASSERT_EQ(client.sendPcm16(pcm), ns::SocketReturnValue::ksuccess);
+        ASSERT_EQ(client.sendFloat(samples), ns::SocketReturnValue::ksuccess);
+        ASSERT_EQ(client.sendFloat(std::vector<float>()), ns::SocketReturnValue::ksuccess);
+
+        // 12 sample bytes in a 16-byte buffer: the packet trailer starts in place
+        ASSERT_EQ(server.receiveFloat(chunk), ns::SocketReturnValue::ksuccess);
+        const int64_t after_ns = now_ns();
+        ASSERT_EQ(chunk.size(), samples.size());
+        EXPECT_EQ(chunk.data()[2], 0.75f);
+        ns::FrameInfo info = server.getLastFrameInfo();
+        EXPECT_TRUE(info.has_metadata);
+        EXPECT_EQ(info.sequence, 0u);
+        EXPECT_GE(info.sent_ns, before_ns);
+        EXPECT_LE(info.sent_ns, after_ns);
+        if (type == SOCK_SEQPACKET) {
+            // Unix stream data carries no kernel timestamp
+            EXPECT_GT(info.kernel_rx_ns, 0);
+            EXPECT_LE(info.kernel_rx_ns, after_ns);
+        }
+
+        std::vector<int16_t> received;
+        ASSERT_EQ(server.receivePcm16(received), ns::SocketReturnValue::ksuccess);
+        ASSERT_EQ(received.size(), 2u);
+        EXPECT_EQ(received[1], -100);
+        EXPECT_EQ(server.getLastFrameInfo().sequence, 1u);
+        EXPECT_EQ(server.receiveFloat(chunk), ns::SocketReturnValue::ksample_encoding_mismatch);
+        ASSERT_EQ(server.receiveFloat(chunk), ns::SocketReturnValue::ksuccess);
+        EXPECT_EQ(chunk.data()[0], 0.25f);
+        EXPECT_EQ(server.getLastFrameInfo().sequence, 3u);
+        EXPECT_EQ(server.receiveFloat(chunk), ns::SocketReturnValue::keof);
+        EXPECT_FALSE(server.getLastFrameInfo().has_metadata);
+    }
+}
+
+/**
+ * @brief Busy Answer
+ * @details A server that cannot admit a connection answers with a retry hint instead of a
+ *          welcome: a pending handshake returns kserver_busy, and so does a client that skipped
+ *          the hello and waits for a string or result. Stream and packet sockets alike.
+ */
+TEST(NetworkBackendTest, BusyAnswerCarriesRetryHint) {
+    for (const int type : {SOCK_STREAM, SOCK_SEQPACKET}) {
+        int fds[2];
+        ASSERT_EQ(::socketpair(AF_UNIX, type, 0, fds), 0);
+        ns::Base client;
+        ns::Base server;
+        client.setFD(fds[0]);
+        server.setFD(fds[1]);
+        if (type == SOCK_SEQPACKET) {
+            client.setSocketType(ns::SocketType::kseqpacket);
+            server.setSocketType(ns::SocketType::kseqpacket);
+        }
+        EXPECT_EQ(client.getRetryAfter(), std::chrono::milliseconds(0));
+
+        ns::StreamParams requested;
+        ns::SessionGrant granted;
+        ns::SocketReturnValue client_result = ns::SocketReturnValue::kinit_state;
+        std::thread hello([&]() { client_result = client.handshake(requested, granted); });
+        ASSERT_EQ(server.sendBusy(std::chrono::milliseconds(250)),
+                  ns::SocketReturnValue::ksuccess);
+        hello.join();
+        EXPECT_EQ(client_result, ns::SocketReturnValue::kserver_busy);
+        EXPECT_EQ(client.getRetryAfter(), std::chrono::milliseconds(250));
+
+        ASSERT_EQ(server.sendBusy(std::chrono::milliseconds(40)), ns::SocketReturnValue::ksuccess);
+        ASSERT_EQ(server.sendBusy(std::chrono::milliseconds(60)), ns::SocketReturnValue::ksuccess);
+        std::string text;
+        EXPECT_EQ(client.receiveString(text), ns::SocketReturnValue::kserver_busy);
+        EXPECT_EQ(client.getRetryAfter(), std::chrono::milliseconds(40));
+        ns::ResultMessage result;
+        EXPECT_EQ(client.receiveResult(result), ns::SocketReturnValue::kserver_busy);
+        EXPECT_EQ(client.getRetryAfter(), std::chrono::milliseconds(60));
+    }
+}
+
+// -----------------------------------------------------------------------------
+// VI. Shared-memory Transport
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Shared-memory Ring
+ * @details The ring is negotiated over a socketpair, frames wrap around a deliberately
+ *          small ring while writer and reader block on each other, zero-copy peeks see
+ *          the samples in place, and EOF / close follow the socket semantics.
+ */
+TEST(NetworkShmTest, RingStreamsFramesAcrossWrapAround) {
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+    ns::Base writer_control;
+    ns::Base reader_control;
+    writer_control.setFD(fds[0]);
+    reader_control.setFD(fds[1]);
+
+    constexpr int kframe_count = 50;
+    constexpr size_t kframe_size = 300;  // 1208-byte records in a 4 KiB ring
+
+    std::thread writer([&]() {
+        std::unique_ptr<ns::ShmChannel> channel;
+        ASSERT_EQ(ns::ShmChannel::offer(writer_control, channel, 4096),
+                  ns::SocketReturnValue::ksuccess);
+        std::vector<float> frame(kframe_size);
+        for (int i = 0; i < kframe_count; ++i) {
+            std::fill(frame.begin(), frame.end(), static_cast<float>(i));
+            ASSERT_EQ(channel->sendFloat(frame), ns::SocketReturnValue::ksuccess);
+        }
+        EXPECT_EQ(channel->sendFloat({}), ns::SocketReturnValue::ksuccess);
+        channel->close();
+    });
+
+    // the offer shows up as an fd frame on the ordinary receive path
+    std::vector<float> unused;
+    ASSERT_EQ(reader_control.receiveFloat(unused), ns::SocketReturnValue::kreceived_fds);
+    std::unique_ptr<ns::ShmChannel> channel;
+    ASSERT_EQ(ns::ShmChannel::accept(reader_control, channel), ns::SocketReturnValue::ksuccess);
+
+    for (int i = 0; i < kframe_count; ++i) {
+        const float* samples = nullptr;
+        size_t count = 0;
+        ASSERT_EQ(channel->peekFloat(samples, count), ns::SocketReturnValue::ksuccess);
+        ASSERT_EQ(count, kframe_size);
+        EXPECT_EQ(samples[0], static_cast<float>(i));
+        EXPECT_EQ(samples[kframe_size - 1], static_cast<float>(i));
+        channel->releaseFloat();
+    }
+    EXPECT_EQ(channel->receiveFloat(unused), ns::SocketReturnValue::keof);
+
+    writer.join();
+    EXPECT_EQ(channel->receiveFloat(unused), ns::SocketReturnValue::kpeer_abnormally_closed);
+}
+
+/**
+ * @brief Shared-memory Readiness
+ * @details An armed reader's eventfd turns readable when a frame is written and again at
+ *          close; arming reports a frame that is already waiting instead of signalling it,
+ *          and a drained ring leaves the fd quiet.
+ */
+TEST(NetworkShmTest, ArmedReaderIsSignalled) {
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+    ns::Base writer_control;
+    ns::Base reader_control;
+    writer_control.setFD(fds[0]);
+    reader_control.setFD(fds[1]);
+
+    std::unique_ptr<ns::ShmChannel> writer;
+    std::thread offer([&]() {
+        ASSERT_EQ(ns::ShmChannel::offer(writer_control, writer, 4096),
+                  ns::SocketReturnValue::ksuccess);
+    });
+    std::vector<float> unused;
+    ASSERT_EQ(reader_control.receiveFloat(unused), ns::SocketReturnValue::kreceived_fds);
+    std::unique_ptr<ns::ShmChannel> reader;
+    ASSERT_EQ(ns::ShmChannel::accept(reader_control, reader), ns::SocketReturnValue::ksuccess);
+    offer.join();
+    ASSERT_NE(writer, nullptr);
+
+    struct pollfd readiness = {reader->getReadinessFD(), POLLIN, 0};
+    ASSERT_GE(readiness.fd, 0);
+    EXPECT_FALSE(reader->armReadiness());
+    EXPECT_EQ(::poll(&readiness, 1, 0), 0);
+
+    ASSERT_EQ(writer->sendFloat({0.5f, 0.25f}), ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(::poll(&readiness, 1, 1000), 1);
+    // the frame is there, so arming again says so rather than waiting for a signal
+    EXPECT_TRUE(reader->armReadiness());
+    const float* samples = nullptr;
+    size_t count = 0;
+    ASSERT_EQ(reader->peekFloat(samples, count), ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(count, 2u);
+    EXPECT_FALSE(reader->armReadiness());
+    reader->releaseFloat();
+    EXPECT_FALSE(reader->armReadiness());
+    EXPECT_EQ(::poll(&readiness, 1, 0), 0);
+
+    writer->close();
+    EXPECT_EQ(::poll(&readiness, 1, 1000), 1);
+    EXPECT_TRUE(reader->armReadiness());
+    EXPECT_EQ(reader->peekFloat(samples, count), ns::SocketReturnValue::kpeer_abnormally_closed);
+}
+
+// -----------------------------------------------------------------------------
+// VII. TCP Transport
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief TCP Loopback
+ * @details A server on an ephemeral loopback port accepts a remote-style client; Nagle is
+ *          off on both ends, frames and the handshake behave as on a Unix socket, and the
+ *          packet framing is refused because TCP has no message boundaries.
+ */
+TEST(NetworkTcpTest, LoopbackSessionWithNoDelay) {
+    ns::ServerBase server;
+    server.setTcpEndpoint("127.0.0.1", 0);
+    ASSERT_EQ(server.startServer(), ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(server.getTransportFamily(), ns::TransportFamily::ktcp);
+    const uint16_t port = server.getLocalPort();
+    ASSERT_NE(port, 0);
+
+    ns::ClientBase client;
+    client.setTcpEndpoint("127.0.0.1", port);
+    ASSERT_EQ(client.connectToServer(), ns::SocketReturnValue::ksuccess);
+    ns::SocketAcceptReturn accepted = server.acceptClient();
+    ASSERT_EQ(accepted.return_value, ns::SocketReturnValue::ksuccess);
+    ASSERT_NE(accepted.client, nullptr);
+    EXPECT_EQ(accepted.client->getTransportFamily(), ns::TransportFamily::ktcp);
+
+    for (int fd : {client.getFD(), accepted.client->getFD()}) {
+        int no_delay = 0;
+        socklen_t len = sizeof(no_delay);
+        ASSERT_EQ(::getsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &no_delay, &len), 0);
+        EXPECT_NE(no_delay, 0);
+    }
+
+    ns::SessionGrant granted;
+    ns::SocketReturnValue client_result = ns::SocketReturnValue::kinit_state;
+    std::thread hello([&]() { client_result = client.handshake(ns::StreamParams{}, granted); });
+    ns::AudioBuffer chunk(16);
+    ASSERT_EQ(accepted.client->receiveFloat(chunk), ns::SocketReturnValue::kreceived_hello);
+    ns::SessionGrant grant;
+    ASSERT_EQ(accepted.client->takeHello(grant.params), ns::SocketReturnValue::ksuccess);
+    ASSERT_EQ(accepted.client->answerHello(grant), ns::SocketReturnValue::ksuccess);
+    hello.join();
+    ASSERT_EQ(client_result, ns::SocketReturnValue::ksuccess);
+
+    const std::vector<float> samples = {0.5f, -0.25f, 1.0f};
+    std::vector<float> received;
+    ASSERT_EQ(client.sendFloat(samples), ns::SocketReturnValue::ksuccess);
+    ASSERT_EQ(accepted.client->receiveFloat(received), ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(received, samples);
+    ASSERT_EQ(accepted.client->sendString("over tcp"), ns::SocketReturnValue::ksuccess);
+    std::string text;
+    ASSERT_EQ(client.receiveString(text), ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(text, "over tcp");
+
+    ns::ClientBase packet_client;
+    packet_client.setTcpEndpoint("127.0.0.1", port);
+    packet_client.setSocketType(ns::SocketType::kseqpacket);
+    EXPECT_EQ(packet_client.connectToServer(), ns::SocketReturnValue::kconnect_server_failed);
+}
+
+// -----------------------------------------------------------------------------
+// VIII. Client Pool
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Warm Connection Reuse
+ * @details A pool of one keeps its handshaken connection across utterances, makes a second
+ *          request wait for it, replaces it when the server drops it while idle or during a
+ *          lease, and does not take back a lease whose result is still outstanding.
+ */
+TEST(NetworkClientPoolTest, ReusesAndReplacesConnections) {
+    ns::ServerBase server;
+    server.setSocketPath(MakeTestSocketPath("pool"));
+    ASSERT_EQ(server.startServer(), ns::SocketReturnValue::ksuccess);
+
+    // one server-side session per connection the pool opens, each answering its hello
+    std::unique_ptr<ns::Base> session;
+    auto serve_hello = [&]() {
+        ns::SocketAcceptReturn accepted = server.acceptClient();
+        ASSERT_EQ(accepted.return_value, ns::SocketReturnValue::ksuccess);
+        session = std::move(accepted.client);
+        ns::AudioBuffer chunk(16);
+        ASSERT_EQ(session->receiveFloat(chunk), ns::SocketReturnValue::kreceived_hello);
+        ns::SessionGrant grant;
+        ASSERT_EQ(session->takeHello(grant.params), ns::SocketReturnValue::ksuccess);
+        grant.max_inflight_chunks = 2;
+        ASSERT_EQ(session->answerHello(grant), ns::SocketReturnValue::ksuccess);
+    };
+
+    ns::ClientPoolConfig config;
+    config.socket_path = server.getSocketPath();
+    config.size = 1;
+    auto pool = ns::ClientPool::create(config);
+    std::thread warm(serve_hello);
+    ASSERT_EQ(pool->warmUp(), ns::SocketReturnValue::ksuccess);
+    warm.join();
+    EXPECT_EQ(pool->idleCount(), 1u);
+    EXPECT_EQ(pool->getGrant().max_inflight_chunks, 2u);
+
+    // one utterance: a chunk, its result, EOF
+    ns::PooledClient lease;
+    ASSERT_EQ(pool->acquire(lease), ns::SocketReturnValue::ksuccess);
+    const int warm_fd = lease->getFD();
+    ns::AudioBuffer chunk(16);
+    std::string result;
+    ASSERT_EQ(lease->sendFloat({0.5f}), ns::SocketReturnValue::ksuccess);
+    ASSERT_EQ(session->receiveFloat(chunk), ns::SocketReturnValue::ksuccess);
+    ASSERT_EQ(session->sendString("one"), ns::SocketReturnValue::ksuccess);
+    ASSERT_EQ(lease->receiveString(result), ns::SocketReturnValue::ksuccess);
+    ASSERT_EQ(lease->sendFloat({}), ns::SocketReturnValue::ksuccess);
+    ASSERT_EQ(session->receiveFloat(chunk), ns::SocketReturnValue::keof);
+
+    ns::PooledClient waiting;
+    EXPECT_EQ(pool->acquire(waiting, std::chrono::steady_clock::now() +
+                                         std::chrono::milliseconds(50)),
+              ns::SocketReturnValue::kio_timeout);
+    lease.reset();
+    ASSERT_EQ(pool->acquire(lease), ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(lease->getFD(), warm_fd);
+    lease.reset();
+
+    // the server drops the idle connection: acquire() hands out a fresh one
+    session.reset();
+    std::thread idle_replaced(serve_hello);
+    ASSERT_EQ(pool->acquire(lease), ns::SocketReturnValue::ksuccess);
+    idle_replaced.join();
+    ASSERT_EQ(lease->sendFloat({0.25f}), ns::SocketReturnValue::ksuccess);
+    ASSERT_EQ(session->receiveFloat(chunk), ns::SocketReturnValue::ksuccess);
+
+    // ... and during a lease: reconnect() swaps it in place
+    session.reset();
+    std::thread lease_replaced(serve_hello);
+    ASSERT_EQ(pool->reconnect(lease), ns::SocketReturnValue::ksuccess);
+    lease_replaced.join();
+    EXPECT_EQ(lease->getSendCredits(), 2u);
+    ASSERT_EQ(lease->sendFloat({0.75f}), ns::SocketReturnValue::ksuccess);
+    ASSERT_EQ(session->receiveFloat(chunk), ns::SocketReturnValue::ksuccess);
+
+    // that chunk never got its result, so the connection is not reused
+    lease.reset();
+    EXPECT_EQ(pool->idleCount(), 0u);
+    EXPECT_EQ(pool->leasedCount(), 0u);
+
+    // a stale result read ahead with the last one: the socket polls quiet, but it is not reused
+    std::thread stale_served(serve_hello);
+    ASSERT_EQ(pool->acquire(lease), ns::SocketReturnValue::ksuccess);
+    stale_served.join();
+    ASSERT_EQ(lease->sendFloat({0.5f}), ns::SocketReturnValue::ksuccess);
+    ASSERT_EQ(session->receiveFloat(chunk), ns::SocketReturnValue::ksuccess);
+    ASSERT_EQ(session->sendString("two"), ns::SocketReturnValue::ksuccess);
+    ASSERT_EQ(session->sendString("stale"), ns::SocketReturnValue::ksuccess);
+    ASSERT_EQ(lease->receiveString(result), ns::SocketReturnValue::ksuccess);
+    EXPECT_EQ(result, "two");
+    EXPECT_TRUE(lease->hasBufferedData());
+    lease.reset();
+    EXPECT_EQ(pool->idleCount(), 0u);
+
+    pool->close();
+    EXPECT_EQ(pool->acquire(lease), ns::SocketReturnValue::kpool_closed);
+}